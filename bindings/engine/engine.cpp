@@ -22,8 +22,10 @@ void bind_engine(py::module_& m) {
              py::arg("texture_filter") = GL_LINEAR)
              
         .def("is_running", &Engine::isRunning)
-        .def("update", &Engine::update)
-        .def("render", &Engine::render)
+        // Event polling, uploads and presenting run without the GIL so other Python threads keep going.
+        // The engine is still single threaded: call it only from the thread that owns the GL context.
+        .def("update", &Engine::update, py::call_guard<py::gil_scoped_release>())
+        .def("render", &Engine::render, py::call_guard<py::gil_scoped_release>())
         .def("use_context", &Engine::useContext)
         .def("set_resolution", &Engine::setResolution, py::arg("width"), py::arg("height"))
         .def("get_window", &Engine::getWindow, py::return_value_policy::reference_internal,
@@ -1,7 +1,11 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 #include <basilisk/physics/cellular/color.h>
 #include <basilisk/physics/cellular/cellBuffer.h>
+#include <basilisk/physics/cellular/chunkActivity.h>
 #include "glm/glmCasters.hpp"
+#include <algorithm>
+#include <cstring>
 
 namespace py = pybind11;
 using namespace bsk::internal;
@@ -15,6 +19,17 @@ using AddParticleColor = bool (CellBuffer::*)(const glm::vec2&, const glm::vec2&
 } // namespace
 
 void bind_cellular(py::module_& m) {
+    // CPU reference of the chunk activity pass, needs no GPU. Returns (chunk_active, intent_list, apply_list).
+    m.def("build_chunk_activity", [](const std::vector<uint32_t>& activeOut, const std::vector<uint32_t>& wake, int chunksWide, int chunksHigh) {
+        const size_t numChunks = static_cast<size_t>(std::max(chunksWide, 0)) * static_cast<size_t>(std::max(chunksHigh, 0));
+        if (activeOut.size() != numChunks || wake.size() != numChunks) {
+            throw py::value_error("build_chunk_activity: active_out and wake need chunks_wide * chunks_high entries");
+        }
+        std::vector<uint32_t> chunkActive, intentList, applyList;
+        buildChunkActivity(activeOut.data(), wake.data(), chunksWide, chunksHigh, chunkActive, intentList, applyList);
+        return py::make_tuple(chunkActive, intentList, applyList);
+    }, py::arg("active_out"), py::arg("wake"), py::arg("chunks_wide"), py::arg("chunks_high"));
+
     py::class_<Color>(m, "Color")
         .def(py::init<unsigned char, unsigned char, unsigned char, unsigned char, unsigned char>(),
              py::arg("r") = 0,
@@ -44,6 +59,13 @@ void bind_cellular(py::module_& m) {
         .def_readonly("vel", &CellParticle::vel)
         .def_readonly("color", &CellParticle::color);
 
+    py::class_<CellTouchReport>(m, "CellTouchReport")
+        .def_readonly("sand", &CellTouchReport::sand)
+        .def_readonly("particles", &CellTouchReport::particles)
+        .def("touching_sand", &CellTouchReport::touchingSand, py::arg("material_id") = -1)
+        .def("touching_particle", &CellTouchReport::touchingParticle, py::arg("material_id") = -1)
+        .def("touching", &CellTouchReport::touching, py::arg("material_id") = -1);
+
     py::class_<CellBuffer>(m, "CellBuffer")
         .def("initialize_compute", &CellBuffer::initializeCompute)
         .def("update_texture", &CellBuffer::updateTexture)
@@ -114,6 +136,28 @@ void bind_cellular(py::module_& m) {
         py::arg("is_static") = false,
         py::arg("flip_y_to_buffer_space") = true,
         py::arg("alpha_threshold") = 1u)
+        .def("fill_rect", &CellBuffer::fillRect, py::arg("x"), py::arg("y"), py::arg("width"), py::arg("height"), py::arg("color"))
+        .def("stamp_mask", [](CellBuffer& self, int x, int y, int width, int height, py::bytes mask_bytes, const Color& color) {
+            std::string raw = mask_bytes;
+            if (width <= 0 || height <= 0 || raw.size() < static_cast<size_t>(width) * static_cast<size_t>(height)) {
+                return false;
+            }
+            self.stampMask(x, y, width, height, reinterpret_cast<const uint8_t*>(raw.data()), color);
+            return true;
+        }, py::arg("x"), py::arg("y"), py::arg("width"), py::arg("height"), py::arg("mask_bytes"), py::arg("color"))
+        .def("write_packed_region", [](CellBuffer& self, int x, int y, int width, int height, py::bytes packed_bytes) {
+            std::string raw = packed_bytes;
+            const size_t count = static_cast<size_t>(std::max(width, 0)) * static_cast<size_t>(std::max(height, 0));
+            if (count == 0 || raw.size() < count * sizeof(uint32_t)) {
+                return false;
+            }
+            std::vector<uint32_t> packed(count);
+            std::memcpy(packed.data(), raw.data(), count * sizeof(uint32_t));
+            self.writePackedRegion(x, y, width, height, packed.data());
+            return true;
+        }, py::arg("x"), py::arg("y"), py::arg("width"), py::arg("height"), py::arg("packed_bytes"))
+        .def("save_cells", &CellBuffer::saveCells, py::arg("path"))
+        .def("load_cells", &CellBuffer::loadCells, py::arg("path"))
         .def("add_particle", static_cast<AddParticleColor>(&CellBuffer::addParticle),
             py::arg("pos"), py::arg("vel"), py::arg("color"), py::arg("forced_lifetime") = 0.0f, py::arg("explode_radius") = 0u, py::arg("explode_fire_chance") = 0.0f)
         .def("add_particle", [](CellBuffer& self, const glm::vec2& pos, const glm::vec2& vel, unsigned char r, unsigned char g, unsigned char b, int mat_id, bool on_fire, bool is_static, float forced_lifetime, uint32_t explode_radius, float explode_fire_chance) {
@@ -126,5 +170,18 @@ void bind_cellular(py::module_& m) {
         .def("get_cell_scale", &CellBuffer::getCellScale)
         .def("set_cell_scale", &CellBuffer::setCellScale, py::arg("value"))
         .def("set_cell_updates_per_second", &CellBuffer::setCellUpdatesPerSecond, py::arg("value"))
+        .def("set_seed", &CellBuffer::setSeed, py::arg("seed"))
+        .def("set_gpu_chunk_activity", &CellBuffer::setGpuChunkActivity, py::arg("enabled"))
+        .def("get_gpu_chunk_activity", &CellBuffer::getGpuChunkActivity)
+        .def("get_cpu_chunk_activity", [](const CellBuffer& self) {
+            std::vector<uint32_t> active, intentList, applyList;
+            self.getCpuChunkActivity(active, intentList, applyList);
+            return py::make_tuple(active, intentList, applyList);
+        })
+        .def("read_gpu_chunk_activity", [](const CellBuffer& self) {
+            std::vector<uint32_t> active, intentList, applyList;
+            self.readGpuChunkActivity(active, intentList, applyList);
+            return py::make_tuple(active, intentList, applyList);
+        })
         .def("get_render_texture", &CellBuffer::getRenderTexture);
 }
@@ -1,7 +1,11 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 
 #include <basilisk/physics/solver.h>
 #include <basilisk/physics/rigid.h>
+#include <basilisk/physics/tables/bodyTable.h>
+#include <basilisk/nodes/node2d.h>
 #include <basilisk/physics/forces/force.h>
 #include <basilisk/physics/cellular/cellBuffer.h>
 
@@ -11,9 +15,92 @@
 namespace py = pybind11;
 using namespace bsk::internal;
 
+using FloatArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+using RowArray = py::array_t<int64_t, py::array::c_style | py::array::forcecast>;
+
+// The live rows of a vec3 column as (rows, 3) float32. Copied unless a view is asked for, which strides over the
+// padded vec3s in place. The solver is a view's base so it outlives the view, the column itself does not.
+static py::array exportVec3Column(py::object owner, std::vector<bsk::vec3>& column, uint32_t rows, bool copy) {
+    if (!copy) {
+        return py::array_t<float>(
+            { (py::ssize_t)rows, (py::ssize_t)3 },
+            { (py::ssize_t)sizeof(bsk::vec3), (py::ssize_t)sizeof(float) },
+            &column.data()->x, owner);
+    }
+
+    py::array_t<float> out({ (py::ssize_t)rows, (py::ssize_t)3 });
+    float* data = out.mutable_data();
+    for (uint32_t i = 0; i < rows; i++) {
+        data[i * 3] = column[i].x;
+        data[i * 3 + 1] = column[i].y;
+        data[i * 3 + 2] = column[i].z;
+    }
+    return out;
+}
+
+// The live rows of a float column, copied unless a view is asked for
+static py::array exportFloatColumn(py::object owner, std::vector<float>& column, uint32_t rows, bool copy) {
+    if (!copy) {
+        return py::array_t<float>({ (py::ssize_t)rows }, { (py::ssize_t)sizeof(float) }, column.data(), owner);
+    }
+    return py::array_t<float>((py::ssize_t)rows, column.data());
+}
+
+// Target rows of a bulk write: all live rows in order, or the given rows checked against the table
+static std::vector<uint32_t> resolveRows(BodyTable* table, const std::optional<RowArray>& rows, py::ssize_t count) {
+    std::vector<uint32_t> out(count);
+    if (!rows) {
+        if (count != (py::ssize_t)table->getSize()) {
+            throw py::value_error("expected one value per body, pass rows to write a subset");
+        }
+        std::iota(out.begin(), out.end(), 0u);
+        return out;
+    }
+
+    if (rows->ndim() != 1 || rows->shape(0) != count) {
+        throw py::value_error("rows must be a 1D array with one row per value");
+    }
+    const int64_t* data = rows->data();
+    for (py::ssize_t i = 0; i < count; i++) {
+        if (data[i] < 0 || data[i] >= (int64_t)table->getSize()) {
+            throw py::index_error("body row out of range");
+        }
+        out[i] = (uint32_t)data[i];
+    }
+    return out;
+}
+
+// Scatter (n, 3) values into a vec3 column, returns the rows written
+static std::vector<uint32_t> writeVec3Column(BodyTable* table, std::vector<bsk::vec3>& column, const FloatArray& values, const std::optional<RowArray>& rows) {
+    if (values.ndim() != 2 || values.shape(1) != 3) {
+        throw py::value_error("values must have shape (n, 3)");
+    }
+    std::vector<uint32_t> targets = resolveRows(table, rows, values.shape(0));
+    const float* data = values.data();
+    for (size_t i = 0; i < targets.size(); i++) {
+        column[targets[i]] = bsk::vec3(data[i * 3], data[i * 3 + 1], data[i * 3 + 2]);
+    }
+    return targets;
+}
+
+// Scatter (n,) values into a float column
+static void writeFloatColumn(BodyTable* table, std::vector<float>& column, const FloatArray& values, const std::optional<RowArray>& rows) {
+    if (values.ndim() != 1) {
+        throw py::value_error("values must have shape (n,)");
+    }
+    std::vector<uint32_t> targets = resolveRows(table, rows, values.shape(0));
+    const float* data = values.data();
+    for (size_t i = 0; i < targets.size(); i++) {
+        column[targets[i]] = data[i];
+    }
+}
+
 void bind_solver(py::module_& m) {
     py::class_<Solver>(m, "Solver")
         .def(py::init<>())
+
+        // Runs without the GIL. Scene2D.update already steps its solver, only step solvers no scene drives.
+        .def("step", &Solver::step, py::arg("dt"), py::call_guard<py::gil_scoped_release>())
         
         // Linked list management - Rigid overloads
         .def("insert", py::overload_cast<Rigid*>(&Solver::insert))
@@ -47,5 +134,102 @@ void bind_solver(py::module_& m) {
         .def("is_touching", &Solver::isTouching, py::arg("rigid"), py::arg("material_id") = -1)
         .def("is_touching_sand", &Solver::isTouchingSand, py::arg("rigid"), py::arg("material_id") = -1)
         .def("is_touching_particle", &Solver::isTouchingParticle, py::arg("rigid"), py::arg("material_id") = -1)
-        .def("get_touched_particles", &Solver::getTouchedParticles, py::arg("rigid"), py::arg("material_id") = -1);
+        .def("get_touched_particles", &Solver::getTouchedParticles, py::arg("rigid"), py::arg("material_id") = -1)
+        .def("query_touches", &Solver::queryTouches, py::arg("rigids"))
+
+        // Bulk body state. Reads return copies by default. copy=False returns a writable view into the body table,
+        // only valid until body_layout_version changes (bodies added, removed on the next step, or the table grown)
+        // and only while no step is in flight. Rows follow insertion order between compactions, body ids never change.
+        .def_property_readonly("body_layout_version", [](Solver& s) { s.finishStep(); return s.getBodyTable()->getLayoutVersion(); })
+        .def("get_body_rows", [](Solver& s, const std::vector<Node2D*>& nodes) {
+            s.finishStep();
+            RowArray rows((py::ssize_t)nodes.size());
+            int64_t* data = rows.mutable_data();
+            for (size_t i = 0; i < nodes.size(); i++) {
+                Rigid* rigid = nodes[i] ? nodes[i]->getRigid() : nullptr;
+                data[i] = rigid ? (int64_t)rigid->getIndex() : -1;
+            }
+            return rows;
+        }, py::arg("nodes"), "Current body table row of each node, -1 for nodes without a rigid body.")
+        .def("get_body_ids", [](Solver& s, const std::vector<Node2D*>& nodes) {
+            s.finishStep();
+            BodyTable* table = s.getBodyTable();
+            RowArray ids((py::ssize_t)nodes.size());
+            int64_t* data = ids.mutable_data();
+            for (size_t i = 0; i < nodes.size(); i++) {
+                Rigid* rigid = nodes[i] ? nodes[i]->getRigid() : nullptr;
+                data[i] = rigid ? (int64_t)table->getId(rigid->getIndex()) : -1;
+            }
+            return ids;
+        }, py::arg("nodes"), "Stable body id of each node, -1 for nodes without a rigid body.")
+        .def("body_ids", [](Solver& s) {
+            s.finishStep();
+            BodyTable* table = s.getBodyTable();
+            RowArray ids((py::ssize_t)table->getSize());
+            int64_t* data = ids.mutable_data();
+            for (uint32_t i = 0; i < table->getSize(); i++) {
+                data[i] = (int64_t)table->getId(i);
+            }
+            return ids;
+        }, "Stable body id of every row, in row order.")
+        .def("body_rows", [](Solver& s, const RowArray& ids) {
+            s.finishStep();
+            BodyTable* table = s.getBodyTable();
+            RowArray rows(ids.size());
+            const int64_t* in = ids.data();
+            int64_t* out = rows.mutable_data();
+            for (py::ssize_t i = 0; i < ids.size(); i++) {
+                uint32_t row = (in[i] >= 0 && in[i] < (int64_t)BodyTable::NO_ROW) ? table->getRow((uint32_t)in[i]) : BodyTable::NO_ROW;
+                out[i] = row == BodyTable::NO_ROW ? -1 : (int64_t)row;
+            }
+            return rows;
+        }, py::arg("ids"), "Current row of each body id, -1 for bodies that were removed.")
+        .def("body_positions", [](py::object self, bool copy) {
+            Solver& s = self.cast<Solver&>();
+            s.finishStep();
+            BodyTable* table = s.getBodyTable();
+            return exportVec3Column(self, table->getPosColumn(), table->getSize(), copy);
+        }, py::arg("copy") = true, "(n, 3) float32 body positions (x, y, rotation).")
+        .def("body_velocities", [](py::object self, bool copy) {
+            Solver& s = self.cast<Solver&>();
+            s.finishStep();
+            BodyTable* table = s.getBodyTable();
+            return exportVec3Column(self, table->getVelColumn(), table->getSize(), copy);
+        }, py::arg("copy") = true, "(n, 3) float32 body velocities (x, y, angular).")
+        .def("body_masses", [](py::object self, bool copy) {
+            Solver& s = self.cast<Solver&>();
+            s.finishStep();
+            BodyTable* table = s.getBodyTable();
+            return exportFloatColumn(self, table->getMassColumn(), table->getSize(), copy);
+        }, py::arg("copy") = true, "(n,) float32 body masses.")
+        .def("body_frictions", [](py::object self, bool copy) {
+            Solver& s = self.cast<Solver&>();
+            s.finishStep();
+            BodyTable* table = s.getBodyTable();
+            return exportFloatColumn(self, table->getFrictionColumn(), table->getSize(), copy);
+        }, py::arg("copy") = true, "(n,) float32 body friction coefficients.")
+        .def("set_body_positions", [](Solver& s, const FloatArray& values, std::optional<RowArray> rows) {
+            s.finishStep();
+            BodyTable* table = s.getBodyTable();
+            std::vector<uint32_t> targets = writeVec3Column(table, table->getPosColumn(), values, rows);
+            for (uint32_t row : targets) {
+                table->setInitial(row, table->getPos(row)); // a teleport, not motion to interpolate across
+            }
+            table->writeToNodes(targets.data(), (uint32_t)targets.size());
+        }, py::arg("values"), py::arg("rows") = py::none(), "Write (n, 3) positions to every body or to the given rows, and move their nodes.")
+        .def("set_body_velocities", [](Solver& s, const FloatArray& values, std::optional<RowArray> rows) {
+            s.finishStep();
+            BodyTable* table = s.getBodyTable();
+            writeVec3Column(table, table->getVelColumn(), values, rows);
+        }, py::arg("values"), py::arg("rows") = py::none(), "Write (n, 3) velocities to every body or to the given rows.")
+        .def("set_body_masses", [](Solver& s, const FloatArray& values, std::optional<RowArray> rows) {
+            s.finishStep();
+            BodyTable* table = s.getBodyTable();
+            writeFloatColumn(table, table->getMassColumn(), values, rows);
+        }, py::arg("values"), py::arg("rows") = py::none(), "Write (n,) masses to every body or to the given rows.")
+        .def("set_body_frictions", [](Solver& s, const FloatArray& values, std::optional<RowArray> rows) {
+            s.finishStep();
+            BodyTable* table = s.getBodyTable();
+            writeFloatColumn(table, table->getFrictionColumn(), values, rows);
+        }, py::arg("values"), py::arg("rows") = py::none(), "Write (n,) friction coefficients to every body or to the given rows.");
 }
\ No newline at end of file
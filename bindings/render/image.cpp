@@ -2,6 +2,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <basilisk/render/image.h>
+#include <basilisk/resource/resourceCache.h>
 #include <cmath>
 #include <cstdlib>
 #include <stdexcept>
@@ -11,9 +12,16 @@ using namespace bsk::internal;
 
 void bind_image(py::module_& m) {
     py::class_<Image, std::shared_ptr<Image>>(m, "Image")
-        .def(py::init<std::string>(), py::arg("file"))
-        .def(py::init<const std::vector<float>&, int, int, int>(), py::arg("data"), py::arg("width"), py::arg("height"), py::arg("nChannels") = 4)
+        // Constructors go through the resource cache, so equal images share one object and one texture layer
+        .def(py::init([](const std::string& file, bool flipVertically, bool asynchronous) {
+            return ResourceCache::getGlobal().getImage(file, flipVertically, asynchronous);
+        }), py::arg("file"), py::arg("flip_vertically") = true, py::arg("asynchronous") = false)
+        .def(py::init([](const std::vector<float>& data, int width, int height, int nChannels) {
+            return ResourceCache::getGlobal().getImage(data, width, height, nChannels);
+        }), py::arg("data"), py::arg("width"), py::arg("height"), py::arg("nChannels") = 4)
         .def("get_width", &Image::getWidth)
         .def("get_height", &Image::getHeight)
-        .def("get_data", &Image::getData);
+        .def("get_data", &Image::getData)
+        .def("is_loaded", &Image::isLoaded)
+        .def("wait", &Image::wait, py::call_guard<py::gil_scoped_release>());
 }
\ No newline at end of file
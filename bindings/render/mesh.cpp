@@ -2,18 +2,22 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <basilisk/render/mesh.h>
+#include <basilisk/resource/resourceCache.h>
 
 namespace py = pybind11;
 
 void bind_mesh(py::module_& m) {
     using Mesh = bsk::internal::Mesh;
     py::class_<Mesh, std::shared_ptr<Mesh>>(m, "Mesh")
-        .def(py::init<const std::string&, bool, bool>(), py::arg("modelPath"), py::arg("generateUV") = false, py::arg("generateNormals") = false)
+        // Constructors go through the resource cache, so equal meshes share one object and one set of GPU buffers
+        .def(py::init([](const std::string& modelPath, bool generateUV, bool generateNormals) {
+            return bsk::internal::ResourceCache::getGlobal().getMesh(modelPath, generateUV, generateNormals);
+        }), py::arg("modelPath"), py::arg("generateUV") = false, py::arg("generateNormals") = false)
         .def(py::init([](const std::vector<float>& vertices) {
-            return std::make_shared<Mesh>(vertices);
+            return bsk::internal::ResourceCache::getGlobal().getMesh(vertices);
         }), py::arg("vertices"))
         .def(py::init([](const std::vector<float>& vertices, const std::vector<unsigned int>& indices) {
-            return std::make_shared<Mesh>(vertices, indices);
+            return bsk::internal::ResourceCache::getGlobal().getMesh(vertices, indices);
         }), py::arg("vertices"), py::arg("indices"))
         .def("get_vertices", &Mesh::getVertices)
         .def("get_indices", &Mesh::getIndices);
@@ -1,5 +1,6 @@
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 #include <basilisk/scene/scene.h>
 #include <basilisk/light/light.h>
 #include <basilisk/nodes/node.h>
@@ -18,6 +19,21 @@ struct RayCastResultPy {
     float distance;
 };
 
+static RayCastResultPy toPython(Scene& s, const RayCastResult& r) {
+    RayCastResultPy out;
+    out.intersection = r.intersection;
+    out.normal = r.normal;
+    out.distance = r.distance;
+    if (r.node) {
+        out.node = s.findSharedNode(r.node);
+        if (!out.node) {
+            throw py::value_error("Raycast hit a node that was not added via shared_ptr (add(node)); "
+                                 "nodes must be added with scene.add(node) for raycast to return them.");
+        }
+    }
+    return out;
+}
+
 void bind_scene(py::module_& m) {
     py::class_<Scene, std::shared_ptr<Scene>>(m, "Scene")
         .def(py::init<Engine*, bool, bool, bool>(),
@@ -32,8 +48,10 @@ void bind_scene(py::module_& m) {
              py::arg("addLight") = true,
              py::arg("addCube") = false)
         
-        .def("update", &Scene::update)
-        .def("render", &Scene::render)
+        // Long calls run without the GIL so other Python threads keep going during the frame. The scene locks its
+        // node tree itself; nodes must still only be modified from the thread driving the frame loop.
+        .def("update", &Scene::update, py::call_guard<py::gil_scoped_release>())
+        .def("render", &Scene::render, py::call_guard<py::gil_scoped_release>())
 
         // Camera: only bind shared_ptr setter so the scene keeps the camera alive (avoids segfault when camera is GC'd)
         .def("set_camera",
@@ -52,13 +70,15 @@ void bind_scene(py::module_& m) {
             "add",
             static_cast<void (Scene::*)(std::shared_ptr<Light>)>(
                 &Scene::add),
-            py::arg("light")
+            py::arg("light"),
+            py::call_guard<py::gil_scoped_release>()
         )
         .def(
             "add",
             static_cast<void (Scene::*)(std::shared_ptr<Node>)>(
                 &Scene::add),
-            py::arg("node")
+            py::arg("node"),
+            py::call_guard<py::gil_scoped_release>()
         )
 
         // ---- remove overload ----
@@ -66,7 +86,8 @@ void bind_scene(py::module_& m) {
             "remove",
             static_cast<void (Scene::*)(Node*)>(
                 &Scene::remove),
-            py::arg("node")
+            py::arg("node"),
+            py::call_guard<py::gil_scoped_release>()
         )
 
         // Mouse interaction - returns result with shared_ptr node (raises if hit node has no shared_ptr)
@@ -84,24 +105,25 @@ void bind_scene(py::module_& m) {
                 }
             }
             return out;
-        }, py::arg("mouse_position"),
+        }, py::arg("mouse_position"), py::call_guard<py::gil_scoped_release>(),
            "Cast a ray from the mouse position; returns RayCastResult with shared_ptr node. Raises if hit node lacks shared_ptr.")
         .def("raycast", [](Scene& s, const glm::vec3& origin, const glm::vec3& direction) {
-            RayCastResult r = s.raycast(origin, direction);
-            RayCastResultPy out;
-            out.intersection = r.intersection;
-            out.normal = r.normal;
-            out.distance = r.distance;
-            if (r.node) {
-                out.node = s.findSharedNode(r.node);
-                if (!out.node) {
-                    throw py::value_error("Raycast hit a node that was not added via shared_ptr (add(node)); "
-                                         "nodes must be added with scene.add(node) for raycast to return them.");
-                }
+            return toPython(s, s.raycast(origin, direction));
+        }, py::arg("origin"), py::arg("direction"), py::call_guard<py::gil_scoped_release>(),
+           "Cast a ray in world space; returns RayCastResult with shared_ptr node. Raises if hit node lacks shared_ptr.")
+        .def("raycast_batch", [](Scene& s, const std::vector<glm::vec3>& origins, const std::vector<glm::vec3>& directions) {
+            if (origins.size() != directions.size()) {
+                throw py::value_error("raycast_batch needs one direction per origin");
+            }
+            std::vector<RayCastResult> results = s.raycast(origins, directions);
+            std::vector<RayCastResultPy> out;
+            out.reserve(results.size());
+            for (const RayCastResult& r : results) {
+                out.push_back(toPython(s, r));
             }
             return out;
-        }, py::arg("origin"), py::arg("direction"),
-           "Cast a ray in world space; returns RayCastResult with shared_ptr node. Raises if hit node lacks shared_ptr.");
+        }, py::arg("origins"), py::arg("directions"), py::call_guard<py::gil_scoped_release>(),
+           "Cast many world space rays at once; returns a list of RayCastResult in the same order.");
 
     py::class_<RayCastResultPy>(m, "RayCastResult")
         .def_readonly("node", &RayCastResultPy::node,
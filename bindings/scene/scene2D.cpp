@@ -1,15 +1,33 @@
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 #include <basilisk/scene/scene2d.h>
 #include <basilisk/engine/engine.h>
 #include <basilisk/nodes/node2d.h>
 #include <basilisk/camera/staticCamera2d.h>
 #include <basilisk/scene/raycast.h>
+#include <basilisk/physics/tables/bodyTable.h>
 #include "glm/glmCasters.hpp"
 
 namespace py = pybind11;
 using namespace bsk::internal;
 
+using FloatArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+using RowArray = py::array_t<int64_t, py::array::c_style | py::array::forcecast>;
+
+// Pointer to the data of an optional (count, width) or (count,) float array, nullptr when not given
+static const float* batchColumn(const std::optional<FloatArray>& values, py::ssize_t count, py::ssize_t width, const char* name) {
+    if (!values) return nullptr;
+    bool shaped = width == 1
+        ? (values->ndim() == 1 && values->shape(0) == count)
+        : (values->ndim() == 2 && values->shape(0) == count && values->shape(1) == width);
+    if (!shaped) {
+        throw py::value_error(std::string("spawn_batch: ") + name + " must have one entry per position");
+    }
+    return values->data();
+}
+
 // Python-facing 2D raycast result: node is shared_ptr when available
 struct RayCastResult2DPy {
     std::shared_ptr<Node2D> node;
@@ -18,6 +36,21 @@ struct RayCastResult2DPy {
     float distance;
 };
 
+static RayCastResult2DPy toPython(Scene2D& s, const RayCastResult2D& r) {
+    RayCastResult2DPy out;
+    out.intersection = r.intersection;
+    out.normal = r.normal;
+    out.distance = r.distance;
+    if (r.node) {
+        out.node = s.findSharedNode(r.node);
+        if (!out.node) {
+            throw py::value_error("Raycast hit a node that was not added via shared_ptr (add(node)); "
+                                 "nodes must be added with scene.add(node) for raycast to return them.");
+        }
+    }
+    return out;
+}
+
 void bind_scene2d(py::module_& m) {
     py::class_<RayCastResult2DPy>(m, "RayCastResult2D")
         .def_readonly("node", &RayCastResult2DPy::node,
@@ -38,10 +71,77 @@ void bind_scene2d(py::module_& m) {
              py::arg("cell_width") = 800,
              py::arg("cell_height") = 800,
              py::arg("cell_scale") = 0.2f)
-        .def("update", &Scene2D::update)
-        .def("render", &Scene2D::render)
-        .def("add", static_cast<void (Scene2D::*)(std::shared_ptr<Node2D>)>(&Scene2D::add), py::arg("node"))
-        .def("remove", static_cast<void (Scene2D::*)(Node2D*)>(&Scene2D::remove), py::arg("node"))
+        // Long calls run without the GIL so other Python threads keep going during the frame. The scene locks its
+        // node tree itself; nodes must still only be modified from the thread driving the frame loop.
+        .def("update", &Scene2D::update, py::call_guard<py::gil_scoped_release>())
+        .def("render", &Scene2D::render, py::call_guard<py::gil_scoped_release>())
+        // Pipelined scenes step physics on the solver's thread while the frame renders. Anything that touches bodies,
+        // forces or the solver waits for that step first; node poses lag the solver by one step until sync().
+        .def_property("pipelined", &Scene2D::isPipelined, &Scene2D::setPipelined)
+        .def("sync", &Scene2D::sync, py::call_guard<py::gil_scoped_release>(),
+             "Wait for the background physics step and publish its poses to the nodes.")
+        // Fixed timestep. Nodes are drawn interpolated between the last two physics states, so with a rate set the
+        // node pose can trail the body by up to one step; read Solver.body_positions() for the solved pose.
+        .def_property("physics_rate", &Scene2D::getPhysicsRate, &Scene2D::setPhysicsRate,
+                      "Physics steps per second, 0 to step once per frame.")
+        .def_property("max_substeps", &Scene2D::getMaxSubsteps, &Scene2D::setMaxSubsteps,
+                      "Most fixed steps run in one update, time beyond that is dropped.")
+        .def("add", static_cast<void (Scene2D::*)(std::shared_ptr<Node2D>)>(&Scene2D::add), py::arg("node"), py::call_guard<py::gil_scoped_release>())
+        .def("remove", static_cast<void (Scene2D::*)(Node2D*)>(&Scene2D::remove), py::arg("node"), py::call_guard<py::gil_scoped_release>())
+
+        // Bulk spawning. Handles are stable body ids, the same ones Solver.get_body_ids returns. Solver.body_rows
+        // turns them into rows of Solver.body_positions() and friends for the current body_layout_version.
+        .def("spawn_batch", [](Scene2D& s, const FloatArray& positions, std::optional<FloatArray> rotations, std::optional<FloatArray> scales,
+                               std::optional<FloatArray> velocities, Collider* collider, float density, float friction,
+                               std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material) {
+            if (positions.ndim() != 2 || positions.shape(1) != 2) {
+                throw py::value_error("spawn_batch: positions must have shape (n, 2)");
+            }
+            py::ssize_t count = positions.shape(0);
+            const float* rotationData = batchColumn(rotations, count, 1, "rotations");
+            const float* scaleData = batchColumn(scales, count, 2, "scales");
+            const float* velocityData = batchColumn(velocities, count, 3, "velocities");
+
+            std::vector<Node2D*> nodes;
+            {
+                py::gil_scoped_release release;
+                nodes = s.spawnBatch((uint32_t)count, (const glm::vec2*)positions.data(), rotationData, (const glm::vec2*)scaleData,
+                                     (const glm::vec3*)velocityData, collider, density, friction, std::move(mesh), std::move(material));
+            }
+
+            BodyTable* table = s.getSolver()->getBodyTable();
+            RowArray ids(count);
+            int64_t* data = ids.mutable_data();
+            for (py::ssize_t i = 0; i < count; i++) {
+                Rigid* rigid = nodes[i]->getRigid();
+                data[i] = rigid ? (int64_t)table->getId(rigid->getIndex()) : -1;
+            }
+            return ids;
+        },
+        py::arg("positions"),
+        py::arg("rotations") = py::none(),
+        py::arg("scales") = py::none(),
+        py::arg("velocities") = py::none(),
+        py::arg("collider") = nullptr,
+        py::arg("density") = 1.0f,
+        py::arg("friction") = 0.5f,
+        py::arg("mesh") = nullptr,
+        py::arg("material") = nullptr,
+        "Spawn one node per row of positions (n, 2), with optional rotations (n,), scales (n, 2) and velocities (n, 3). "
+        "Returns the body id of each node, -1 where there is no collider.")
+        .def("get_nodes", [](Scene2D& s, const RowArray& ids) {
+            s.sync();
+            BodyTable* table = s.getSolver()->getBodyTable();
+            const int64_t* data = ids.data();
+            std::vector<std::shared_ptr<Node2D>> nodes;
+            nodes.reserve(ids.size());
+            for (py::ssize_t i = 0; i < ids.size(); i++) {
+                uint32_t row = (data[i] >= 0 && data[i] < (int64_t)BodyTable::NO_ROW) ? table->getRow((uint32_t)data[i]) : BodyTable::NO_ROW;
+                Rigid* rigid = row != BodyTable::NO_ROW ? table->getBodies(row) : nullptr;
+                nodes.push_back(rigid ? s.findSharedNode(rigid->getNode()) : nullptr);
+            }
+            return nodes;
+        }, py::arg("ids"), "Node2D of each body id, None for bodies that were removed.")
         // Camera: only bind shared_ptr setter so the scene keeps the camera alive (avoids segfault when camera is GC'd)
         .def("set_camera",
              static_cast<void (Scene2D::*)(std::shared_ptr<StaticCamera2D>)>(&Scene2D::setCamera),
@@ -66,22 +166,23 @@ void bind_scene2d(py::module_& m) {
                                      "nodes must be added with scene.add(node) for pick to return them.");
             }
             return sp;
-        }, py::arg("position"),
+        }, py::arg("position"), py::call_guard<py::gil_scoped_release>(),
            "Return the topmost node at the given world position (by layer). Returns None if no hit. Raises if hit node lacks shared_ptr.")
         .def("raycast", [](Scene2D& s, const glm::vec2& origin, const glm::vec2& direction) {
-            RayCastResult2D r = s.raycast(origin, direction);
-            RayCastResult2DPy out;
-            out.intersection = r.intersection;
-            out.normal = r.normal;
-            out.distance = r.distance;
-            if (r.node) {
-                out.node = s.findSharedNode(r.node);
-                if (!out.node) {
-                    throw py::value_error("Raycast hit a node that was not added via shared_ptr (add(node)); "
-                                         "nodes must be added with scene.add(node) for raycast to return them.");
-                }
+            return toPython(s, s.raycast(origin, direction));
+        }, py::arg("origin"), py::arg("direction"), py::call_guard<py::gil_scoped_release>(),
+           "Cast a ray in world space; returns RayCastResult2D with shared_ptr node. Raises if hit node lacks shared_ptr.")
+        .def("raycast_batch", [](Scene2D& s, const std::vector<glm::vec2>& origins, const std::vector<glm::vec2>& directions) {
+            if (origins.size() != directions.size()) {
+                throw py::value_error("raycast_batch needs one direction per origin");
+            }
+            std::vector<RayCastResult2D> results = s.raycast(origins, directions);
+            std::vector<RayCastResult2DPy> out;
+            out.reserve(results.size());
+            for (const RayCastResult2D& r : results) {
+                out.push_back(toPython(s, r));
             }
             return out;
-        }, py::arg("origin"), py::arg("direction"),
-           "Cast a ray in world space; returns RayCastResult2D with shared_ptr node. Raises if hit node lacks shared_ptr.");
+        }, py::arg("origins"), py::arg("directions"), py::call_guard<py::gil_scoped_release>(),
+           "Cast many world space rays at once; returns a list of RayCastResult2D in the same order.");
 }
\ No newline at end of file
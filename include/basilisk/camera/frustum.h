@@ -0,0 +1,24 @@
+#ifndef BSK_FRUSTUM_H
+#define BSK_FRUSTUM_H
+
+#include <basilisk/util/includes.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief The six clip planes of a view projection matrix, used to cull world space bounds
+ * 
+ */
+class Frustum {
+    private:
+        std::array<glm::vec4, 6> planes; // xyz inward normal, w distance
+
+    public:
+        Frustum(const glm::mat4& viewProjection);
+
+        bool intersects(const glm::vec3& min, const glm::vec3& max) const;
+};
+
+}
+
+#endif
@@ -36,6 +36,7 @@ class StaticCamera : public VirtualCamera {
 
         void update();
         void use(Shader* shader);
+        CameraBlock getCameraBlock() override;
 
         glm::vec3 getPosition() { return position; }
         float getX() { return position.x; }
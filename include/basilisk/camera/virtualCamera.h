@@ -3,6 +3,7 @@
 
 #include <basilisk/util/includes.h>
 #include <basilisk/render/shader.h>
+#include <basilisk/render/uniformBlocks.h>
 
 namespace bsk::internal {
 
@@ -18,6 +19,15 @@ class VirtualCamera {
         virtual void update() = 0;
         virtual void use(Shader* shader) = 0;
 
+        // Camera state in the layout of the uCamera uniform block
+        virtual CameraBlock getCameraBlock() {
+            CameraBlock block {};
+            block.view = view;
+            block.projection = projection;
+            block.viewDirection = glm::vec3(0.0f, 0.0f, -1.0f);
+            return block;
+        }
+
         inline glm::mat4 getView() { return view; }
         inline glm::mat4 getProjection() { return projection; }
 };
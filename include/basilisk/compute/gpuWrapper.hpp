@@ -34,6 +34,8 @@ extern "C" {
     void*  gpu_encoder_create();
     void   gpu_encoder_destroy(void* encoder);
     void   gpu_encoder_dispatch(void* encoder, void* shader, uint32_t x, uint32_t y, uint32_t z);
+    void   gpu_encoder_dispatch_indirect(void* encoder, void* shader, void* args, uint64_t byte_offset);
+    void   gpu_encoder_clear_buffer(void* encoder, void* buffer);
     void   gpu_encoder_copy_buffer(void* encoder, void* src, void* dst);
     void   gpu_encoder_copy_to_staging(void* encoder, void* src, void* staging);
     void   gpu_encoder_copy_region_to_staging(void* encoder, void* src, void* staging,
@@ -182,6 +184,21 @@ public:
         gpu_encoder_dispatch(handle_, shaderHandle, x, y, z);
     }
 
+    // Append a compute dispatch whose workgroup counts are three u32 (x, y, z) read from
+    // args at byteOffset when the GPU runs it. Does NOT submit.
+    void dispatchIndirect(void* shaderHandle, const GpuBuffer<uint32_t>& args, uint64_t byteOffset = 0) {
+        assert(handle_ && "dispatch after submit");
+        assert(byteOffset % sizeof(uint32_t) == 0 && byteOffset + 3 * sizeof(uint32_t) <= args.sizeBytes());
+        gpu_encoder_dispatch_indirect(handle_, shaderHandle, args.handle(), byteOffset);
+    }
+
+    // Zero a buffer in command order, i.e. after earlier dispatches in this encoder. Does NOT submit.
+    template<typename T>
+    void clearBuffer(GpuBuffer<T>& buffer) {
+        assert(handle_ && "clearBuffer after submit");
+        gpu_encoder_clear_buffer(handle_, buffer.handle());
+    }
+
     // GPU-to-GPU buffer copy — no CPU involvement. Does NOT submit.
     // Use this to feed cellsB back into cellsA each frame.
     template<typename T>
@@ -0,0 +1,77 @@
+#ifndef BSK_LIGHT_CLUSTERS_H
+#define BSK_LIGHT_CLUSTERS_H
+
+#include <basilisk/util/includes.h>
+#include <basilisk/util/constants.h>
+
+#define CLUSTERS_X 16
+#define CLUSTERS_Y 9
+#define CLUSTER_SLICES 24
+
+namespace bsk::internal {
+
+struct ClusterInfo {
+    uint32_t offset;
+    uint32_t count;
+    uint32_t pad0;
+    uint32_t pad1;
+};
+
+/**
+ * @brief View space froxel grid with logarithmic depth slices. Bins point lights into the clusters they touch
+ *        and keeps a compact light index list per cluster. Purely CPU side, the light server uploads the results.
+ *
+ */
+class LightClusters {
+    private:
+        // clusters a light may touch, inclusive
+        struct LightRange {
+            unsigned int minX, maxX;
+            unsigned int minY, maxY;
+            unsigned int minSlice, maxSlice;
+        };
+
+        unsigned int clustersX;
+        unsigned int clustersY;
+        unsigned int slices;
+
+        glm::mat4 projection;
+        float near;
+        float far;
+        float sliceScale;
+        float sliceBias;
+
+        std::vector<glm::vec3> clusterMin; // view space bounds of each cluster
+        std::vector<glm::vec3> clusterMax;
+
+        std::vector<ClusterInfo> infos;
+        std::vector<uint32_t> indices;
+        std::vector<LightRange> ranges;
+        std::vector<char> rangeValid;
+
+        unsigned int getSlice(float depth) const;
+        bool getLightRange(const glm::vec4& light, LightRange& range) const;
+        void binClusters(const std::vector<glm::vec4>& lights, unsigned int first, unsigned int last, std::vector<uint32_t>& out);
+
+    public:
+        LightClusters(unsigned int clustersX = CLUSTERS_X, unsigned int clustersY = CLUSTERS_Y, unsigned int slices = CLUSTER_SLICES);
+
+        void setProjection(const glm::mat4& projection, float near, float far);
+        void bin(const std::vector<glm::vec4>& lights, unsigned int threadCount = NUM_THREADS);
+
+        inline unsigned int getClustersX() const { return clustersX; }
+        inline unsigned int getClustersY() const { return clustersY; }
+        inline unsigned int getSlices() const { return slices; }
+        inline unsigned int getClusterCount() const { return clustersX * clustersY * slices; }
+        inline float getSliceScale() const { return sliceScale; }
+        inline float getSliceBias() const { return sliceBias; }
+
+        inline const std::vector<ClusterInfo>& getInfos() const { return infos; }
+        inline const std::vector<uint32_t>& getIndices() const { return indices; }
+        inline const glm::vec3& getClusterMin(unsigned int cluster) const { return clusterMin[cluster]; }
+        inline const glm::vec3& getClusterMax(unsigned int cluster) const { return clusterMax[cluster]; }
+};
+
+}
+
+#endif
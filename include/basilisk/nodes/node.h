@@ -30,16 +30,13 @@ class Node : public VirtualNode<Node, glm::vec3, glm::quat, glm::vec3> {
         void setScale(glm::vec3 scale) override;
 
         Scene* getScene() { return (Scene*) scene; }
-        glm::mat4 getModel() { return model; }
+        glm::mat4 getLocalModel() const;
 
         // raycasting
         RayCastResult raycast(glm::vec3 origin, glm::vec3 direction);
 
         /** Returns an orphaned copy of this node. */
         std::shared_ptr<Node> orphanCopy() const;
-
-    private:
-        void updateModel();
 };
 
 }
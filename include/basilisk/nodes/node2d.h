@@ -40,6 +40,7 @@ private:
 public:
     Node2D(VirtualScene2D* scene);
     Node2D(Scene2D* scene, Mesh* mesh = nullptr, Material* material = nullptr, glm::vec2 position = {0.0, 0.0}, float rotation = 0.0, glm::vec2 scale = {1.0, 1.0}, glm::vec3 velocity = {0.0, 0.0, 0.0}, Collider* collider = nullptr, float density = 1.0, float friction = 0.5);
+    Node2D(Scene2D* scene, std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material, glm::vec2 position, float rotation, glm::vec2 scale, glm::vec3 velocity, Collider* collider, float density, float friction);
     Node2D(Node2D* parent, Mesh* mesh = nullptr, Material* material = nullptr, glm::vec2 position = {0.0, 0.0}, float rotation = 0.0, glm::vec2 scale = {1.0, 1.0}, glm::vec3 velocity = {0.0, 0.0, 0.0}, Collider* collider = nullptr, float density = 1.0, float friction = 0.5);
     Node2D(Mesh* mesh = nullptr, Material* material = nullptr, glm::vec2 position = {0.0, 0.0}, float rotation = 0.0, glm::vec2 scale = {1.0, 1.0}, glm::vec3 velocity = {0.0, 0.0, 0.0}, Collider* collider = nullptr, float density = 1.0, float friction = 0.5);
     Node2D(const Node2D& other) noexcept;
@@ -52,10 +53,11 @@ public:
 
     void setPosition(glm::vec2 position) override;
     void setPosition(glm::vec3 position);
+    void setRenderPose(const glm::vec3& pose);
     void setRotation(float rotation) override;
     void setScale(glm::vec2 scale) override;
     void setVelocity(glm::vec3 velocity);
-    void setLayer(float layer) { this->layer = layer; updateModel(); }
+    void setLayer(float layer) { this->layer = layer; markModelDirty(); }
     void setCollider(Collider* collider);
     void setDensity(float density);
     void setFriction(float friction);
@@ -71,6 +73,7 @@ public:
     glm::vec2& getScaleRef();
     glm::vec3& getVelocityRef();
     float getLayer() { return layer; }
+    glm::mat4 getLocalModel() const;
     float getDensity();
     float getFriction();
     Collider* getCollider();
@@ -98,11 +101,11 @@ public:
     std::shared_ptr<Node2D> orphanCopy() const;
 
 private:
-    void updateModel();
     void bindRigid(Mesh* mesh, Material* material, glm::vec2 position, float rotation, glm::vec2 scale, glm::vec3 velocity, Collider* collider, float density, float friction);
     void clear();
     void setRigid(const Node2D& other);
     void setRigid(Node2D&& other);
+    void teleportRigid(const glm::vec3& pose);
 };
 
 }
@@ -8,6 +8,7 @@
 #include <basilisk/render/mesh.h>
 #include <basilisk/render/shader.h>
 #include <basilisk/render/material.h>
+#include <basilisk/render/renderQueue.h>
 
 namespace bsk::internal {
 
@@ -28,6 +29,11 @@ private:
 protected:
     std::shared_ptr<Mesh> getMeshShared() const { return meshPython; }
     std::shared_ptr<Material> getMaterialShared() const { return materialPython; }
+    // Keep owners of the mesh and material the node was constructed with, without rebuilding its buffers
+    void holdShared(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material) {
+        meshPython = std::move(mesh);
+        materialPython = std::move(material);
+    }
 
     VirtualScene<Derived, P, R, S>* scene;
     Derived* parent;
@@ -37,11 +43,13 @@ protected:
     P position;
     R rotation;
     S scale;
-    glm::mat4 model;
+    glm::mat4 model;        // world model, only valid while modelDirty is false
+    bool modelDirty = true; // invariant: a dirty node has only dirty descendants
 
-    VBO* vbo;
-    EBO* ebo;
-    VAO* vao;
+    VAO* vao; // shared, owned by the mesh server
+
+    int boundsProxy = -1;      // leaf in the scene's bounds tree
+    int boundsQueueSlot = -1;  // pending entry in the scene's bounds queue
 
 public:
     class iterator {
@@ -85,6 +93,9 @@ public:
     VirtualNode& operator=(VirtualNode&& other) noexcept;
 
     void render();
+    void enqueue(RenderQueue* queue);
+    void getBounds(P& min, P& max);
+    void refreshBounds();
 
     virtual void setPosition(P position) {};
     virtual void setRotation(R rotation) {};
@@ -98,13 +109,12 @@ public:
     P getPosition() const { return position; }
     R getRotation() const { return rotation; }
     S getScale() const { return scale; }
-    const glm::mat4& getModel() const { return model; }
+    const glm::mat4& getModel();
     VirtualScene<Derived, P, R, S>* getScene() const { return scene; }
     Derived* getParent() const { return parent; }
     Shader* getShader() { return shader; }
     Material* getMaterial() const { return material; }
     Mesh* getMesh() const { return mesh; }
-    glm::mat4 getModel() { return model; }
     Engine* getEngine();
 
     // node hierarchy
@@ -115,6 +125,9 @@ public:
     iterator begin() { return iterator(asNode()); }
     iterator end() { return iterator(nullptr); }
 
+protected:
+    void markModelDirty();
+
 private:
     Derived* asNode() { return static_cast<Derived*>(this); }
 
@@ -127,6 +140,10 @@ private:
     bool hasCycle(Derived* potential_ancestor);
     void setSceneRecursive(VirtualScene<Derived, P, R, S>* new_scene);
     void orphanRecursive();
+
+    // scene bounds tree bookkeeping
+    void queueBoundsUpdate();
+    void dropBounds();
 };
 
 }
@@ -28,7 +28,8 @@ VirtualNode<Derived, P, R, S>::VirtualNode(VirtualScene<Derived, P, R, S>* scene
     materialPython(nullptr),
     position(position), 
     rotation(rotation), 
-    scale(scale)
+    scale(scale),
+    vao(nullptr)
 {
     parent->childrenSet.insert(asNode());
     parent->children.push_back(asNode());
@@ -62,8 +63,6 @@ VirtualNode<Derived, P, R, S>::VirtualNode(Derived* parent, Mesh* mesh, Material
     position(position), 
     rotation(rotation), 
     scale(scale),
-    vbo(nullptr),
-    ebo(nullptr),
     vao(nullptr)
 {
     parent->childrenSet.insert(asNode());
@@ -96,8 +95,6 @@ VirtualNode<Derived, P, R, S>::VirtualNode(VirtualScene<Derived, P, R, S>* scene
     position(), // default
     rotation(), // default
     scale(), // default
-    vbo(nullptr), 
-    ebo(nullptr), 
     vao(nullptr) 
 {}
 
@@ -113,8 +110,6 @@ VirtualNode<Derived, P, R, S>::VirtualNode(Mesh* mesh, Material* material, P pos
     position(position), 
     rotation(rotation), 
     scale(scale), 
-    vbo(nullptr), 
-    ebo(nullptr), 
     vao(nullptr) 
 {
     // Don't create buffers yet - shader is nullptr. Buffers will be created when adopted into a scene
@@ -142,8 +137,6 @@ VirtualNode<Derived,P,R,S>::VirtualNode(const VirtualNode& other) noexcept
       rotation(other.rotation),
       scale(other.scale),
       model(other.model),
-      vbo(nullptr),
-      ebo(nullptr),
       vao(nullptr)
 {
     std::vector<Derived*> childrenCopy = other.children;
@@ -193,13 +186,12 @@ VirtualNode<Derived, P, R, S>::VirtualNode(VirtualNode&& other) noexcept
       material(other.material),
       meshPython(std::move(other.meshPython)),
       materialPython(std::move(other.materialPython)),
-      vbo(other.vbo),
-      ebo(other.ebo),
       vao(other.vao),
       position(std::move(other.position)),
       rotation(std::move(other.rotation)),
       scale(std::move(other.scale)),
       model(std::move(other.model)),
+      modelDirty(other.modelDirty),
       children(std::move(other.children)),
       childrenSet(std::move(other.childrenSet))
 {
@@ -213,9 +205,11 @@ VirtualNode<Derived, P, R, S>::VirtualNode(VirtualNode&& other) noexcept
         parent->children.push_back(asNode());
     }
 
+    // take over other's place in the scene bounds tree
+    other.dropBounds();
+    queueBoundsUpdate();
+
     // make other safe to destroy
-    other.vbo = nullptr;
-    other.ebo = nullptr;
     other.vao = nullptr;
     other.parent = nullptr;
     other.children.clear();
@@ -261,6 +255,7 @@ VirtualNode<Derived, P, R, S>& VirtualNode<Derived, P, R, S>::operator=(const Vi
     rotation = other.rotation;
     scale = other.scale;
     model = other.model;
+    modelDirty = true;
 
     // Make a copy of the children vector to avoid iterator invalidation
     std::vector<Derived*> childrenCopy = other.children;
@@ -322,6 +317,8 @@ VirtualNode<Derived, P, R, S>& VirtualNode<Derived, P, R, S>::operator=(VirtualN
     rotation = std::move(other.rotation);
     scale = std::move(other.scale);
     model = std::move(other.model);
+    modelDirty = other.modelDirty;
+    vao = other.vao;
 
     // move children
     children = std::move(other.children);
@@ -336,9 +333,10 @@ VirtualNode<Derived, P, R, S>& VirtualNode<Derived, P, R, S>::operator=(VirtualN
         parent->children.push_back(asNode());
     }
 
+    other.dropBounds();
+    queueBoundsUpdate();
+
     // unbind other so it doesn't delete our stuff
-    other.vbo = nullptr;
-    other.ebo = nullptr;
     other.vao = nullptr;
     other.children.clear();
     other.childrenSet.clear();
@@ -351,7 +349,7 @@ VirtualNode<Derived, P, R, S>& VirtualNode<Derived, P, R, S>::operator=(VirtualN
  */
 template<typename Derived, typename P, typename R, typename S>
 void VirtualNode<Derived, P, R, S>::render() {
-    shader->setUniform("uModel", model);
+    shader->setUniform("uModel", getModel());
     if (material) {
         int materialID = getEngine()->getResourceServer()->getMaterialServer()->get(material);
         shader->setUniform("uMaterialID", materialID);
@@ -362,6 +360,51 @@ void VirtualNode<Derived, P, R, S>::render() {
     vao->render();
 }
 
+/**
+ * @brief Add this node to a render queue so it is drawn instanced with every other node sharing its mesh.
+ *        Nodes with a translucent material are drawn after the opaque ones, back to front.
+ * 
+ * @param queue The scene's render queue
+ */
+template<typename Derived, typename P, typename R, typename S>
+void VirtualNode<Derived, P, R, S>::enqueue(RenderQueue* queue) {
+    if (!vao) { return; }
+    unsigned int materialID = material ? getEngine()->getResourceServer()->getMaterialServer()->get(material) : 0;
+    bool translucent = material && material->getAlpha() < 1.0f;
+    queue->push(mesh, vao, getModel(), materialID, translucent);
+}
+
+/**
+ * @brief Get the world model matrix, rebuilding it (and any dirty ancestors) if a transform changed since it was last read.
+ *        Setting several transform components in a row therefore costs a single rebuild.
+ * 
+ * @return const glm::mat4& 
+ */
+template<typename Derived, typename P, typename R, typename S>
+const glm::mat4& VirtualNode<Derived, P, R, S>::getModel() {
+    if (modelDirty) {
+        glm::mat4 local = asNode()->getLocalModel();
+        model = parent ? parent->getModel() * local : local;
+        modelDirty = false;
+    }
+    return model;
+}
+
+/**
+ * @brief Flags the world model of this node and its subtree as stale. 
+ *        Stops at nodes that are already dirty since their subtrees are dirty too.
+ * 
+ */
+template<typename Derived, typename P, typename R, typename S>
+void VirtualNode<Derived, P, R, S>::markModelDirty() {
+    if (modelDirty) { return; }
+    modelDirty = true;
+    queueBoundsUpdate();
+    for (Derived* child : children) {
+        child->markModelDirty();
+    }
+}
+
 /**
  * @brief 
  * 
@@ -410,6 +453,9 @@ bool VirtualNode<Derived, P, R, S>::hasCycle(Derived* potential_ancestor) {
  */
 template<typename Derived, typename P, typename R, typename S>
 void VirtualNode<Derived, P, R, S>::setSceneRecursive(VirtualScene<Derived, P, R, S>* new_scene) {
+    if (this->scene != new_scene) {
+        dropBounds();
+    }
     this->scene = new_scene;
     // If this node was orphaned (shader is nullptr), set it from the new scene
     if (this->shader == nullptr && new_scene != nullptr) {
@@ -420,6 +466,7 @@ void VirtualNode<Derived, P, R, S>::setSceneRecursive(VirtualScene<Derived, P, R
             createBuffers();
         }
     }
+    queueBoundsUpdate();
     for (Derived* child : children) {
         child->setSceneRecursive(new_scene);
     }
@@ -463,6 +510,7 @@ void VirtualNode<Derived, P, R, S>::add(Derived* child) {
     // Set new parent and scene for child and all descendants
     child->parent = asNode();
     child->setSceneRecursive(this->scene);
+    child->markModelDirty();
     
     // Add to children list
     children.push_back(child);
@@ -499,6 +547,7 @@ void VirtualNode<Derived, P, R, S>::setMaterial(std::shared_ptr<Material> materi
  */
 template<typename Derived, typename P, typename R, typename S>
 void VirtualNode<Derived, P, R, S>::orphanRecursive() {
+    dropBounds();
     this->scene = nullptr;
     for (Derived* child : children) {
         child->orphanRecursive();
@@ -528,6 +577,7 @@ void VirtualNode<Derived, P, R, S>::remove(Derived* child) {
         // Orphan the child and all its descendants
         child->orphanRecursive();
         child->parent = nullptr;
+        child->markModelDirty();
     }
 }
 
@@ -561,7 +611,7 @@ void VirtualNode<Derived, P, R, S>::clear() {
 }
 
 /**
- * @brief Creates the VBO, EBO, and VAO for the VirtualNode
+ * @brief Acquires the shared VAO of this node's mesh from the mesh server. The mesh is only uploaded once for all nodes using it. 
  * 
  * @tparam Derived 
  * @tparam P 
@@ -570,38 +620,36 @@ void VirtualNode<Derived, P, R, S>::clear() {
  */
 template<typename Derived, typename P, typename R, typename S>
 void VirtualNode<Derived, P, R, S>::createBuffers() {
-    if (mesh->getIndices().empty()) {
-        vbo = new VBO(mesh->getVertices());
-        ebo = nullptr;
-        vao = new VAO(shader, vbo);
-    } else {
-        vbo = new VBO(mesh->getVertices());
-        ebo = new EBO(mesh->getIndices());
-        vao = new VAO(shader, vbo, ebo);
-    }
+    if (!mesh || !shader) { return; }
+    vao = Engine::getResourceServer()->getMeshServer()->acquire(mesh, shader);
+    queueBoundsUpdate();
 }
 
 template<typename Derived, typename P, typename R, typename S>
 void VirtualNode<Derived, P, R, S>::deleteBuffers() {
-    if (vao) { delete vao; vao = nullptr; }
-    if (vbo) { delete vbo; vbo = nullptr; }
-    if (ebo) { delete ebo; ebo = nullptr; }
+    dropBounds();
+    if (!vao) { return; }
+    // the resource server may already be gone if the node outlives the engine
+    if (ResourceServer* resourceServer = Engine::getResourceServer()) {
+        resourceServer->getMeshServer()->release(vao);
+    }
+    vao = nullptr;
 }
 
 template<typename Derived, typename P, typename R, typename S>
 void VirtualNode<Derived, P, R, S>::setMesh(Mesh* mesh) {
+    deleteBuffers();
     meshPython.reset();
     this->mesh = mesh;
-    deleteBuffers();
     // Only create buffers if we have a scene (shader). Orphans get buffers on adoption via setSceneRecursive.
     if (mesh && shader) createBuffers();
 }
 
 template<typename Derived, typename P, typename R, typename S>
 void VirtualNode<Derived, P, R, S>::setMesh(std::shared_ptr<Mesh> mesh) {
+    deleteBuffers();
     meshPython = std::move(mesh);
     this->mesh = meshPython.get();
-    deleteBuffers();
     // Only create buffers if we have a scene (shader). Orphans get buffers on adoption via setSceneRecursive.
     if (this->mesh && shader) createBuffers();
 }
@@ -614,4 +662,60 @@ void VirtualNode<Derived, P, R, S>::setScene(VirtualScene<Derived, P, R, S>* sce
     this->createBuffers();
 }
 
-}
\ No newline at end of file
+/**
+ * @brief Get the world space bounds of this node's mesh
+ * 
+ * @param min World space minimum
+ * @param max World space maximum
+ */
+template<typename Derived, typename P, typename R, typename S>
+void VirtualNode<Derived, P, R, S>::getBounds(P& min, P& max) {
+    glm::vec3 worldMin, worldMax;
+    transformAABB(getModel(), mesh->getBoundsMin(), mesh->getBoundsMax(), worldMin, worldMax);
+    min = P(worldMin);
+    max = P(worldMax);
+}
+
+/**
+ * @brief Refit this node in the scene bounds tree. Called by the scene for every queued node. 
+ * 
+ */
+template<typename Derived, typename P, typename R, typename S>
+void VirtualNode<Derived, P, R, S>::refreshBounds() {
+    boundsQueueSlot = -1;
+    if (!scene || !vao) { return; }
+
+    P min, max;
+    getBounds(min, max);
+    if (boundsProxy < 0) {
+        boundsProxy = scene->getBoundsTree().insert(asNode(), min, max);
+    } else {
+        scene->getBoundsTree().move(boundsProxy, min, max);
+    }
+}
+
+/**
+ * @brief Ask the scene to refit this node's bounds before the next frame. Only drawable nodes are tracked. 
+ * 
+ */
+template<typename Derived, typename P, typename R, typename S>
+void VirtualNode<Derived, P, R, S>::queueBoundsUpdate() {
+    if (!scene || !vao || boundsQueueSlot >= 0) { return; }
+    boundsQueueSlot = scene->queueBoundsUpdate(asNode());
+}
+
+/**
+ * @brief Remove this node from the scene bounds tree and queue. Must run before the node leaves its scene. 
+ * 
+ */
+template<typename Derived, typename P, typename R, typename S>
+void VirtualNode<Derived, P, R, S>::dropBounds() {
+    if (scene) {
+        if (boundsQueueSlot >= 0) { scene->cancelBoundsUpdate(boundsQueueSlot); }
+        if (boundsProxy >= 0)     { scene->getBoundsTree().remove(boundsProxy); }
+    }
+    boundsQueueSlot = -1;
+    boundsProxy = -1;
+}
+
+}
@@ -4,6 +4,8 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <random>
 #include <basilisk/physics/cellular/color.h>
 #include <basilisk/compute/gpuWrapper.hpp>
 
@@ -59,9 +61,13 @@ private:
     int height;
     float cellScale; // scale of a single cell
 
-    struct BrushPixel { int idx; Color color; };
-    std::vector<BrushPixel> pendingBrushPixels;  // pixels to inject into GPU each frame
-    std::vector<int> pendingBrushChunks;         // chunk indices marked dirty by brush this frame
+    // Grid writes are staged in pendingCells (same layout as the grid) and uploaded once per sand tick.
+    // Only the ranges listed in pendingSpans hold meaningful data.
+    struct CellSpan { size_t start; size_t end; }; // linear cell range [start, end)
+    std::vector<uint32_t> pendingCells;
+    std::vector<CellSpan> pendingSpans;
+    std::vector<int> pendingBrushChunks;   // unique chunk indices marked dirty by writes this frame
+    std::vector<uint32_t> pendingChunkMask; // 1 if the chunk is already in pendingBrushChunks, uploaded as the wake mask
 
     // Chunk grid
     int chunksWide;
@@ -74,15 +80,23 @@ private:
     bool firstActive = true;
     bool computeInitialized = false;
 
-    // CPU-side chunk state
-    std::vector<uint32_t> chunkActive;    // fed to GPU each frame
-    std::vector<uint32_t> chunkActiveOut; // staging readback lands here
+    // Chunk activity. By default it is rebuilt on the GPU each tick (activity.wgsl) and the
+    // dispatches are indirect; the GPU apply list and its count come back a tick later to drive
+    // the sparse cell readback. With gpuChunkActivity off the CPU reference builds it from a
+    // chunk_active_out readback and uploads it instead.
+    bool gpuChunkActivity = true;
+    std::vector<uint32_t> chunkActive;     // intent-pass chunks (CPU path)
+    std::vector<uint32_t> chunkActiveOut;  // staging readback lands here (CPU path)
+    std::vector<uint32_t> intentChunkList;
+    std::vector<uint32_t> applyChunkList;  // also drives sparse readback (CPU path)
+    std::vector<uint32_t> gpuApplyChunkReadback; // last tick's GPU apply list, drives sparse readback
     std::vector<uint32_t> gpuCellScratch;   // authoritative packed cells mirrored from GPU
     std::vector<uint32_t> gpuRenderScratch; // render staging (cells + particle overlay)
 
     // Pipelining: track whether an async readback is in flight
     bool pendingCellsReadback = false;
     bool pendingChunkReadback = false;
+    bool pendingApplyListReadback = false;
     bool pendingParticleReadback = false;
     bool pendingExplosionReadback = false;
 
@@ -100,6 +114,9 @@ private:
     GpuBuffer<uint32_t>* claim             = nullptr;
     GpuBuffer<uint32_t>* gpuChunkActive    = nullptr;
     GpuBuffer<uint32_t>* gpuActiveChunkList = nullptr; // compact list of active chunk indices for intent dispatch
+    GpuBuffer<uint32_t>* gpuApplyChunkList  = nullptr; // active chunks + neighbours for resolve/apply dispatch
+    GpuBuffer<uint32_t>* gpuChunkWake       = nullptr; // chunks marked by CPU writes since the last tick
+    GpuBuffer<uint32_t>* gpuChunkDispatchArgs = nullptr; // indirect args: intent xyz, resolve/apply xyz
     GpuBuffer<uint32_t>* gpuChunkIntent    = nullptr;
     GpuBuffer<uint32_t>* gpuChunkActiveOut = nullptr;
 
@@ -120,15 +137,27 @@ private:
     uint32_t nextParticleIndex = 0;
     uint32_t activeParticleCount = 0;
     static constexpr uint32_t MAX_PARTICLES = 100'000;
+
+    // Particle spatial index: live particles bucketed by the chunk under them (clamped to the grid),
+    // stored as a counting sort. Rebuilt on the first query after a particle readback or addParticle.
+    std::vector<uint32_t> particleChunkStart;  // numChunks + 1 offsets into particleChunkItems
+    std::vector<uint32_t> particleChunkItems;  // particle indices grouped by chunk
+    std::vector<uint32_t> particleChunkCursor; // rebuild scratch
+    bool particleIndexDirty = true;
+    void rebuildParticleIndex();
     static constexpr uint32_t MAX_EXPLOSIONS_PER_FRAME = 100;
     float cellUpdatesPerSecond = 40.0f;
     float cellUpdateAccumulator = 0.0f;
+    std::mt19937 simRng{std::random_device{}()};
 
     // Staging buffers (CPU-readable, written by encoder copy commands)
     StagingBuffer<uint32_t>* cellsStaging = nullptr; // full cell readback
     StagingBuffer<uint32_t>* chunkStaging = nullptr; // chunk_active_out readback
+    StagingBuffer<uint32_t>* applyListStaging = nullptr; // GPU apply list readback
+    StagingBuffer<uint32_t>* applyArgsStaging = nullptr; // GPU dispatch args readback, [3] is the apply count
 
     // Shaders
+    ComputeShader* activityShader = nullptr;
     ComputeShader* intentShader   = nullptr;
     ComputeShader* resolveShader  = nullptr;
     ComputeShader* applyShader    = nullptr;
@@ -138,7 +167,12 @@ private:
 
     // Chunk helpers
     void markChunkDirty(int px, int py);
-    void markChunkAndNeighborsDirty(int cx, int cy);
+    void markChunkRangeDirty(int x0, int y0, int x1, int y1); // inclusive pixel rect, marks touched chunks + neighbors once
+    void flushPendingChunks();
+
+    // Write helpers. Spans are pre-clipped to the grid; src == nullptr writes fill to every cell.
+    void writeRowSpan(int y, int x0, int x1, const uint32_t* src, uint32_t fill);
+    void uploadPendingSpans();
 
     // GL helpers
     std::string loadShaderSource(const char* filepath);
@@ -183,6 +217,15 @@ public:
     float getCellScale() const { return cellScale; }
     void setCellScale(float value) { cellScale = value; }
     void setCellUpdatesPerSecond(float value) { cellUpdatesPerSecond = value; }
+    // Reseed the per tick shader randomness, two buffers with the same seed and input step identically
+    void setSeed(uint32_t seed) { simRng.seed(seed); }
+    // Build chunk activity on the GPU (default) or with the CPU reference via a readback
+    void setGpuChunkActivity(bool enabled);
+    bool getGpuChunkActivity() const { return gpuChunkActivity; }
+    // Lists of the last sand tick, for checking the GPU against the CPU reference. The CPU ones are
+    // only built with GPU chunk activity off, reading the GPU ones waits for the device.
+    void getCpuChunkActivity(std::vector<uint32_t>& active, std::vector<uint32_t>& intentList, std::vector<uint32_t>& applyList) const;
+    void readGpuChunkActivity(std::vector<uint32_t>& active, std::vector<uint32_t>& intentList, std::vector<uint32_t>& applyList) const;
 
     std::vector<Color>& getData() { return getActiveBuffer(); }
 
@@ -208,6 +251,19 @@ public:
         uint8_t alphaThreshold = 1
     );
 
+    // Bulk writes. Each call marks every touched chunk once and stages one span per covered row.
+    void fillRect(int x, int y, int w, int h, const Color& color);
+    // mask is row-major w * h; non-zero entries are written with color
+    void stampMask(int x, int y, int w, int h, const uint8_t* mask, const Color& color);
+    // packed is row-major w * h in packCell layout, copied verbatim
+    void writePackedRegion(int x, int y, int w, int h, const uint32_t* packed);
+
+    // Persistence (see cellFile.h). Particles are transient and are not saved.
+    bool saveCells(const std::string& path) const;
+    bool loadCells(const std::string& path);
+    // Replace the whole grid with row-major packed cells (width * height) in one upload
+    bool setPackedCells(const std::vector<uint32_t>& packed);
+
     // basically what we're gonna do is dance
     bool addParticle(const glm::vec2& pos, const glm::vec2& vel, const Color& color, float forcedLifetime = 0.0f, uint32_t explodeRadius = 0u, float explodeFireChance = 0.0f);
     bool addParticle(const glm::vec2& pos, const glm::vec2& vel, char color[3], int mat_id, bool on_fire=false, bool is_static=false, float forcedLifetime = 0.0f, uint32_t explodeRadius = 0u, float explodeFireChance = 0.0f);
@@ -217,6 +273,29 @@ public:
     // particle getter
     const std::vector<Particle>& getParticles() const { return particleCpu; }
 
+    // Calls fn(const Particle&) for each live particle in the chunks overlapping the inclusive pixel rect.
+    // Chunk granularity: particles up to a chunk outside the rect are visited too.
+    template<typename Fn>
+    void forEachParticleInRect(int x0, int y0, int x1, int y1, Fn&& fn) {
+        if (particleIndexDirty) {
+            rebuildParticleIndex();
+        }
+        if (particleChunkItems.empty()) return;
+        const int cx0 = std::clamp(x0 / CHUNK_SIZE, 0, chunksWide - 1);
+        const int cy0 = std::clamp(y0 / CHUNK_SIZE, 0, chunksHigh - 1);
+        const int cx1 = std::clamp(x1 / CHUNK_SIZE, 0, chunksWide - 1);
+        const int cy1 = std::clamp(y1 / CHUNK_SIZE, 0, chunksHigh - 1);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            const int rowBase = cy * chunksWide;
+            // chunks of one row are adjacent in the index, so their particles form one range
+            const uint32_t begin = particleChunkStart[rowBase + cx0];
+            const uint32_t end   = particleChunkStart[rowBase + cx1 + 1];
+            for (uint32_t i = begin; i < end; ++i) {
+                fn(particleCpu[particleChunkItems[i]]);
+            }
+        }
+    }
+
     bool getExplosionHappened() const { return explosionHappened; }
 };
 
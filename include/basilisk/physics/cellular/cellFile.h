@@ -0,0 +1,65 @@
+#ifndef BSK_PHYSICS_CELLULAR_CELL_FILE_H
+#define BSK_PHYSICS_CELLULAR_CELL_FILE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace bsk::internal {
+
+// Binary cell world format (little-endian, every field a u32 so the file can be mapped and read in place):
+//
+//   CellFileHeader
+//   CellChunkEntry[chunksWide * chunksHigh]   row-major chunk table
+//   u32 payload[payloadWords]                 RLE / RAW chunk bodies
+//
+// Cells are stored in the same packing as the GPU (packCell) with the momentum bits (31-30) cleared.
+// Momentum only records the direction of a cell's last sideways move, as next tick's left/right
+// preference, and apply rewrites it for every cell it touches. A loaded grid therefore loses at most
+// one tick of that preference for cells that were moving, and clearing it keeps uniform runs long.
+// Each chunk covers CHUNK_SIZE x CHUNK_SIZE cells clipped to the grid, walked row by row.
+// Empty and uniform chunks live entirely in their table entry and cost no payload.
+
+inline constexpr uint32_t CELL_FILE_MAGIC   = 0x434B5342u; // "BSKC"
+inline constexpr uint32_t CELL_FILE_VERSION = 1u;
+
+enum class CellChunkEncoding : uint32_t {
+    EMPTY   = 0, // every cell is 0
+    UNIFORM = 1, // every cell equals entry.value
+    RLE     = 2, // entry.value runs of (count, cell) starting at entry.offset
+    RAW     = 3, // entry.value cells starting at entry.offset
+};
+
+struct CellFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t chunkSize;
+    uint32_t chunksWide;
+    uint32_t chunksHigh;
+    uint32_t payloadWords;
+};
+static_assert(sizeof(CellFileHeader) == 32, "CellFileHeader layout is part of the file format");
+
+struct CellChunkEntry {
+    uint32_t encoding;
+    uint32_t value;
+    uint32_t offset; // word offset into the payload
+};
+static_assert(sizeof(CellChunkEntry) == 12, "CellChunkEntry layout is part of the file format");
+
+// Encode a row-major width x height grid of packed cells into out (replaces its contents)
+void encodeCellChunks(const uint32_t* cells, int width, int height, int chunkSize, std::vector<uint8_t>& out);
+
+// Decode an encoded image (e.g. a mapped file) into a row-major grid of width x height packed cells.
+// Returns false if the data is truncated, malformed, or was saved for a different grid size.
+bool decodeCellChunks(const uint8_t* data, size_t size, int width, int height, int chunkSize, uint32_t* cells);
+
+bool writeCellFile(const std::string& path, const uint32_t* cells, int width, int height, int chunkSize);
+bool readCellFile(const std::string& path, int width, int height, int chunkSize, std::vector<uint32_t>& cells);
+
+}
+
+#endif
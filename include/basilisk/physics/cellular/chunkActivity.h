@@ -0,0 +1,32 @@
+#ifndef BSK_PHYSICS_CELLULAR_CHUNK_ACTIVITY_H
+#define BSK_PHYSICS_CELLULAR_CHUNK_ACTIVITY_H
+
+#include <cstdint>
+#include <vector>
+
+namespace bsk::internal {
+
+// CPU reference for shaders/cellular/activity.wgsl, you must update both at the same time.
+// Used by CellBuffer when GPU chunk activity is disabled and to check the GPU lists against.
+//
+//   activeOut  chunks that moved, burned or received particles since the last tick (row-major, 0/1)
+//   wake       chunks marked by CPU writes, already including their neighbour ring (row-major, 0/1)
+//
+//   chunkActive  dilate(activeOut) | wake, one entry per chunk
+//   intentList   ascending indices where chunkActive is set
+//   applyList    ascending indices of dilate(chunkActive)
+//
+// The GPU appends to its lists with atomics, so compare against these as sets, not sequences.
+void buildChunkActivity(
+    const uint32_t* activeOut,
+    const uint32_t* wake,
+    int chunksWide,
+    int chunksHigh,
+    std::vector<uint32_t>& chunkActive,
+    std::vector<uint32_t>& intentList,
+    std::vector<uint32_t>& applyList
+);
+
+}
+
+#endif
@@ -81,6 +81,27 @@ struct CellParticle {
     Color color;
 };
 
+// Material histograms of the sand cells and particles one rigid overlaps (Solver::queryTouches).
+// Indexed by Color::getMatId(); bin 0 (empty) is always 0.
+struct CellTouchReport {
+    static constexpr int MATERIAL_COUNT = 16;
+    std::array<uint32_t, MATERIAL_COUNT> sand{};
+    std::array<uint32_t, MATERIAL_COUNT> particles{};
+
+    // materialId -1 matches any material
+    bool touchingSand(int materialId = -1) const { return count(sand, materialId) > 0u; }
+    bool touchingParticle(int materialId = -1) const { return count(particles, materialId) > 0u; }
+    bool touching(int materialId = -1) const { return touchingSand(materialId) || touchingParticle(materialId); }
+
+private:
+    static uint32_t count(const std::array<uint32_t, MATERIAL_COUNT>& bins, int materialId) {
+        if (materialId < 0) {
+            return std::accumulate(bins.begin(), bins.end(), 0u);
+        }
+        return materialId < MATERIAL_COUNT ? bins[static_cast<std::size_t>(materialId)] : 0u;
+    }
+};
+
 // NOTE these values are copied from intent.wgsl, you must update both at the same time
 inline bool is_fluid(const Color& color) {
     MaterialIDs mat_id = static_cast<MaterialIDs>(color.getMatId());
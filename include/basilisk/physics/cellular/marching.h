@@ -6,6 +6,8 @@
 #include <basilisk/physics/cellular/rdp.h>
 
 #include <earcut.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -73,20 +75,64 @@ private:
     void decomposeBayazitEntry(const std::vector<glm::vec2>& ring);
 };
 
+// ----------------------------------------------
+// MarchBitset
+// ----------------------------------------------
+
+// Row-major occupancy grid, one bit per cell. Rows are padded to whole 64-bit words with
+// at least one spare bit, so a row can be shifted by one cell without reaching the next row.
+// Bits past width are always zero.
+class MarchBitset {
+private:
+    int width = 0;
+    int height = 0;
+    int wordsPerRow = 0;
+    std::vector<uint64_t> words;
+
+public:
+    MarchBitset() = default;
+    MarchBitset(int width, int height) { reset(width, height); }
+
+    // resize and clear every bit, keeps the allocation when shrinking
+    void reset(int width, int height) {
+        this->width = std::max(width, 0);
+        this->height = std::max(height, 0);
+        wordsPerRow = this->width / 64 + 1;
+        words.assign(static_cast<std::size_t>(wordsPerRow) * static_cast<std::size_t>(this->height), 0ull);
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getWordsPerRow() const { return wordsPerRow; }
+    bool empty() const { return width == 0 || height == 0; }
+
+    bool test(int x, int y) const { return (row(y)[x >> 6] >> (x & 63)) & 1ull; }
+    void set(int x, int y) { row(y)[x >> 6] |= 1ull << (x & 63); }
+
+    uint64_t* row(int y) { return words.data() + static_cast<std::size_t>(y) * static_cast<std::size_t>(wordsPerRow); }
+    const uint64_t* row(int y) const { return words.data() + static_cast<std::size_t>(y) * static_cast<std::size_t>(wordsPerRow); }
+};
+
+// Horizontal run of set cells [x0, x1] in row y
+struct MarchRun {
+    int y;
+    int x0;
+    int x1;
+};
+
 // ----------------------------------------------
 // MarchingGrid
 // ----------------------------------------------
 
 class MarchingGrid {
 private:
-    std::vector<std::vector<int>> weights;
-    std::vector<std::vector<std::pair<int, int>>> components;
+    MarchBitset cells;
+    std::vector<int> labels; // row-major component index per cell, -1 when empty
+    std::vector<std::vector<MarchRun>> components;
     int width, height;
 
-    static constexpr int ENCODING = 1024;
-
-    // marching squares cases hard coded
-    const std::array<std::vector<Edge>, 16> marchCases {{
+    // marching squares cases hard coded, shared so building a grid per body does not rebuild the table
+    static inline const std::array<std::vector<Edge>, 16> marchCases {{
         {},
         {Edge{{0.0f, 0.5f}, {0.5f, 0.0f}}},
         {Edge{{0.5f, 0.0f}, {1.0f, 0.5f}}},
@@ -105,39 +151,32 @@ private:
         {}
     }};
 
+    // Corner planes for 64 neighbouring quads. Bit i describes quad (word * 64 + i - 1, qy),
+    // whose corners are 1 = (x, y), 2 = (x + 1, y), 4 = (x + 1, y + 1), 8 = (x, y + 1).
+    struct MarchQuadWord {
+        uint64_t c1, c2, c4, c8;
+    };
+
 public:
-    explicit MarchingGrid(std::vector<std::vector<int>> grid)
-        : weights(std::move(grid))
-        , width(static_cast<int>(weights.size()))
-        , height(weights.empty() ? 0 : static_cast<int>(weights[0].size()))
+    explicit MarchingGrid(MarchBitset grid)
+        : cells(std::move(grid))
+        , width(cells.getWidth())
+        , height(cells.getHeight())
     {}
 
     bool isInside(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
-    bool isValid(int x, int y) const { return isInside(x, y) && weights[x][y] == 1; }
+    bool isValid(int x, int y) const { return isInside(x, y) && cells.test(x, y); }
 
-    void bfs();
+    // 8-connected labelling with union-find over row runs
+    void labelComponents();
 
-    const std::vector<std::vector<std::pair<int, int>>>& connectedComponents() const { return components; }
+    const std::vector<std::vector<MarchRun>>& connectedComponents() const { return components; }
 
     std::vector<MarchComponentGeometry> genMarch();
     
 private:
-    int encode(int x, int y) {
-        return (x + width) * ENCODING + (y + height);
-    }
-
-    std::pair<int, int> decode(int key) {
-        const int x = (key / ENCODING) - width;
-        const int y = (key % ENCODING) - height;
-        return {x, y};
-    }
-
-    int getMarchQuad(int x, int y) const {
-        return 4 * static_cast<int>(isValid(x + 1, y + 1))
-             + 2 * static_cast<int>(isValid(x + 1, y       ))
-             + 8 * static_cast<int>(isValid(x,      y + 1))
-             + 1 * static_cast<int>(isValid(x,      y ));
-    }
+    int findRoot(std::vector<int>& parent, int i) const;
+    MarchQuadWord getMarchQuad(int qy, int word) const;
 };
 
 }
@@ -15,12 +15,15 @@ private:
     std::unordered_map<Rigid*, Primitive*> primitives;
     int rebuildTimer;
 
+    Primitive* build(std::vector<Primitive*>& leaves, size_t begin, size_t end);
+
 public:
     BVH();
     ~BVH();
 
     // Dynamic BVH operations
     void insert(Rigid* rigid);
+    void insert(const std::vector<Rigid*>& rigids); // bulk insert, rebuilds the tree top down once
     void remove(Rigid* rigid);
     void refit(Rigid* rigid);  // Update a single object's bounds and refit tree
     void refitAll();  // Refit all bounding boxes (call after physics step)
@@ -31,6 +34,7 @@ public:
     std::vector<Rigid*> query(const glm::vec2& bl, const glm::vec2& tr) const;
     std::vector<Rigid*> query(const glm::vec2& point) const;
     std::vector<Rigid*> query(Rigid* rigid) const;
+    void query(Rigid* rigid, std::vector<Rigid*>& results) const; // replaces results, reusing its allocation
     
     // Utility
     uint32_t getSize() const { return size; }
@@ -2,6 +2,7 @@
 #define BSK_PHYSICS_FORCES_JOINT_H
 
 #include <basilisk/physics/forces/force.h>
+#include <basilisk/util/pool.h>
 
 namespace bsk::internal {
 
@@ -27,6 +28,10 @@ public:
         float fracture = INFINITY);
     ~Joint();
 
+    // each force type has its own slab pool, see Manifold
+    static void* operator new(size_t size) { return getSlabPool<Joint>().allocate(size); }
+    static void operator delete(void* pointer, size_t size) { getSlabPool<Joint>().deallocate(pointer, size); }
+
     static int rows(ForceTable* forceTable, uint32_t specialIndex) { return 3; }
     int rows() override { return 3; }
     bool initialize() override;
@@ -2,6 +2,7 @@
 #define BSK_PHYSICS_FORCES_MANIFOLD_H
 
 #include <basilisk/physics/forces/force.h>
+#include <basilisk/util/pool.h>
 
 namespace bsk::internal {
 
@@ -53,6 +54,10 @@ public:
     Manifold(Solver* solver, Rigid* bodyA, const std::vector<glm::vec2>& worldVerticesB);
     ~Manifold();
 
+    // pooled, broadphase and sand contacts create and delete thousands of these per step
+    static void* operator new(size_t size) { return getSlabPool<Manifold>().allocate(size); }
+    static void operator delete(void* pointer, size_t size) { getSlabPool<Manifold>().deallocate(pointer, size); }
+
     static int rows(ForceTable* forceTable, uint32_t specialIndex);
     int rows() override;
     bool initialize() override;
@@ -2,6 +2,7 @@
 #define BSK_PHYSICS_FORCES_MOTOR_H
 
 #include <basilisk/physics/forces/force.h>
+#include <basilisk/util/pool.h>
 
 namespace bsk::internal {
 
@@ -22,6 +23,9 @@ public:
     Motor(Solver* solver, Rigid* bodyA, Rigid* bodyB, float speed, float maxTorque);
     ~Motor();
 
+    static void* operator new(size_t size) { return getSlabPool<Motor>().allocate(size); }
+    static void operator delete(void* pointer, size_t size) { getSlabPool<Motor>().deallocate(pointer, size); }
+
     static int rows(ForceTable* forceTable, uint32_t specialIndex) { return 1; }
     int rows() override { return 1; }
     bool initialize() override { return true; }
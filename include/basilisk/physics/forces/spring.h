@@ -2,6 +2,7 @@
 #define BSK_PHYSICS_FORCES_SPRING_H
 
 #include <basilisk/physics/forces/force.h>
+#include <basilisk/util/pool.h>
 
 namespace bsk::internal {
 
@@ -26,6 +27,9 @@ public:
     Spring(Solver* solver, Rigid* bodyA, Rigid* bodyB, glm::vec2 rA, glm::vec2 rB, float stiffness, float rest = -1);
     ~Spring();
 
+    static void* operator new(size_t size) { return getSlabPool<Spring>().allocate(size); }
+    static void operator delete(void* pointer, size_t size) { getSlabPool<Spring>().deallocate(pointer, size); }
+
     static int rows(ForceTable* forceTable, uint32_t specialIndex) { return 1; }
     int rows() override { return 1; }
     bool initialize() override { return true; }
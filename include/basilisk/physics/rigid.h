@@ -2,6 +2,7 @@
 #define BSK_PHYSICS_RIGID_H
 
 #include <basilisk/util/includes.h>
+#include <basilisk/util/pool.h>
 
 namespace bsk::internal {
 
@@ -51,6 +52,10 @@ public:
     Rigid(Solver* solver, Node2D* node, Collider* collider, glm::vec3 position, glm::vec2 size, float density, float friction, glm::vec3 velocity);
     ~Rigid();
 
+    // pooled, spawning and despawning debris would otherwise hit the heap per body
+    static void* operator new(size_t size) { return getSlabPool<Rigid>().allocate(size); }
+    static void operator delete(void* pointer, size_t size) { getSlabPool<Rigid>().deallocate(pointer, size); }
+
     bool constrainedTo(Rigid* other) const;
 
     // Coloring
@@ -89,9 +94,9 @@ public:
     void setNode(Node2D* node);
     void setIndex(uint32_t index);
     void setJacobianMask(const glm::vec3& jacobianMask);
-    void setResolvesCollisions(bool resolvesCollisions) { this->resolvesCollisions = resolvesCollisions; }
-    void setCollisionGroup(int group) { this->collisionGroup = group; }
-    void setHasGravity(bool hasGravity) { this->hasGravity = hasGravity; }
+    void setResolvesCollisions(bool resolvesCollisions);
+    void setCollisionGroup(int group);
+    void setHasGravity(bool hasGravity);
 
     // Getters
     glm::vec3 getPosition() const;
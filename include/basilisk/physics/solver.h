@@ -14,11 +14,13 @@
 #include <basilisk/physics/forces/motor.h>
 #include <basilisk/physics/forces/spring.h>
 #include <basilisk/compute/gpuWrapper.hpp>
+#include <basilisk/util/arena.h>
 #include <optional>
 #include <thread>
 #include <barrier>
 #include <semaphore>
 #include <atomic>
+#include <mutex>
 
 namespace bsk::internal {
 
@@ -29,10 +31,12 @@ class ColliderTable;
 class BodyTable;
 class ForceTable;
 class CellBuffer;
+class MarchBitset;
 template<typename T> class ForceTypeTable;
 struct ThreadScratch;
 struct WorkRange;
 struct CellParticle;
+struct CellTouchReport;
 
 // Core solver class which holds all the rigid bodies and forces, and has logic to step the simulation forward in time
 class Solver {
@@ -66,6 +70,9 @@ private:
     BodyTable* bodyTable;
     ForceTable* forceTable;
 
+    // Temporaries of one step, reset at the start of the next
+    FrameArena stepArena;
+
     // Coloring
     ColorQueue colorQueue;
     ColorTableManager colors;
@@ -81,6 +88,19 @@ private:
     std::atomic<bool> running;
     std::vector<std::thread> workers;
 
+    // Asynchronous stepping, the whole step runs on stepThread while the caller renders
+    std::thread stepThread;
+    std::binary_semaphore stepStart;
+    std::binary_semaphore stepFinish;
+    float asyncDt = 0.0f;
+    int asyncSubsteps = 1;
+    std::atomic<bool> stepInFlight = false;
+    bool stepUncollected = false; // finished asynchronous step whose poses nobody has collected yet
+    std::mutex stepMutex;         // Python threads may wait for the step while the frame loop starts the next one
+    static thread_local bool onSolverThread; // set on the step and worker threads, which never wait for themselves
+
+    void waitForStep();
+
     // shaders
     ComputeShader* velocityShader = nullptr;
 
@@ -88,9 +108,13 @@ private:
     CellBuffer* cellBuffer;
     std::vector<uint32_t> sandManifoldForceIndices;
 
+    // inclusive pixel rect (bl_x, bl_y, tr_x, tr_y) of the body's sand AABB, clamped to the grid
+    std::optional<glm::ivec4> sandPixelRect(Rigid* body) const;
+    void collectTouches(Rigid* rigid, CellTouchReport& report);
+
     std::optional<glm::ivec2> fillSandGridFromRigidAABB(
         Rigid* body,
-        std::vector<std::vector<int>>& sand,
+        MarchBitset& sand,
         bool includeFluid = true,
         bool skipSparseNonStatic = false
     ) const;
@@ -108,6 +132,10 @@ public:
     void clear();
     void defaultParams();
     void step(float dt);
+    void beginStep(float dt, int substeps = 1);
+    void finishStep();
+    bool collectStep();
+    bool isStepping() const { return stepInFlight.load(std::memory_order_acquire); }
 
     // Getters
     static ColliderTable* getColliderTable() { return colliderTable.get(); }
@@ -127,13 +155,13 @@ public:
     bool getPostStabilize() const { return postStabilize; }
     
     // Setters
-    void setGravity(std::optional<glm::vec3> value) { gravity = value; }
-    void setIterations(int value) { iterations = value; }
-    void setDt(float value) { dt = value; }
-    void setAlpha(float value) { alpha = value; }
-    void setBeta(float value) { beta = value; }
-    void setGamma(float value) { gamma = value; }
-    void setPostStabilize(bool value) { postStabilize = value; }
+    void setGravity(std::optional<glm::vec3> value) { finishStep(); gravity = value; }
+    void setIterations(int value) { finishStep(); iterations = value; }
+    void setDt(float value) { finishStep(); dt = value; }
+    void setAlpha(float value) { finishStep(); alpha = value; }
+    void setBeta(float value) { finishStep(); beta = value; }
+    void setGamma(float value) { finishStep(); gamma = value; }
+    void setPostStabilize(bool value) { finishStep(); postStabilize = value; }
     void setBodies(Rigid* value) { bodies = value; }
     void setForces(Force* value) { forces = value; }
     void setForceTable(ForceTable* value) { forceTable = value; }
@@ -144,6 +172,7 @@ public:
 
     // Threading
     void workerLoop(unsigned int threadID);
+    void stepLoop();
 
     // GPU
     void rebuildVelocityShader();
@@ -205,6 +234,8 @@ public:
     bool isTouchingSand(Rigid* rigid, int materialId=-1);
     bool isTouchingParticle(Rigid* rigid, int materialId=-1);
     std::vector<CellParticle> getTouchedParticles(Rigid* rigid, int materialId=-1);
+    // One report per rigid (nullptr -> empty report). Shares one particle index build across the batch.
+    std::vector<CellTouchReport> queryTouches(const std::vector<Rigid*>& rigids);
 
     // Picking
     Rigid* pick(glm::vec2 at, glm::vec2& local);
@@ -40,8 +40,15 @@ private:
     std::vector<int> color;
     std::vector<glm::vec3> jacobianMask; // TODO create buffer later
     std::vector<uint32_t> indexMap;
+    std::vector<uint32_t> ids;     // stable id of the body in each row
+    std::vector<uint32_t> idRows;  // id -> current row, NO_ROW once removed. Ids are never reused
+
+    uint64_t layoutVersion = 0; // bumped whenever rows move, appear or the columns reallocate
 
     BVH* bvh;
+    bool syncNodes = true; // push poses to nodes at the end of each step, off while the scene steps asynchronously
+    bool batching = false;
+    std::vector<Rigid*> batchedBodies; // inserted since beginBatch, added to the bvh together by endBatch
 
     // GPU side data
     GpuBuffer<bsk::vec3>* posBuffer;
@@ -58,6 +65,18 @@ private:
     ComputeShader*& velocityShader;
 
 public:
+    // Holds a batch open for its lifetime, so the batched bodies reach the bvh even when spawning throws
+    class BatchGuard {
+    private:
+        BodyTable* table;
+
+    public:
+        explicit BatchGuard(BodyTable* table) : table(table) { table->beginBatch(); }
+        ~BatchGuard() { table->endBatch(); }
+        BatchGuard(const BatchGuard&) = delete;
+        BatchGuard& operator=(const BatchGuard&) = delete;
+    };
+
     BodyTable(Solver* solver, uint32_t capacity, ComputeShader*& velocityShader);
     ~BodyTable();
 
@@ -72,10 +91,29 @@ public:
     void resize(uint32_t newCapacity) override;
     void compact() override;
     void insert(Rigid* body, glm::vec3 position, glm::vec2 size, float density, float friction, glm::vec3 velocity, Collider* collider);
+    void reserve(uint32_t count);
+    void beginBatch();
+    void endBatch();
 
+    void setSyncNodes(bool value) { syncNodes = value; }
     void writeToNodes();
+    void writeToNodes(const uint32_t* rows, uint32_t count);
+    void writeToNodes(float alpha);
     void writeToGpu();
 
+    // Whole columns for bulk access. Only the first getSize() rows are live, and pointers into a column
+    // stay valid only while getLayoutVersion() is unchanged.
+    std::vector<bsk::vec3>& getPosColumn() { return pos; }
+    std::vector<bsk::vec3>& getVelColumn() { return vel; }
+    std::vector<float>& getMassColumn() { return mass; }
+    std::vector<float>& getFrictionColumn() { return friction; }
+    uint64_t getLayoutVersion() const { return layoutVersion; }
+
+    // Stable body ids, unlike rows they survive compaction
+    static constexpr uint32_t NO_ROW = UINT32_MAX;
+    uint32_t getId(uint32_t index) { return ids[index]; }
+    uint32_t getRow(uint32_t id) const { return id < idRows.size() ? idRows[id] : NO_ROW; }
+
     // getters
     Rigid* getBodies(uint32_t index) { return bodies[index]; }
     bool getToDelete(uint32_t index) { return toDelete[index]; }
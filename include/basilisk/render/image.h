@@ -11,16 +11,24 @@ class Image {
         int width;
         int height;
         int nChannels;
+        bool async;
+        std::atomic<bool> loaded = true; // set once data, width and height are final
+
+        void decode(const std::string& resolvedPath, bool flip_vertically);
     
     public:
-        Image(std::string file, bool flip_vertically=true);
-        Image(void* data, int width, int height, int nChannels=4) : data((unsigned char*)data), width(width), height(height), nChannels(nChannels) {}
+        Image(std::string file, bool flip_vertically=true, bool async=false);
+        Image(const char* file, bool flip_vertically=true, bool async=false) : Image(std::string(file), flip_vertically, async) {} // keeps string literals off the raw data constructor
+        Image(void* data, int width, int height, int nChannels=4) : data((unsigned char*)data), width(width), height(height), nChannels(nChannels), async(false) {}
         Image(const std::vector<float>& data, int width, int height, int nChannels=4);
         ~Image();
         
         unsigned char* getData() { return data; }
         int getWidth() { return width; }
         int getHeight() {return height; }
+        bool isAsync() const { return async; }
+        bool isLoaded() const { return loaded.load(std::memory_order_acquire); }
+        void wait() const;
 };
 
 }
@@ -66,6 +66,7 @@ class Material {
             float clearcoat = 0.0f,
             float clearcoatGloss = 0.0f
         );
+        ~Material();
 
         inline const glm::vec3& getColor() const { return color; }
         
@@ -2,24 +2,54 @@
 #define BSK_MESH_H
 
 #include <basilisk/util/includes.h>
+#include <basilisk/render/meshBVH.h>
 
 namespace bsk::internal {
 
+// Attributes of a mesh whose layout is known (imported from a file), in vertex order after the position
+inline constexpr uint32_t MESH_UV = 1u << 0;
+inline constexpr uint32_t MESH_NORMAL = 1u << 1;
+inline constexpr uint32_t MESH_LAYOUT_KNOWN = 1u << 2;
+
 class Mesh {
     private:
         std::vector<float> vertices;
         std::vector<unsigned int> indices;
+        uint32_t attributes = 0; // MESH_* flags, 0 for user data whose layout only the shader knows
+        bool quantize = true;    // pack normals and UVs into smaller types on upload
+
+        // derived once from the vertex data
+        unsigned int stride = 3; // floats per vertex, position is always the first 3
+        glm::vec3 boundsMin = glm::vec3(0.0f);
+        glm::vec3 boundsMax = glm::vec3(0.0f);
+        std::shared_ptr<MeshBVH> bvh; // built on the first ray query
+
+        void computeLayout();
 
     public:
         Mesh(const std::string modelPath, bool generateUV=false, bool generateNormals=false);
 
         template<typename vertex>
-        Mesh(const std::vector<vertex>& vertices): vertices(vertices) {}
+        Mesh(const std::vector<vertex>& vertices): vertices(vertices) { computeLayout(); }
         template<typename vertex, typename index>
-        Mesh(const std::vector<vertex>& vertices, const std::vector<index>& indices): vertices(vertices), indices(indices) {}
+        Mesh(const std::vector<vertex>& vertices, const std::vector<index>& indices): vertices(vertices), indices(indices) { computeLayout(); }
 
         std::vector<float>& getVertices() { return vertices; }
         std::vector<unsigned int>& getIndices() { return indices; }
+
+        void optimize();
+
+        uint32_t getAttributes() const { return attributes; }
+        bool hasLayout() const { return attributes & MESH_LAYOUT_KNOWN; }
+        bool getQuantize() const { return quantize; }
+        void setQuantize(bool value) { quantize = value; } // applies from the next upload
+
+        unsigned int getStride() const { return stride; }
+        unsigned int getVertexCount() const { return vertices.size() / stride; }
+        glm::vec3 getPosition(unsigned int vertex) const { return glm::vec3(vertices[vertex * stride], vertices[vertex * stride + 1], vertices[vertex * stride + 2]); }
+        const glm::vec3& getBoundsMin() const { return boundsMin; }
+        const glm::vec3& getBoundsMax() const { return boundsMax; }
+        const MeshBVH& getBVH();
 };
 
 }
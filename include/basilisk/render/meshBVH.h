@@ -0,0 +1,45 @@
+#ifndef BSK_MESH_BVH_H
+#define BSK_MESH_BVH_H
+
+#include <basilisk/util/includes.h>
+
+namespace bsk::internal {
+
+struct MeshRayHit {
+    float t = std::numeric_limits<float>::infinity();
+    unsigned int triangle = 0;
+    glm::vec3 normal = glm::vec3(0.0f); // unnormalized face normal in model space
+};
+
+/**
+ * @brief Static bounding volume hierarchy over the triangles of a mesh, in model space. 
+ *        Nodes are stored depth first so the left child of a node is always the next node. 
+ * 
+ */
+class MeshBVH {
+    private:
+        struct BVHNode {
+            glm::vec3 min;
+            glm::vec3 max;
+            unsigned int start; // first triangle for leaves, right child for internal nodes
+            unsigned int count; // 0 for internal nodes
+        };
+
+        std::vector<BVHNode> nodes;
+        std::vector<glm::vec3> corners; // 3 per triangle, in leaf order
+        std::vector<unsigned int> triangleIds; // original triangle index, in leaf order
+
+        unsigned int build(std::vector<unsigned int>& order, std::vector<glm::vec3>& centroids, const std::vector<glm::vec3>& triangles, unsigned int start, unsigned int count);
+
+    public:
+        MeshBVH(const std::vector<float>& vertices, const std::vector<unsigned int>& indices, unsigned int stride);
+
+        bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxT, MeshRayHit& hit) const;
+
+        unsigned int getTriangleCount() const { return triangleIds.size(); }
+        unsigned int getNodeCount() const { return nodes.size(); }
+};
+
+}
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef BSK_MESH_CACHE_H
+#define BSK_MESH_CACHE_H
+
+#include <basilisk/util/includes.h>
+#include <filesystem>
+
+// Covers the cooked layout and the way meshes are imported, see util/cacheFile.h
+#define MESH_CACHE_VERSION 2
+
+namespace bsk::internal {
+
+// Fixed size start of a cooked mesh file, followed by the source path, the vertex floats and the indices
+struct MeshCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t importFlags;  // assimp post processing flags the mesh was imported with
+    uint32_t stride;       // floats per vertex
+    int64_t sourceTime;    // last write time of the source file
+    uint64_t sourceSize;   // byte size of the source file
+    uint64_t vertexCount;  // floats
+    uint64_t indexCount;
+    uint32_t pathLength;   // bytes of source path following the header, padded to 4
+    uint32_t attributes;   // MESH_* layout flags
+};
+static_assert(sizeof(MeshCacheHeader) == 56);
+
+const std::filesystem::path& getMeshCacheDirectory();
+bool readMeshCache(const std::string& sourcePath, unsigned int importFlags, std::vector<float>& vertices, std::vector<unsigned int>& indices, uint32_t& attributes);
+void writeMeshCache(const std::string& sourcePath, unsigned int importFlags, unsigned int stride, uint32_t attributes, const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
+
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef BSK_MESH_OPTIMIZER_H
+#define BSK_MESH_OPTIMIZER_H
+
+#include <basilisk/util/includes.h>
+#include <basilisk/render/vertexFormat.h>
+
+// Simulated post transform cache size for triangle ordering
+#define VERTEX_CACHE_SIZE 32
+
+namespace bsk::internal {
+
+class Mesh;
+
+// GPU ready copy of a mesh, built at upload and not kept
+struct PackedMesh {
+    std::vector<unsigned char> vertices;
+    std::vector<unsigned char> indices;
+    GLenum indexType;
+    VertexFormat format;
+};
+
+void weldVertices(std::vector<float>& vertices, std::vector<unsigned int>& indices, unsigned int stride);
+void optimizeVertexCache(std::vector<unsigned int>& indices, unsigned int vertexCount);
+void optimizeVertexFetch(std::vector<float>& vertices, std::vector<unsigned int>& indices, unsigned int stride);
+PackedMesh packMesh(Mesh& mesh, bool quantize = true);
+
+}
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef BSK_PBO_H
+#define BSK_PBO_H
+
+#include <basilisk/util/includes.h>
+
+namespace bsk::internal {
+
+class PBO {
+    private:
+        unsigned int ID;
+        unsigned int size;
+
+    public:
+        PBO(unsigned int size = 0);
+        ~PBO();
+
+        void bind();
+        void unbind();
+        unsigned int getSize() { return size; }
+
+        void* map(unsigned int size);
+        void unmap();
+};
+
+}
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef BSK_RENDER_QUEUE_H
+#define BSK_RENDER_QUEUE_H
+
+#include <basilisk/util/includes.h>
+#include <basilisk/render/vbo.h>
+#include <basilisk/render/vao.h>
+#include <basilisk/render/mesh.h>
+#include <basilisk/render/shader.h>
+
+namespace bsk::internal {
+
+// Per-instance data streamed to the iModel0..iModel3 / iMaterialID attributes of the instance shaders
+struct InstanceData {
+    glm::mat4 model;
+    float materialID;
+    float padding[3];
+};
+static_assert(sizeof(InstanceData) == 80, "InstanceData must match the instance attribute layout");
+
+// Byte offset of the named instance attribute in InstanceData, -1 for any other attribute
+int getInstanceAttributeOffset(const std::string& name);
+
+/**
+ * @brief Collects the nodes of a scene each frame as draw commands with 64 bit sort keys. The keys are radix sorted so
+ *        instances sharing a mesh end up adjacent and translucent instances come last, back to front. Every run of
+ *        equal meshes is then drawn with one instanced call out of a single streamed buffer, orphaned once per frame.
+ *        Building and sorting touch no GL state, only render() does.
+ *
+ */
+class RenderQueue {
+    private:
+        struct DrawCommand {
+            uint64_t key;
+            uint32_t instance; // index into instances
+            uint32_t mesh;     // index into meshVAOs
+        };
+
+        // consecutive sorted instances sharing a mesh
+        struct DrawRun {
+            VAO* vao;
+            unsigned int first;
+            unsigned int count;
+        };
+
+        // instance attribute of the shader and where it lives inside InstanceData
+        struct InstanceAttribute {
+            GLint location;
+            GLint count;
+            GLenum dataType;
+            unsigned int offset;
+        };
+
+        Shader* shader;
+        VBO* instanceBuffer;
+        unsigned int capacity; // in instances
+
+        std::vector<InstanceAttribute> instanceAttributes;
+        glm::mat4 view;
+
+        // dense per frame mesh ids, used in the sort keys
+        std::unordered_map<Mesh*, unsigned int> meshLookup;
+        std::vector<VAO*> meshVAOs; // any VAO already holding each mesh's vertex and index buffers
+
+        // storage is kept across frames so nothing reallocates in steady state
+        std::vector<InstanceData> instances;
+        std::vector<DrawCommand> commands;
+        std::vector<DrawCommand> scratch;
+        std::vector<InstanceData> sortedInstances;
+        std::vector<DrawRun> runs;
+        bool sorted;
+
+    public:
+        RenderQueue(Shader* shader);
+        ~RenderQueue();
+
+        void clear(const glm::mat4& view);
+        void push(Mesh* mesh, VAO* vao, const glm::mat4& model, unsigned int materialID, bool translucent = false);
+        void sort();
+        void render();
+
+        unsigned int getBatchCount() const { return runs.size(); }
+        unsigned int getInstanceCount() const { return instances.size(); }
+};
+
+}
+
+#endif
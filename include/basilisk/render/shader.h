@@ -8,6 +8,7 @@
 #include <basilisk/render/fbo.h>
 #include <basilisk/render/ubo.h>
 #include <basilisk/render/cubemap.h>
+#include <basilisk/render/shaderCache.h>
 
 namespace bsk::internal {
 
@@ -26,14 +27,29 @@ struct Attribute {
     unsigned int offset;
 };
 
+// Lets the uniform caches be searched with a const char* without building a std::string
+struct UniformNameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+};
+
 class Shader {
     private:
+        static unsigned int boundProgram; // program currently in use by the context
+
         unsigned int ID;
+        std::shared_ptr<ShaderProgram> program; // shared with every Shader built from the same sources
         unsigned int stride;
         std::vector<Attribute> attributes;
+        std::vector<Attribute> instanceAttributes;
         std::unordered_map<unsigned int, BoundTexture> slotBindings;
 
+        // Reflected once after linking
+        std::unordered_map<std::string, GLint, UniformNameHash, std::equal_to<>> uniformLocations;
+        std::unordered_map<std::string, GLuint, UniformNameHash, std::equal_to<>> uniformBlocks;
+
         void loadAttributes();
+        void loadUniforms();
 
         void bindTextureToSlot(const char* name, GLuint texID, GLenum target, unsigned int slot);
 
@@ -51,14 +67,19 @@ class Shader {
         void bind(const char* name, Cubemap* cubemap, unsigned int slot);
 
         int getUniformLocation(const char* name);
+        bool hasUniform(const char* name) { return getUniformLocation(name) >= 0; }
+        bool hasUniformBlock(const char* name) { return uniformBlocks.find(name) != uniformBlocks.end(); }
         unsigned int getStride() { return stride; }
         std::vector<Attribute>& getAttributes() { return attributes; }
+        std::vector<Attribute>& getInstanceAttributes() { return instanceAttributes; }
+        bool isInstanced() const { return !instanceAttributes.empty(); }
 
         void setUniform(const char* name, float value);
         void setUniform(const char* name, double value);
         void setUniform(const char* name, int value);
         void setUniform(const char* name, glm::vec2 value);
         void setUniform(const char* name, glm::vec3 value);
+        void setUniform(const char* name, glm::ivec3 value);
         void setUniform(const char* name, glm::mat4 value);
 
         unsigned int getID() { return ID; }
@@ -0,0 +1,85 @@
+#ifndef BSK_SHADER_CACHE_H
+#define BSK_SHADER_CACHE_H
+
+#include <basilisk/util/includes.h>
+#include <filesystem>
+
+// Covers the layout of cached program binaries, see util/cacheFile.h
+#define SHADER_CACHE_VERSION 1
+
+namespace bsk::internal {
+
+// Fixed size start of a cached program binary file, followed by the binary itself
+struct ShaderCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;          // hash of both sources and the driver, also the file name
+    uint64_t check;        // second hash of the same, so a name collision is detected rather than loaded
+    uint32_t binaryFormat; // driver specific format from glGetProgramBinary
+    uint32_t binaryLength;
+};
+static_assert(sizeof(ShaderCacheHeader) == 32);
+
+/**
+ * @brief A linked GL program and the program state that is cached on the CPU. Shared by every Shader built from
+ *        the same sources, so the caches stay in sync with what the program actually holds.
+ *
+ */
+struct ShaderProgram {
+    GLuint id = 0;
+    std::unordered_map<GLuint, unsigned int> blockBindings; // block index -> binding point
+    std::unordered_map<GLint, int> samplerSlots;            // sampler location -> texture slot
+
+    ShaderProgram(GLuint id): id(id) {}
+    ~ShaderProgram() { glDeleteProgram(id); }
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator=(const ShaderProgram&) = delete;
+};
+
+/**
+ * @brief Keeps shader startup off the compiler. Expanded sources are kept per file and reused until one of the files
+ *        they include changes. Identical vertex and fragment pairs share one program within the process, and linked
+ *        programs are written to disk with glGetProgramBinary so later runs on the same driver skip compiling.
+ *        Any failure along the binary path falls back to compiling from source.
+ *
+ */
+class ShaderCache {
+    private:
+        struct SourceEntry {
+            std::string source;
+            std::vector<std::pair<std::string, std::filesystem::file_time_type>> files; // root and every include
+        };
+
+        // Live programs by a hash of their sources. The sources are kept to compare on a hit, a collision
+        // then gets its own program.
+        struct ProgramEntry {
+            std::string vertexSource;
+            std::string fragmentSource;
+            std::weak_ptr<ShaderProgram> program;
+        };
+
+        std::unordered_map<std::string, SourceEntry> sources;
+        std::unordered_multimap<uint64_t, ProgramEntry> programs;
+
+        // Program binaries are GL 4.1 or ARB_get_program_binary, resolved on first use
+        bool binariesChecked = false;
+        bool binariesSupported = false;
+        std::string driver;
+
+        bool checkBinarySupport();
+        GLuint loadBinary(uint64_t key, uint64_t check);
+        void storeBinary(GLuint program, uint64_t key, uint64_t check);
+
+    public:
+        const std::string& getSource(const std::string& path);
+        std::shared_ptr<ShaderProgram> getProgram(const std::string& vertexSource, const std::string& fragmentSource);
+
+        void clearSources() { sources.clear(); }
+
+        static const std::filesystem::path& getDirectory();
+        static ShaderCache& getGlobal();
+};
+
+}
+
+#endif
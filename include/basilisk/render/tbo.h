@@ -11,11 +11,12 @@ class TBO {
         unsigned int size;
         unsigned int capacity;
         unsigned int textureID;
+        GLenum format;
 
     public:
-        TBO(const void* data, unsigned int size, unsigned int reserve = 0);
+        TBO(const void* data, unsigned int size, unsigned int reserve = 0, GLenum format = GL_RGBA32F);
         template<typename T>
-        TBO(const std::vector<T>& data, unsigned int reserve = 0) : TBO(data.data(), data.size() * sizeof(T), reserve) {}
+        TBO(const std::vector<T>& data, unsigned int reserve = 0, GLenum format = GL_RGBA32F) : TBO(data.data(), data.size() * sizeof(T), reserve, format) {}
 
         ~TBO();
 
@@ -15,8 +15,12 @@ class TextureArray {
         unsigned int height;
         std::vector<Image*> images;
         unsigned int samplerFilter;
+        unsigned int levels; // mip levels, more than one only for linear filtering
+        bool mipmapsDirty;
 
-        void generate();
+        void allocateStorage();
+        void grow(unsigned int newCapacity);
+        void copyLayers(unsigned int source, unsigned int destination, unsigned int count);
         void uploadImage(Image* image, unsigned int position);
         
     public:
@@ -26,11 +30,20 @@ class TextureArray {
         void bind();
         void unbind();
         unsigned int add(Image* image);
+        unsigned int allocate(Image* image);
+        void reserve(unsigned int capacity);
+        void updateMipmaps();
+        void upload(const void* pixels, unsigned int position);
+        void resize(Image* image, unsigned char* out) const;
         void setFilter(unsigned int magFilter, unsigned int minFilter);
         void setWrap(unsigned int wrap);
 
         unsigned int getID() { return id; }
         unsigned int getSize() { return images.size(); }
+        unsigned int getCapacity() const { return capacity; }
+        unsigned int getWidth() const { return width; }
+        unsigned int getHeight() const { return height; }
+        unsigned int getLayerSize() const { return width * height * 4; }
 
 };
 
@@ -0,0 +1,40 @@
+#ifndef BSK_UNIFORM_BLOCKS_H
+#define BSK_UNIFORM_BLOCKS_H
+
+#include <basilisk/util/includes.h>
+
+// Binding points of the per-frame uniform blocks, shared by every shader that declares them
+#define CAMERA_BLOCK_BINDING 0
+#define LIGHT_BLOCK_BINDING 1
+
+#define MAX_DIRECTIONAL_LIGHTS 5
+
+namespace bsk::internal {
+
+// std140 mirror of the uCamera block in shaders/include/camera.glsl
+struct CameraBlock {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec3 position;
+    float pad0;
+    glm::vec3 viewDirection;
+    float pad1;
+};
+static_assert(sizeof(CameraBlock) == 160, "CameraBlock must match the std140 layout of uCamera");
+
+// std140 mirror of the uLights block in shaders/include/light.glsl
+struct LightBlock {
+    glm::vec4 directionalLights[MAX_DIRECTIONAL_LIGHTS * 2]; // (color, intensity), (direction, 0)
+    glm::vec3 ambientLight;
+    int directionalLightCount;
+    glm::ivec3 clusterGrid;
+    int pointLightCount;
+    glm::vec2 screenSize;
+    float clusterScale;
+    float clusterBias;
+};
+static_assert(sizeof(LightBlock) == 208, "LightBlock must match the std140 layout of uLights");
+
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include <basilisk/render/vbo.h>
 #include <basilisk/render/ebo.h>
 #include <basilisk/render/shader.h>
+#include <basilisk/render/vertexFormat.h>
 
 namespace bsk::internal {
 
@@ -14,16 +15,19 @@ class VAO {
         Shader* shader;
         VBO* vbo;
         EBO* ebo;
+        GLenum indexType = GL_UNSIGNED_INT;
 
     public:
         VAO();
         VAO(Shader* shader, VBO* vertices, EBO* indices=nullptr);
+        VAO(Shader* shader, VBO* vertices, EBO* indices, const VertexFormat& format, GLenum indexType);
         ~VAO();
 
         void render(unsigned int instanceCount=0);
         
         void bind();
         void bindAttribute(GLint location, GLint count, unsigned int dataType, unsigned int stride, unsigned int offset, unsigned int divisor=0);
+        void bindAttribute(GLint location, const VertexAttributeFormat& format, unsigned int stride, unsigned int divisor=0);
         void bindAttributes(std::vector<std::string> attribs, unsigned int divisor=0);
         void bindBuffer(VBO* buffer, std::vector<std::string> attribs, unsigned int divisor=0);
         void bindBuffer(VBO* buffer, EBO* indices, std::vector<std::string> attribs, unsigned int divisor=0);
@@ -9,6 +9,7 @@ class VBO {
     private:
         unsigned int ID;
         unsigned int size;
+        unsigned int drawType;
 
     public:
         VBO(const void* data, unsigned int size, unsigned int drawType=GL_STATIC_DRAW);
@@ -22,6 +23,7 @@ class VBO {
         unsigned int getSize();
 
         void write(const void* data, unsigned int size, unsigned int offset=0);
+        void orphan(unsigned int size);
         template<typename T>
         void write(const std::vector<T>& data, unsigned int offset=0);
 
@@ -0,0 +1,32 @@
+#ifndef BSK_VERTEX_FORMAT_H
+#define BSK_VERTEX_FORMAT_H
+
+#include <basilisk/util/includes.h>
+
+namespace bsk::internal {
+
+// One attribute of an interleaved vertex buffer, as glVertexAttribPointer takes it
+struct VertexAttributeFormat {
+    GLint count;          // components
+    GLenum type;          // GL_FLOAT, GL_HALF_FLOAT, GL_SHORT, ...
+    GLboolean normalized; // integer types read as [-1, 1] / [0, 1]
+    unsigned int offset;  // bytes from the start of the vertex
+};
+
+/**
+ * @brief Explicit layout of an interleaved vertex buffer. Attribute i feeds the i-th vertex attribute of the shader.
+ *
+ */
+struct VertexFormat {
+    std::vector<VertexAttributeFormat> attributes;
+    unsigned int stride = 0; // bytes per vertex
+
+    void add(GLint count, GLenum type, GLboolean normalized, unsigned int size) {
+        attributes.push_back({ count, type, normalized, stride });
+        stride += size;
+    }
+};
+
+}
+
+#endif
@@ -10,34 +10,18 @@
 #include <basilisk/render/shader.h>
 #include <basilisk/render/ubo.h>
 #include <basilisk/render/tbo.h>
+#include <basilisk/render/uniformBlocks.h>
+#include <basilisk/light/lightClusters.h>
 
-#define MAX_DIRECTIONAL_LIGHTS 5
 #define MAX_POINT_LIGHTS 1000
-#define TILE_SIZE 32
-#define MAX_LIGHTS_PER_TILE 64
-
-struct Plane {
-    glm::vec3 normal;
-};
-
-struct Tile {
-    Plane planes[4];
-};
-
-struct TileInfo {
-    uint32_t offset;
-    uint32_t count;
-    uint32_t pad0;
-    uint32_t pad1;
-};
 
 namespace bsk::internal {
 
 class LightServer {
 
     private:
-        UBO* directionalLightsUBO;
-        TBO* tileTBO;
+        UBO* lightsUBO;
+        TBO* clusterTBO;
         TBO* lightIndicesTBO;
         TBO* pointLightsTBO;
 
@@ -47,25 +31,20 @@ class LightServer {
         std::vector<PointLight*> pointLights;
         std::vector<AmbientLight*> ambientLights;
 
-        std::vector<glm::vec4> directionalLightData;
+        LightBlock lightBlock;
         std::vector<glm::vec4> pointLightData;
-        glm::vec3 ambientLightData;
 
-        unsigned int tilesX;
-        unsigned int tilesY;
-        std::vector<Tile> tiles;
-        std::vector<TileInfo> tileInfos;
-        std::vector<uint32_t> lightIndices;
+        LightClusters clusters;
+        std::vector<unsigned int> selectedLights; // indices of the point lights sent to the gpu
+        std::vector<float> lightDistances;
+        std::vector<glm::vec4> lightBounds; // view space position and range of each selected light
 
         // Update groups
-        void updateDirectional(Shader* shader);
-        void updatePoint(Shader* shader, StaticCamera* camera);
-        void updateAmbient(Shader* shader);
-        void updateTiles(StaticCamera* camera);
-
-        // Helpers
-        glm::vec3 unproject(const glm::mat4& inverseProjection, float x, float y);
-        bool lightIntersectsTile(glm::vec3& lightPositionViewSpace, float lightRadius, Tile& tile);
+        void updateDirectional();
+        void updatePoint(StaticCamera* camera);
+        void updateAmbient();
+        void updateClusters(StaticCamera* camera);
+        void selectPointLights(StaticCamera* camera);
 
     public:
         LightServer();
@@ -78,8 +57,11 @@ class LightServer {
         void add(std::shared_ptr<PointLight> light);
         void add(std::shared_ptr<AmbientLight> light);
 
-        void update(Shader* shader, StaticCamera* camera);
-        void setTiles(Shader* shader, StaticCamera* camera, unsigned int screenWidth, unsigned int screenHeight);
+        void update(StaticCamera* camera);
+        void bind(Shader* shader);
+        void setClusters(StaticCamera* camera, unsigned int screenWidth, unsigned int screenHeight);
+
+        inline const LightClusters& getClusters() const { return clusters; }
 };
 
 }
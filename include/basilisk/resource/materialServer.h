@@ -6,15 +6,32 @@
 #include <basilisk/render/shader.h>
 #include <basilisk/render/tbo.h>
 #include <basilisk/resource/textureServer.h>
+#include <basilisk/util/hash.h>
 
 namespace bsk::internal {
 
+/**
+ * @brief Keeps the data of every material in a TBO. Slots are shared by content, so identical materials
+ *        occupy one slot however many Material objects describe them. Slots are reference counted
+ *        and reused once the last material using them changes or is destroyed.
+ *
+ */
 class MaterialServer {
     private:
         TextureServer* textureServer;
         TBO* tbo;
 
-        std::unordered_map<Material*, unsigned int> materialMapping;
+        std::unordered_map<Material*, unsigned int> materialMapping; // material -> slot
+        std::unordered_multimap<uint64_t, unsigned int> contentMapping; // hash of slot data -> slot
+        std::vector<MaterialData> slotData; // CPU mirror of the TBO, to confirm hash hits
+        std::vector<unsigned int> slotReferences;
+        std::vector<unsigned int> freeSlots;
+        std::unordered_set<Material*> pendingMaterials; // written while one of their images was still loading
+
+        bool isPending(Material* material) const;
+        MaterialData resolve(Material* material);
+        unsigned int acquire(const MaterialData& data);
+        void release(unsigned int slot);
 
     public:
         MaterialServer(TextureServer* textureServer);
@@ -25,6 +42,10 @@ class MaterialServer {
         
         void write(Shader* shader, std::string name, unsigned int startSlot = 0);
         void update(Material* material);
+        void remove(Material* material);
+        void refresh();
+
+        unsigned int getSlotCount() const { return slotData.size() - freeSlots.size(); }
 };
 
 }
@@ -0,0 +1,58 @@
+#ifndef BSK_MESH_SERVER_H
+#define BSK_MESH_SERVER_H
+
+#include <basilisk/util/includes.h>
+#include <basilisk/render/mesh.h>
+#include <basilisk/render/shader.h>
+#include <basilisk/render/vbo.h>
+#include <basilisk/render/ebo.h>
+#include <basilisk/render/vao.h>
+#include <basilisk/render/meshOptimizer.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief Uploads each mesh to the GPU once and hands out shared VAOs to every node drawing it.
+ *        Buffers are reference counted and released when the last node using them lets go.
+ * 
+ */
+class MeshServer {
+    private:
+        struct MeshBuffers {
+            VBO* vbo;
+            EBO* ebo;
+            unsigned int references;
+            VertexFormat format;  // empty when the shader's float layout applies
+            GLenum indexType;
+        };
+
+        struct ShaderBinding {
+            Mesh* mesh;
+            Shader* shader;
+            unsigned int references;
+        };
+
+        struct PairHash {
+            size_t operator()(const std::pair<Mesh*, Shader*>& key) const {
+                return std::hash<Mesh*>()(key.first) ^ (std::hash<Shader*>()(key.second) << 1);
+            }
+        };
+
+        std::unordered_map<Mesh*, MeshBuffers> meshBuffers;
+        std::unordered_map<std::pair<Mesh*, Shader*>, VAO*, PairHash> vaoMapping;
+        std::unordered_map<VAO*, ShaderBinding> vaoBindings;
+
+    public:
+        MeshServer() = default;
+        ~MeshServer();
+
+        VAO* acquire(Mesh* mesh, Shader* shader);
+        void release(VAO* vao);
+
+        unsigned int getMeshCount() const { return meshBuffers.size(); }
+        unsigned int getVAOCount() const { return vaoBindings.size(); }
+};
+
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef BSK_RESOURCE_CACHE_H
+#define BSK_RESOURCE_CACHE_H
+
+#include <basilisk/util/includes.h>
+#include <basilisk/render/mesh.h>
+#include <basilisk/render/image.h>
+
+// Lookups between sweeps of entries whose resources were released
+#define RESOURCE_CACHE_PRUNE_INTERVAL 256
+
+namespace bsk::internal {
+
+/**
+ * @brief Hands out shared meshes and images so a file or a block of procedural data is loaded once however often
+ *        it is asked for. File resources are keyed by canonical path and load options, procedural ones by a hash of
+ *        their contents. The cache only holds weak references: a resource is freed with its last handle and its
+ *        entry is evicted on the next prune.
+ *
+ */
+class ResourceCache {
+    private:
+        std::unordered_map<std::string, std::weak_ptr<Mesh>> meshPaths;
+        std::unordered_multimap<uint64_t, std::weak_ptr<Mesh>> meshContents;
+        std::unordered_map<std::string, std::weak_ptr<Image>> imagePaths;
+        std::unordered_multimap<uint64_t, std::weak_ptr<Image>> imageContents;
+        unsigned int lookupsSincePrune;
+
+        static std::string canonicalPath(const std::string& path);
+        void countLookup();
+
+    public:
+        ResourceCache(): lookupsSincePrune(0) {}
+
+        std::shared_ptr<Mesh> getMesh(const std::string& path, bool generateUV = false, bool generateNormals = false);
+        std::shared_ptr<Mesh> getMesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices = {});
+        std::shared_ptr<Image> getImage(const std::string& path, bool flipVertically = true, bool async = false);
+        std::shared_ptr<Image> getImage(const std::vector<float>& data, int width, int height, int nChannels = 4);
+
+        unsigned int prune();
+        unsigned int getSize() const { return meshPaths.size() + meshContents.size() + imagePaths.size() + imageContents.size(); }
+
+        static ResourceCache& getGlobal();
+};
+
+}
+
+#endif
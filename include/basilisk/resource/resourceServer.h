@@ -5,6 +5,7 @@
 #include <basilisk/render/shader.h>
 #include <basilisk/resource/textureServer.h>
 #include <basilisk/resource/materialServer.h>
+#include <basilisk/resource/meshServer.h>
 #include <basilisk/render/material.h>
 #include <basilisk/render/image.h>
 #include <basilisk/render/mesh.h>
@@ -18,15 +19,18 @@ class ResourceServer {
     private:
         TextureServer* textureServer;
         MaterialServer* materialServer;
+        MeshServer* meshServer;
 
     public:
         ResourceServer(std::vector<unsigned int> textureSizeBuckets = {256, 1024, 2048, 2200}, unsigned int textureFilter = GL_LINEAR);
         ~ResourceServer();
 
         void write(Shader* shader, std::string textureUniform, std::string materialUniform, unsigned int startingSlot=8);
+        void update();
 
         inline TextureServer* getTextureServer() const { return textureServer; }
         inline MaterialServer* getMaterialServer() const { return materialServer; }
+        inline MeshServer* getMeshServer() const { return meshServer; }
 
         static Image*    defaultImage;
         static Image*    logoImage;
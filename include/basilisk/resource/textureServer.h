@@ -5,16 +5,42 @@
 #include <basilisk/render/image.h>
 #include <basilisk/render/textureArray.h>
 #include <basilisk/render/shader.h>
+#include <basilisk/render/pbo.h>
+
+// Staging buffers cycled through by texture uploads, so a buffer is only rewritten once the copies it fed are long done
+#define TEXTURE_STAGING_RING_SIZE 3
+// Bytes of async texture data committed to the GPU per frame. A single larger image still goes through on its own.
+#define TEXTURE_UPLOAD_BUDGET (16u * 1024u * 1024u)
 
 namespace bsk::internal {
 
 class TextureServer {
     private:
+        // async image being decoded and resized on the loader pool
+        struct PendingUpload {
+            Image* image;
+            int arrayIndex; // -1 if the image failed to load
+            uint64_t hash;  // of the decoded pixels, see hashPixels
+            std::vector<unsigned char> pixels; // resized to the array's layer size
+            std::atomic<bool> ready = false;
+        };
+
         std::vector<unsigned int> sizeBuckets;
         std::unordered_map<Image*, std::pair<unsigned int, unsigned int>> imageMapping;
+        std::unordered_map<uint64_t, std::pair<unsigned int, unsigned int>> contentMapping; // pixel hash -> layer
         std::vector<TextureArray*> textureArrays;
 
-        unsigned int getClosestSize(unsigned int x);
+        std::vector<std::unique_ptr<PendingUpload>> pendingUploads;
+        std::unordered_set<Image*> pendingImages;
+        std::array<PBO*, TEXTURE_STAGING_RING_SIZE> stagingRing;
+        unsigned int stagingIndex;
+        unsigned int uploadBudget;
+
+        unsigned int getClosestSize(unsigned int x) const;
+        int getArrayIndex(unsigned int width) const;
+        void addAsync(Image* image);
+        static uint64_t hashPixels(Image* image);
+        unsigned int commitUploads();
 
     public:
         TextureServer(std::vector<unsigned int> sizeBuckets = {256, 1024, 2048, 2200}, unsigned int filter = GL_LINEAR);
@@ -22,6 +48,13 @@ class TextureServer {
 
         std::pair<unsigned int, unsigned int> add(Image* image);
         std::pair<unsigned int, unsigned int> get(Image* image);
+        void remove(Image* image);
+        bool isPending(Image* image) const { return image && pendingImages.count(image); }
+        unsigned int update();
+        void reserve(unsigned int size, unsigned int count);
+
+        void setUploadBudget(unsigned int bytes) { uploadBudget = bytes; }
+        unsigned int getPendingCount() const { return pendingImages.size(); }
 
         std::vector<TextureArray*>& getArrays() { return textureArrays; }
 
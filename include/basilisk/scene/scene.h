@@ -7,7 +7,9 @@
 #include <basilisk/camera/virtualCamera.h>
 #include <basilisk/scene/virtualScene.h>
 #include <basilisk/camera/camera.h>
+#include <basilisk/camera/frustum.h>
 #include <basilisk/render/shader.h>
+#include <basilisk/render/renderQueue.h>
 #include <basilisk/resource/lightServer.h>
 #include <basilisk/light/light.h>
 #include <basilisk/render/skybox.h>
@@ -23,9 +25,13 @@ class Scene : public VirtualScene<Node, glm::vec3, glm::quat, glm::vec3> {
         StaticCamera* internalCamera;
         std::shared_ptr<StaticCamera> cameraPython;
         Shader* shader;
+        RenderQueue* renderQueue;
+        UBO* cameraUBO;
         LightServer* lightServer;
         Skybox* skybox = nullptr;
 
+        RayCastResult raycastTree(glm::vec3 origin, glm::vec3 direction);
+
     public:
         Scene(Engine* engine, bool addSkybox = true, bool addLight = true, bool addCube = false);
         Scene(Engine* engine, Shader* shader, bool addSkybox = true, bool addLight = true, bool addCube = false);
@@ -54,6 +60,7 @@ class Scene : public VirtualScene<Node, glm::vec3, glm::quat, glm::vec3> {
         // mouse interaction
         RayCastResult pick(glm::vec2 mousePosition);
         RayCastResult raycast(glm::vec3 origin, glm::vec3 direction);
+        std::vector<RayCastResult> raycast(const std::vector<glm::vec3>& origins, const std::vector<glm::vec3>& directions);
 };
 
 }
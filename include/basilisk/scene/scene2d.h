@@ -8,6 +8,7 @@
 #include <basilisk/scene/virtualScene.h>
 #include <basilisk/camera/camera2d.h>
 #include <basilisk/render/shader.h>
+#include <basilisk/render/renderQueue.h>
 #include <basilisk/physics/solver.h>
 #include <basilisk/scene/raycast.h>
 
@@ -21,9 +22,22 @@ class Scene2D : public VirtualScene<Node2D, glm::vec2, float, glm::vec2> {
         StaticCamera2D* internalCamera;
         std::shared_ptr<StaticCamera2D> cameraPython;
         Shader* shader;
+        RenderQueue* renderQueue;
+        UBO* cameraUBO;
         Solver* solver;
 
         bool customShader = false;
+        bool pipelined = false;
+
+        // fixed timestep, physicsRate 0 steps once per frame with the frame time
+        float physicsRate = 0.0f;
+        int maxSubsteps = 4;
+        float accumulator = 0.0f;
+
+        void publishPoses();
+        void updateNodeSync();
+
+        RayCastResult2D raycastTree(glm::vec2 origin, glm::vec2 direction);
 
     public:
         Scene2D(Engine* engin, int cellWidth=800, int cellHeight=800, float cellScale=0.2f);
@@ -32,11 +46,14 @@ class Scene2D : public VirtualScene<Node2D, glm::vec2, float, glm::vec2> {
 
         void update();
         void render();
+        void sync();
 
         void add(Node2D* node) override;
         void add(std::shared_ptr<Node2D> node) override;
         void remove(Node2D* node) override;
         void remove(std::shared_ptr<Node2D> node) override;
+        std::vector<Node2D*> spawnBatch(uint32_t count, const glm::vec2* positions, const float* rotations, const glm::vec2* scales, const glm::vec3* velocities,
+                                        Collider* collider, float density, float friction, std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material);
 
         void setCamera(StaticCamera2D* camera) { this->camera = camera; }
         void setCamera(std::shared_ptr<StaticCamera2D> cameraSp) { cameraPython = std::move(cameraSp); camera = cameraPython.get(); }
@@ -44,10 +61,18 @@ class Scene2D : public VirtualScene<Node2D, glm::vec2, float, glm::vec2> {
         inline Shader* getShader() override { return shader; }
         inline StaticCamera2D* getCamera() { return camera; }
         inline Solver* getSolver() { return solver; }
+        inline bool isPipelined() const { return pipelined; }
+        void setPipelined(bool pipelined);
+        inline float getPhysicsRate() const { return physicsRate; }
+        inline int getMaxSubsteps() const { return maxSubsteps; }
+        void setPhysicsRate(float physicsRate);
+        void setMaxSubsteps(int maxSubsteps) { this->maxSubsteps = std::max(maxSubsteps, 1); }
+        void getViewBounds(glm::vec2& min, glm::vec2& max);
 
         // raycasting
         Node2D* pick(glm::vec2 mousePosition);
         RayCastResult2D raycast(glm::vec2 origin, glm::vec2 direction);
+        std::vector<RayCastResult2D> raycast(const std::vector<glm::vec2>& origins, const std::vector<glm::vec2>& directions);
 };
 
 }
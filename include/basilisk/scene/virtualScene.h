@@ -2,9 +2,11 @@
 #define BSK_VIRTUAL_SCENE_H
 
 #include <memory>
+#include <mutex>
 #include <basilisk/render/shader.h>
 #include <basilisk/resource/resourceServer.h>
 #include <basilisk/engine/engine.h>
+#include <basilisk/util/aabbTree.h>
 
 namespace bsk::internal {
 
@@ -16,6 +18,16 @@ protected:
 
     // store references to children as shared pointers so they are not destroyed when dereferenced from Python
     std::unordered_map<NodeType*, std::shared_ptr<NodeType>> childrenPythonMap;
+
+    // Guards the node tree, the bounds and childrenPythonMap. The Python bindings run update, render and the
+    // other long calls without the GIL, so another Python thread adding or removing nodes meanwhile waits for
+    // the call to finish instead of racing it. Recursive because scene calls nest (add -> root->add -> bounds).
+    // Node properties themselves are not guarded: only the thread driving the frame loop may modify nodes.
+    mutable std::recursive_mutex graphMutex;
+
+    // world bounds of every drawable node, refreshed once per frame for nodes that moved
+    AABBTree<NodeType*, position_type> boundsTree;
+    std::vector<NodeType*> boundsQueue;
     
 public:
     VirtualScene(Engine* engine) : engine(engine) {
@@ -36,8 +48,32 @@ public:
     
     virtual Shader* getShader() = 0;
 
+    AABBTree<NodeType*, position_type>& getBoundsTree() { return boundsTree; }
+
+    /** Queue a node whose bounds changed. Returns its slot so the node can cancel it if destroyed first. */
+    int queueBoundsUpdate(NodeType* node) {
+        boundsQueue.push_back(node);
+        return static_cast<int>(boundsQueue.size()) - 1;
+    }
+    void cancelBoundsUpdate(int slot) { boundsQueue[slot] = nullptr; }
+
+    /**
+     * Refit the bounds tree for every node that moved, changed mesh or joined the scene since the last call.
+     * This is also the frame's transform pass: markModelDirty queues a moved subtree parent before child, so
+     * each dirty world model is rebuilt once here from an already resolved parent and clean nodes are skipped.
+     */
+    void updateBounds() {
+        for (size_t i = 0; i < boundsQueue.size(); i++) {
+            if (boundsQueue[i] != nullptr) {
+                boundsQueue[i]->refreshBounds();
+            }
+        }
+        boundsQueue.clear();
+    }
+
     /** Returns shared_ptr if the node was added via add(shared_ptr); otherwise nullptr. */
     std::shared_ptr<NodeType> findSharedNode(NodeType* node) const {
+        std::lock_guard<std::recursive_mutex> lock(graphMutex);
         auto it = childrenPythonMap.find(node);
         return it != childrenPythonMap.end() ? it->second : nullptr;
     }
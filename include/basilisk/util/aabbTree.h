@@ -0,0 +1,116 @@
+#ifndef BSK_AABB_TREE_H
+#define BSK_AABB_TREE_H
+
+#include <basilisk/util/includes.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief Dynamic AABB tree over items with fattened leaf bounds, stored in a flat node pool.
+ *        Vec is glm::vec2 or glm::vec3. Leaves are kept balanced with tree rotations on insert and remove.
+ *
+ * @tparam Item Payload stored in each leaf (usually a pointer)
+ * @tparam Vec Bound vector type
+ */
+template<typename Item, typename Vec>
+class AABBTree {
+private:
+    static constexpr int NULL_NODE = -1;
+
+    struct TreeNode {
+        Vec min;
+        Vec max;
+        Item item;
+        int parent;
+        int left;
+        int right;
+        int height; // leaf = 0, free = -1
+
+        bool isLeaf() const { return left == NULL_NODE; }
+    };
+
+    std::vector<TreeNode> nodes;
+    int root;
+    int freeList;
+    int leafCount;
+    float margin;
+
+    int allocateNode();
+    void freeNode(int node);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int node);
+    void refit(int node);
+
+    static float cost(const Vec& min, const Vec& max);
+
+public:
+    AABBTree(float margin = 0.1f);
+
+    int insert(Item item, const Vec& min, const Vec& max);
+    void remove(int proxy);
+    bool move(int proxy, const Vec& min, const Vec& max);
+    void clear();
+
+    Item getItem(int proxy) const { return nodes[proxy].item; }
+    const Vec& getFatMin(int proxy) const { return nodes[proxy].min; }
+    const Vec& getFatMax(int proxy) const { return nodes[proxy].max; }
+    int getSize() const { return leafCount; }
+    int getHeight() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+
+    // Calls fn(item) for every leaf whose fat bounds overlap [min, max]
+    template<typename Fn>
+    void query(const Vec& min, const Vec& max, Fn&& fn) const;
+
+    // Calls fn(item) for every leaf accepted by overlaps(min, max), which is also used to prune internal nodes
+    template<typename Overlaps, typename Fn>
+    void query(Overlaps&& overlaps, Fn&& fn) const;
+
+    // Calls fn(item, tEnter) for every leaf the ray enters before maxT. fn returns the new maxT, so closest-hit queries shrink the search.
+    template<typename Fn>
+    void rayCast(const Vec& origin, const Vec& direction, float maxT, Fn&& fn) const;
+};
+
+/**
+ * @brief Slab test of a ray against an AABB
+ *
+ * @return true if the ray enters the box between 0 and maxT, tEnter is set to the entry distance
+ */
+template<typename Vec>
+inline bool rayIntersectsAABB(const Vec& origin, const Vec& inverseDirection, const Vec& min, const Vec& max, float maxT, float& tEnter) {
+    Vec t0 = (min - origin) * inverseDirection;
+    Vec t1 = (max - origin) * inverseDirection;
+    Vec tSmall = glm::min(t0, t1);
+    Vec tLarge = glm::max(t0, t1);
+
+    float tNear = 0.0f;
+    float tFar = maxT;
+    for (glm::length_t i = 0; i < Vec::length(); i++) {
+        // NaN comes from 0 * inf when the ray lies in a slab plane, treat it as inside
+        if (tSmall[i] == tSmall[i]) tNear = std::max(tNear, tSmall[i]);
+        if (tLarge[i] == tLarge[i]) tFar = std::min(tFar, tLarge[i]);
+    }
+
+    tEnter = tNear;
+    return tNear <= tFar;
+}
+
+/**
+ * @brief Get the world space AABB of a local space AABB under an affine transform
+ *
+ */
+inline void transformAABB(const glm::mat4& transform, const glm::vec3& min, const glm::vec3& max, glm::vec3& outMin, glm::vec3& outMax) {
+    glm::vec3 center = (min + max) * 0.5f;
+    glm::vec3 extent = (max - min) * 0.5f;
+    glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+    glm::mat3 absolute = glm::mat3(glm::abs(glm::vec3(transform[0])), glm::abs(glm::vec3(transform[1])), glm::abs(glm::vec3(transform[2])));
+    glm::vec3 worldExtent = absolute * extent;
+    outMin = worldCenter - worldExtent;
+    outMax = worldCenter + worldExtent;
+}
+
+}
+
+#include <basilisk/util/aabbTree.tpp>
+
+#endif
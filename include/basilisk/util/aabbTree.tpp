@@ -0,0 +1,322 @@
+namespace bsk::internal {
+
+template<typename Item, typename Vec>
+AABBTree<Item, Vec>::AABBTree(float margin) : root(NULL_NODE), freeList(NULL_NODE), leafCount(0), margin(margin) {}
+
+/**
+ * @brief Surface area heuristic cost of a box (perimeter in 2D, surface area in 3D)
+ *
+ */
+template<typename Item, typename Vec>
+float AABBTree<Item, Vec>::cost(const Vec& min, const Vec& max) {
+    Vec d = max - min;
+    if constexpr (Vec::length() == 2) {
+        return d.x + d.y;
+    } else {
+        return d.x * d.y + d.y * d.z + d.z * d.x;
+    }
+}
+
+template<typename Item, typename Vec>
+int AABBTree<Item, Vec>::allocateNode() {
+    if (freeList == NULL_NODE) {
+        nodes.push_back({});
+        freeList = static_cast<int>(nodes.size()) - 1;
+        nodes[freeList].parent = NULL_NODE;
+    }
+
+    int node = freeList;
+    freeList = nodes[node].parent; // free nodes chain through parent
+    nodes[node].parent = NULL_NODE;
+    nodes[node].left = NULL_NODE;
+    nodes[node].right = NULL_NODE;
+    nodes[node].height = 0;
+    nodes[node].item = Item{};
+    return node;
+}
+
+template<typename Item, typename Vec>
+void AABBTree<Item, Vec>::freeNode(int node) {
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    freeList = node;
+}
+
+/**
+ * @brief Insert an item with tight bounds. The stored bounds are fattened by the margin so small moves are free.
+ *
+ * @return int Proxy id used to move or remove the item
+ */
+template<typename Item, typename Vec>
+int AABBTree<Item, Vec>::insert(Item item, const Vec& min, const Vec& max) {
+    int leaf = allocateNode();
+    nodes[leaf].min = min - Vec(margin);
+    nodes[leaf].max = max + Vec(margin);
+    nodes[leaf].item = item;
+    insertLeaf(leaf);
+    leafCount++;
+    return leaf;
+}
+
+template<typename Item, typename Vec>
+void AABBTree<Item, Vec>::remove(int proxy) {
+    removeLeaf(proxy);
+    freeNode(proxy);
+    leafCount--;
+}
+
+/**
+ * @brief Update the bounds of an item.
+ *
+ * @return true if the item left its fat bounds and was reinserted
+ */
+template<typename Item, typename Vec>
+bool AABBTree<Item, Vec>::move(int proxy, const Vec& min, const Vec& max) {
+    TreeNode& leaf = nodes[proxy];
+    if (glm::all(glm::greaterThanEqual(min, leaf.min)) && glm::all(glm::lessThanEqual(max, leaf.max))) {
+        return false;
+    }
+
+    removeLeaf(proxy);
+    nodes[proxy].min = min - Vec(margin);
+    nodes[proxy].max = max + Vec(margin);
+    insertLeaf(proxy);
+    return true;
+}
+
+template<typename Item, typename Vec>
+void AABBTree<Item, Vec>::clear() {
+    nodes.clear();
+    root = NULL_NODE;
+    freeList = NULL_NODE;
+    leafCount = 0;
+}
+
+template<typename Item, typename Vec>
+void AABBTree<Item, Vec>::insertLeaf(int leaf) {
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // Descend towards the sibling that grows the tree's total cost the least
+    Vec leafMin = nodes[leaf].min;
+    Vec leafMax = nodes[leaf].max;
+    int index = root;
+    while (!nodes[index].isLeaf()) {
+        int left = nodes[index].left;
+        int right = nodes[index].right;
+
+        float area = cost(nodes[index].min, nodes[index].max);
+        float combined = cost(glm::min(nodes[index].min, leafMin), glm::max(nodes[index].max, leafMax));
+
+        // cost of making a new parent here, and the minimum cost pushed down to the children
+        float here = 2.0f * combined;
+        float inherited = 2.0f * (combined - area);
+
+        auto descendCost = [&](int child) {
+            float enlarged = cost(glm::min(nodes[child].min, leafMin), glm::max(nodes[child].max, leafMax));
+            if (nodes[child].isLeaf()) {
+                return enlarged + inherited;
+            }
+            return enlarged - cost(nodes[child].min, nodes[child].max) + inherited;
+        };
+
+        float costLeft = descendCost(left);
+        float costRight = descendCost(right);
+        if (here < costLeft && here < costRight) {
+            break;
+        }
+        index = costLeft < costRight ? left : right;
+    }
+
+    // Make a new parent for the sibling and the leaf
+    int sibling = index;
+    int oldParent = nodes[sibling].parent;
+    int newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].min = glm::min(leafMin, nodes[sibling].min);
+    nodes[newParent].max = glm::max(leafMax, nodes[sibling].max);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].left = sibling;
+    nodes[newParent].right = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent == NULL_NODE) {
+        root = newParent;
+    } else if (nodes[oldParent].left == sibling) {
+        nodes[oldParent].left = newParent;
+    } else {
+        nodes[oldParent].right = newParent;
+    }
+
+    refit(nodes[leaf].parent);
+}
+
+template<typename Item, typename Vec>
+void AABBTree<Item, Vec>::removeLeaf(int leaf) {
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    // The sibling takes the parent's place
+    if (grandParent == NULL_NODE) {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+
+    if (nodes[grandParent].left == parent) {
+        nodes[grandParent].left = sibling;
+    } else {
+        nodes[grandParent].right = sibling;
+    }
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    refit(grandParent);
+}
+
+/**
+ * @brief Walk to the root rebalancing and recomputing bounds and heights
+ *
+ */
+template<typename Item, typename Vec>
+void AABBTree<Item, Vec>::refit(int node) {
+    while (node != NULL_NODE) {
+        node = balance(node);
+
+        int left = nodes[node].left;
+        int right = nodes[node].right;
+        nodes[node].height = 1 + std::max(nodes[left].height, nodes[right].height);
+        nodes[node].min = glm::min(nodes[left].min, nodes[right].min);
+        nodes[node].max = glm::max(nodes[left].max, nodes[right].max);
+
+        node = nodes[node].parent;
+    }
+}
+
+/**
+ * @brief Rotate the taller child up if the subtree at a is unbalanced
+ *
+ * @return int Index of the node now at a's position
+ */
+template<typename Item, typename Vec>
+int AABBTree<Item, Vec>::balance(int a) {
+    TreeNode& A = nodes[a];
+    if (A.isLeaf() || A.height < 2) {
+        return a;
+    }
+
+    int b = A.left;
+    int c = A.right;
+    int heightDifference = nodes[c].height - nodes[b].height;
+
+    // Rotate the taller child (up) into a's position, a takes the taller grandchild's sibling slot
+    auto rotateUp = [&](int up, int other) {
+        TreeNode& U = nodes[up];
+        int f = U.left;
+        int g = U.right;
+
+        U.left = a;
+        U.parent = A.parent;
+        A.parent = up;
+
+        if (U.parent == NULL_NODE) {
+            root = up;
+        } else if (nodes[U.parent].left == a) {
+            nodes[U.parent].left = up;
+        } else {
+            nodes[U.parent].right = up;
+        }
+
+        // Keep the taller grandchild under up, hand the shorter one to a
+        int keep = nodes[f].height > nodes[g].height ? f : g;
+        int give = keep == f ? g : f;
+        U.right = keep;
+        if (A.left == up) { A.left = give; } else { A.right = give; }
+        nodes[give].parent = a;
+
+        A.min = glm::min(nodes[other].min, nodes[give].min);
+        A.max = glm::max(nodes[other].max, nodes[give].max);
+        A.height = 1 + std::max(nodes[other].height, nodes[give].height);
+
+        U.min = glm::min(A.min, nodes[keep].min);
+        U.max = glm::max(A.max, nodes[keep].max);
+        U.height = 1 + std::max(A.height, nodes[keep].height);
+        return up;
+    };
+
+    if (heightDifference > 1) { return rotateUp(c, b); }
+    if (heightDifference < -1) { return rotateUp(b, c); }
+    return a;
+}
+
+template<typename Item, typename Vec>
+template<typename Fn>
+void AABBTree<Item, Vec>::query(const Vec& min, const Vec& max, Fn&& fn) const {
+    query([&](const Vec& nodeMin, const Vec& nodeMax) {
+        return glm::all(glm::lessThanEqual(nodeMin, max)) && glm::all(glm::greaterThanEqual(nodeMax, min));
+    }, std::forward<Fn>(fn));
+}
+
+template<typename Item, typename Vec>
+template<typename Overlaps, typename Fn>
+void AABBTree<Item, Vec>::query(Overlaps&& overlaps, Fn&& fn) const {
+    if (root == NULL_NODE) { return; }
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(root);
+    while (!stack.empty()) {
+        int index = stack.back();
+        stack.pop_back();
+
+        const TreeNode& node = nodes[index];
+        if (!overlaps(node.min, node.max)) { continue; }
+
+        if (node.isLeaf()) {
+            fn(node.item);
+        } else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+}
+
+template<typename Item, typename Vec>
+template<typename Fn>
+void AABBTree<Item, Vec>::rayCast(const Vec& origin, const Vec& direction, float maxT, Fn&& fn) const {
+    if (root == NULL_NODE) { return; }
+
+    Vec inverseDirection = 1.0f / direction;
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(root);
+    while (!stack.empty()) {
+        int index = stack.back();
+        stack.pop_back();
+
+        const TreeNode& node = nodes[index];
+        float tEnter;
+        if (!rayIntersectsAABB(origin, inverseDirection, node.min, node.max, maxT, tEnter)) { continue; }
+
+        if (node.isLeaf()) {
+            maxT = std::min(maxT, fn(node.item, tEnter));
+        } else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+}
+
+}
@@ -0,0 +1,49 @@
+#ifndef BSK_ARENA_H
+#define BSK_ARENA_H
+
+#include <basilisk/util/includes.h>
+#include <memory_resource>
+
+namespace bsk::internal {
+
+/**
+ * @brief Bump allocator for temporaries that all die at the same point, such as everything one physics step
+ *        builds and throws away. Use it through std::pmr containers. Deallocation does nothing, reset frees
+ *        everything at once. Allocations that do not fit spill to the heap until the next reset, which then
+ *        grows the block so the following frame fits.
+ *
+ */
+class FrameArena : public std::pmr::memory_resource {
+    private:
+        struct Spill {
+            void* pointer;
+            size_t bytes;
+            size_t alignment;
+        };
+
+        std::unique_ptr<std::byte[]> block;
+        size_t capacity;
+        size_t offset = 0;
+        std::vector<Spill> spills;
+        size_t spilledBytes = 0;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {}
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    public:
+        FrameArena(size_t capacity = 64 * 1024);
+        ~FrameArena();
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void reset();
+
+        inline size_t getCapacity() const { return capacity; }
+        inline size_t getUsed() const { return offset + spilledBytes; }
+};
+
+}
+
+#endif
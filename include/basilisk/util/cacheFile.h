@@ -0,0 +1,46 @@
+#ifndef BSK_CACHE_FILE_H
+#define BSK_CACHE_FILE_H
+
+#include <basilisk/util/includes.h>
+#include <filesystem>
+
+namespace bsk::internal {
+
+/*
+ * On disk caches (cooked meshes, program binaries) share these helpers.
+ *
+ * Files live under a per user cache directory: $XDG_CACHE_HOME or ~/.cache on Linux, ~/Library/Caches on macOS and
+ * %LOCALAPPDATA% on Windows. The basilisk directories below it are created private to the user (0700) and are not
+ * used at all if another user owns them, so nobody else can plant or read cached files.
+ *
+ * Files are written to a uniquely named temporary sibling and renamed into place, so a concurrent reader never sees a
+ * partial file and concurrent writers of the same file never interleave.
+ * Each cache stamps its files with its own version number, bump it whenever the file layout or the data that goes
+ * into it changes and files of any other version are ignored.
+ */
+
+struct CacheFilePart {
+    const void* data;
+    size_t size;
+};
+
+/**
+ * @brief Get the per user directory of one cache, creating it on first use
+ *
+ * @param name Subdirectory of the basilisk cache, e.g. "meshes"
+ * @return std::filesystem::path Empty if there is no usable cache directory, caching is then skipped
+ */
+std::filesystem::path getCacheDirectory(const std::string& name);
+
+/**
+ * @brief Atomically replace a cache file with the concatenation of parts
+ *
+ * @param path File to write, inside a directory from getCacheDirectory
+ * @param parts Byte ranges written in order
+ * @return true if the file was written
+ */
+bool writeCacheFile(const std::filesystem::path& path, std::initializer_list<CacheFilePart> parts);
+
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef BSK_HASH_H
+#define BSK_HASH_H
+
+#include <basilisk/util/includes.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief 64 bit hash of a block of memory for content addressed lookups. Consumes eight bytes per step,
+ *        so hashing pixel data stays cheap next to decoding it. Not cryptographic, compare contents on a hit
+ *        wherever they are still at hand.
+ *
+ * @param data Bytes to hash
+ * @param size Number of bytes
+ * @param seed Starting value, chain calls by passing the previous result
+ * @return uint64_t
+ */
+inline uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0x9E3779B97F4A7C15ull) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    uint64_t hash = seed ^ (size * 0xFF51AFD7ED558CCDull);
+
+    auto mix = [&hash](uint64_t word) {
+        word *= 0x87C37B91114253D5ull;
+        word = (word << 31) | (word >> 33);
+        hash ^= word * 0x4CF5AD432745937Full;
+        hash = ((hash << 27) | (hash >> 37)) * 5 + 0x52DCE729;
+    };
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        mix(word);
+    }
+    if (i < size) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + i, size - i);
+        mix(word);
+    }
+
+    // Final avalanche so nearby inputs spread over the whole range
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+}
+
+#endif
@@ -7,17 +7,20 @@
 #include <array>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <tuple>
 #include <stack>
 #include <queue>
 #include <set>
 #include <optional>
 #include <memory>
+#include <atomic>
 #include <utility>
 #include <cmath>
 #include <algorithm>
 #include <numeric>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <fstream>
 #include <sstream>
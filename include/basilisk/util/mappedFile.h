@@ -0,0 +1,38 @@
+#ifndef BSK_MAPPED_FILE_H
+#define BSK_MAPPED_FILE_H
+
+#include <basilisk/util/includes.h>
+#include <filesystem>
+#ifdef _WIN32
+    #include <windows.h>
+#endif
+
+namespace bsk::internal {
+
+/**
+ * @brief Read only memory mapping of a whole file, unmapped when it goes out of scope
+ *
+ */
+class MappedFile {
+    private:
+        const unsigned char* data = nullptr;
+        size_t size = 0;
+#ifdef _WIN32
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#endif
+
+    public:
+        MappedFile(const std::filesystem::path& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const unsigned char* getData() const { return data; }
+        size_t getSize() const { return size; }
+};
+
+}
+
+#endif
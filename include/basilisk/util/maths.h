@@ -207,25 +207,6 @@ inline bool pointInTriangle2(const glm::vec2& p, const glm::vec2& a, const glm::
 // Helper
 // ------------------------------------------------------------
 
-// Extract vertex position from flat vertex buffer (position is first 3 floats per vertex).
-inline glm::vec3 getMeshVertexPosition(const std::vector<float>& vertices,
-    const std::vector<unsigned int>& indices,
-    unsigned int vertexIndex) 
-{
-    if (vertices.empty() || indices.empty()) return glm::vec3(0.0f);
-
-    unsigned int maxIndex = 0;
-    for (unsigned int idx : indices)
-    if (idx > maxIndex) maxIndex = idx;
-
-    unsigned int numVertices = maxIndex + 1;
-    unsigned int stride = static_cast<unsigned int>(vertices.size()) / numVertices;
-    if (stride < 3) stride = 3;
-
-    unsigned int offset = vertexIndex * stride;
-    return glm::vec3(vertices[offset], vertices[offset + 1], vertices[offset + 2]);
-}
-
 inline glm::vec2 xy(const glm::vec3& v) noexcept {
     return glm::vec2(v.x, v.y);
 }
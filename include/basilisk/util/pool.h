@@ -0,0 +1,50 @@
+#ifndef BSK_POOL_H
+#define BSK_POOL_H
+
+#include <basilisk/util/includes.h>
+#include <mutex>
+
+namespace bsk::internal {
+
+/**
+ * @brief Fixed size allocator for one type. Slots are carved out of large slabs and recycled through a free list,
+ *        so creating and destroying objects every step never reaches the global heap once the pool has grown.
+ *        A pool serves every solver in the process, so the free list is guarded by a mutex. Scenes stepping
+ *        on their own threads only contend when they allocate at the same moment.
+ *
+ */
+class SlabPool {
+    private:
+        size_t slotSize;
+        size_t slotsPerSlab;
+        std::vector<std::unique_ptr<std::byte[]>> slabs;
+        void* freeList = nullptr; // each free slot starts with the pointer to the next one
+        std::mutex mutex;         // guards slabs and freeList
+
+        void grow();
+
+    public:
+        SlabPool(size_t slotSize, size_t slotsPerSlab = 256);
+        SlabPool(const SlabPool&) = delete;
+        SlabPool& operator=(const SlabPool&) = delete;
+
+        void* allocate(size_t size);
+        void deallocate(void* pointer, size_t size);
+
+        inline size_t getSlotSize() const { return slotSize; }
+        inline size_t getSlabCount() const { return slabs.size(); }
+};
+
+/**
+ * @brief Get the pool for a type. Never destroyed, objects may still be deleted during static destruction.
+ *
+ */
+template<typename T>
+SlabPool& getSlabPool() {
+    static SlabPool* pool = new SlabPool(sizeof(T));
+    return *pool;
+}
+
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef BSK_THREAD_POOL_H
+#define BSK_THREAD_POOL_H
+
+#include <basilisk/util/includes.h>
+#include <mutex>
+#include <condition_variable>
+
+namespace bsk::internal {
+
+/**
+ * @brief Fixed set of worker threads pulling jobs from one FIFO queue. Jobs start in submission order,
+ *        so a job may safely wait on the result of any job submitted before it.
+ *
+ */
+class ThreadPool {
+    private:
+        std::vector<std::thread> workers;
+        std::queue<std::function<void()>> jobs;
+        std::mutex mutex;
+        std::condition_variable available;
+        bool stopping;
+
+        void work();
+
+    public:
+        ThreadPool(unsigned int threadCount);
+        ~ThreadPool();
+
+        void submit(std::function<void()> job);
+
+        inline unsigned int getThreadCount() const { return workers.size(); }
+
+        static ThreadPool& getLoader();
+        static ThreadPool& getFrameWorkers();
+};
+
+}
+
+#endif
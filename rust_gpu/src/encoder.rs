@@ -35,6 +35,32 @@ impl GpuEncoder {
         // pass drops here, ending the compute pass
     }
 
+    /// Append a compute dispatch whose workgroup counts are read from `args` at
+    /// `byte_offset` as three consecutive u32 (x, y, z) when the GPU executes it.
+    /// Lets an earlier pass decide how much work a later one does. Does NOT submit.
+    pub fn dispatch_indirect(&mut self, shader: &ComputeShader, args: &GpuBuffer<u32>, byte_offset: u64) {
+        assert!(byte_offset % 4 == 0, "dispatch_indirect: offset must be 4-byte aligned");
+        assert!(byte_offset + 12 <= args.byte_size(), "dispatch_indirect: args out of bounds");
+        let encoder = self.encoder.as_mut().expect("dispatch after submit");
+        let mut pass = encoder.begin_compute_pass(
+            &ComputePassDescriptor {
+                label: None,
+                timestamp_writes: None,
+            }
+        );
+        pass.set_pipeline(&shader.pipeline);
+        pass.set_bind_group(0, &shader.bind_group, &[]);
+        pass.dispatch_workgroups_indirect(args.raw(), byte_offset);
+    }
+
+    /// Enqueue a zero fill of the whole buffer. Unlike a queue write this runs in
+    /// command order, so it can clear data an earlier pass in the same encoder read.
+    /// Does NOT submit.
+    pub fn clear_buffer<T: bytemuck::Pod>(&mut self, buffer: &GpuBuffer<T>) {
+        let encoder = self.encoder.as_mut().expect("clear_buffer after submit");
+        encoder.clear_buffer(buffer.raw(), 0, None);
+    }
+
     /// Enqueue a full buffer copy from a GpuBuffer into a StagingBuffer.
     /// Types must match. Does NOT submit.
     pub fn copy_to_staging<T: bytemuck::Pod>(
@@ -19,7 +19,8 @@ impl<T: bytemuck::Pod> GpuBuffer<T> {
             size,
             usage:              BufferUsages::STORAGE
                               | BufferUsages::COPY_SRC
-                              | BufferUsages::COPY_DST,
+                              | BufferUsages::COPY_DST
+                              | BufferUsages::INDIRECT,
             mapped_at_creation: false,
         });
 
@@ -152,6 +152,33 @@ pub extern "C" fn gpu_encoder_dispatch(
     enc.dispatch(shader, x, y, z);
 }
 
+/// Append a compute dispatch whose (x, y, z) workgroup counts are read from
+/// `args` at `byte_offset` on the GPU. Does NOT submit.
+#[no_mangle]
+pub extern "C" fn gpu_encoder_dispatch_indirect(
+    enc:         *mut GpuEncoder,
+    shader:      *mut ComputeShader,
+    args:        *mut GpuBuffer<u32>,
+    byte_offset: u64,
+) {
+    let enc    = unsafe { &mut *enc };
+    let shader = unsafe { &*shader };
+    let args   = unsafe { &*args };
+    enc.dispatch_indirect(shader, args, byte_offset);
+}
+
+/// Enqueue a zero fill of a buffer, ordered with the other encoded commands.
+/// Does NOT submit.
+#[no_mangle]
+pub extern "C" fn gpu_encoder_clear_buffer(
+    enc:    *mut GpuEncoder,
+    buffer: *mut GpuBuffer<u32>,
+) {
+    let enc    = unsafe { &mut *enc };
+    let buffer = unsafe { &*buffer };
+    enc.clear_buffer(buffer);
+}
+
 /// Enqueue a GPU-to-GPU buffer copy (no CPU involvement).
 /// Use this to copy cellsB -> cellsA each frame instead of pointer-swapping.
 /// Does NOT submit.
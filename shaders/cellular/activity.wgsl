@@ -0,0 +1,84 @@
+struct Uniforms {
+    width: u32,
+    height: u32,
+    is_left_frame: u32,
+    chunk_size: u32,
+    chunks_wide: u32,
+    random_seed: u32,
+    _pad0: u32,
+    _pad1: u32,
+};
+
+// Builds this tick's chunk activity on the GPU so the CPU never reads it back or rebuilds it.
+// Must match the CPU reference buildChunkActivity (chunkActivity.cpp).
+//
+//   active = dilate(chunk_active_out) | chunk_wake   -> intent pass runs here
+//   apply  = dilate(active)                          -> resolve + apply run here (covers every move destination)
+//
+// chunk_wake is already dilated on the CPU when brush writes mark it.
+// dispatch_args holds two indirect dispatches: [0..3) intent, [3..6) resolve/apply.
+// x is counted here, y and z are preset to 1 by the CPU before submit.
+// chunk_active_out and chunk_wake are cleared by the encoder after this pass.
+
+@group(0) @binding(0) var<uniform> u: Uniforms;
+@group(0) @binding(1) var<storage, read>       chunk_active_out:  array<u32>;
+@group(0) @binding(2) var<storage, read>       chunk_wake:        array<u32>;
+@group(0) @binding(3) var<storage, read_write> chunk_active:      array<u32>;
+@group(0) @binding(4) var<storage, read_write> active_chunk_list: array<u32>;
+@group(0) @binding(5) var<storage, read_write> apply_chunk_list:  array<u32>;
+@group(0) @binding(6) var<storage, read_write> dispatch_args:     array<atomic<u32>>;
+
+fn chunks_high() -> i32 {
+    return i32((u.height + u.chunk_size - 1u) / u.chunk_size);
+}
+
+fn chunk_valid(cx: i32, cy: i32) -> bool {
+    return cx >= 0 && cy >= 0 && cx < i32(u.chunks_wide) && cy < chunks_high();
+}
+
+fn chunk_idx(cx: i32, cy: i32) -> i32 {
+    return cy * i32(u.chunks_wide) + cx;
+}
+
+fn seeded(cx: i32, cy: i32) -> bool {
+    return chunk_valid(cx, cy) && chunk_active_out[chunk_idx(cx, cy)] != 0u;
+}
+
+fn is_active(cx: i32, cy: i32) -> bool {
+    if (!chunk_valid(cx, cy)) { return false; }
+    if (chunk_wake[chunk_idx(cx, cy)] != 0u) { return true; }
+    for (var dy = -1; dy <= 1; dy++) {
+        for (var dx = -1; dx <= 1; dx++) {
+            if (seeded(cx + dx, cy + dy)) { return true; }
+        }
+    }
+    return false;
+}
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) gid: vec3<u32>) {
+    let num_chunks = u.chunks_wide * u32(chunks_high());
+    if (gid.x >= num_chunks) { return; }
+
+    let ci = i32(gid.x);
+    let cx = ci % i32(u.chunks_wide);
+    let cy = ci / i32(u.chunks_wide);
+
+    let active = is_active(cx, cy);
+    var apply = active;
+    for (var dy = -1; dy <= 1; dy++) {
+        for (var dx = -1; dx <= 1; dx++) {
+            if (!apply && is_active(cx + dx, cy + dy)) { apply = true; }
+        }
+    }
+
+    chunk_active[ci] = select(0u, 1u, active);
+    if (active) {
+        let slot = atomicAdd(&dispatch_args[0], 1u);
+        active_chunk_list[slot] = gid.x;
+    }
+    if (apply) {
+        let slot = atomicAdd(&dispatch_args[3], 1u);
+        apply_chunk_list[slot] = gid.x;
+    }
+}
@@ -17,15 +17,12 @@ struct Uniforms {
 @group(0) @binding(5) var<storage, read_write> chunk_active_out: array<u32>;
 @group(0) @binding(6) var<storage, read>       chunk_intent:     array<u32>;
 @group(0) @binding(7) var<storage, read>       chunk_active:     array<u32>;
+@group(0) @binding(8) var<storage, read>       apply_chunk_list: array<u32>;
 
 fn empty() -> u32 {
     return 0x00000000u;
 }
 
-fn chunk_idx(cx: i32, cy: i32) -> i32 {
-    return cy * i32(u.chunks_wide) + cx;
-}
-
 fn set_momentum(c: u32, mom: u32) -> u32 {
     return (c & 0x3FFFFFFFu) | ((mom & 0x3u) << 30u);
 }
@@ -33,16 +30,22 @@ fn set_momentum(c: u32, mom: u32) -> u32 {
 const FIRE_BIT: u32 = 29u;
 fn on_fire(c: u32) -> u32 { return (c >> FIRE_BIT) & 1u; }
 
+// One workgroup per entry of apply_chunk_list. Chunks outside the list are not touched;
+// out_cells is seeded from cells before this pass so they keep their contents.
 @compute @workgroup_size(16, 16)
 fn main(
-    @builtin(global_invocation_id) gid:  vec3<u32>,
+    @builtin(local_invocation_id)  lid:  vec3<u32>,
     @builtin(workgroup_id)         wgid: vec3<u32>
 ) {
-    let my_chunk = chunk_idx(i32(wgid.x), i32(wgid.y));
-    let id       = i32(gid.x) + i32(gid.y) * i32(u.width);
-    let max_id   = i32(u.width * u.height);
+    let my_chunk = i32(apply_chunk_list[wgid.x]);
+    let cx = my_chunk % i32(u.chunks_wide);
+    let cy = my_chunk / i32(u.chunks_wide);
+
+    let x = cx * i32(u.chunk_size) + i32(lid.x);
+    let y = cy * i32(u.chunk_size) + i32(lid.y);
+    if (x >= i32(u.width) || y >= i32(u.height)) { return; }
 
-    if (id >= max_id) { return; }
+    let id = x + y * i32(u.width);
 
     // if we are on fire, set chunk to active
     if (on_fire(cells[id]) == 1u) {
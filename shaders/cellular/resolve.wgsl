@@ -14,6 +14,7 @@ struct Uniforms {
 @group(0) @binding(2) var<storage, read>       intent:       array<i32>;
 @group(0) @binding(3) var<storage, read_write> claim:        array<i32>;
 @group(0) @binding(4) var<storage, read>       chunk_intent: array<u32>;
+@group(0) @binding(5) var<storage, read>       apply_chunk_list: array<u32>;
 
 fn idx(x: i32, y: i32) -> i32 {
     return y * i32(u.width) + x;
@@ -33,10 +34,6 @@ fn is_empty(c: u32) -> bool {
     return material(c) == 0u;
 }
 
-fn chunk_idx(cx: i32, cy: i32) -> i32 {
-    return cy * i32(u.chunks_wide) + cx;
-}
-
 fn claims(me: i32, sx: i32, sy: i32) -> bool {
     if (!valid(sx, sy)) { return false; }
     let dest_cell = cells[me];
@@ -46,15 +43,18 @@ fn claims(me: i32, sx: i32, sy: i32) -> bool {
     return wants_move_here && wants_move_there;
 }
 
+// One workgroup per entry of apply_chunk_list (active chunks plus their neighbours)
 @compute @workgroup_size(16, 16)
 fn main(
-    @builtin(global_invocation_id) gid:  vec3<u32>,
+    @builtin(local_invocation_id)  lid:  vec3<u32>,
     @builtin(workgroup_id)         wgid: vec3<u32>
 ) {
-    let my_chunk = chunk_idx(i32(wgid.x), i32(wgid.y));
+    let my_chunk = i32(apply_chunk_list[wgid.x]);
+    let cx = my_chunk % i32(u.chunks_wide);
+    let cy = my_chunk / i32(u.chunks_wide);
 
-    let x = i32(gid.x);
-    let y = i32(gid.y);
+    let x = cx * i32(u.chunk_size) + i32(lid.x);
+    let y = cy * i32(u.chunk_size) + i32(lid.y);
 
     if (!valid(x, y)) { return; }
 
@@ -0,0 +1,7 @@
+// Written once per frame by the scene, see CameraBlock in render/uniformBlocks.h
+layout (std140) uniform uCamera {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uCameraPosition;
+    vec3 uViewDirection;
+};
@@ -1,12 +1,8 @@
 #define MAX_DIRECTIONAL_LIGHTS 5
-#define TILE_SIZE 32
 
-uniform int uDirectionalLightCount;
-uniform int uPointLightCount;
-uniform usamplerBuffer uLightTiles;
+uniform usamplerBuffer uLightClusters;
 uniform usamplerBuffer uLightIndices;
 uniform samplerBuffer uPointLights;
-uniform vec3 uAmbientLight;
 
 struct DirectionalLight {
     vec3 color;
@@ -25,13 +21,22 @@ struct AmbientLight {
     vec3 color;
 };
 
-struct Tile {
+struct Cluster {
     uint offset;
     uint count;
 };
 
-layout (std140) uniform uDirectionalLights {
+// Written once per frame by the light server, see LightBlock in render/uniformBlocks.h
+// froxel grid: x and y split the screen, z splits view depth logarithmically
+layout (std140) uniform uLights {
     DirectionalLight directionalLights[MAX_DIRECTIONAL_LIGHTS];
+    vec3 uAmbientLight;
+    int uDirectionalLightCount;
+    ivec3 uClusterGrid;
+    int uPointLightCount;
+    vec2 uScreenSize;
+    float uClusterScale;
+    float uClusterBias;
 };
 
 PointLight getPointLight(int index) {
@@ -47,18 +52,19 @@ PointLight getPointLight(int index) {
     return light;
 }
 
-Tile getTile() {
-    int tilesX = int(ceil(800.0 / float(TILE_SIZE)));
+Cluster getCluster(float viewDepth) {
+    ivec2 tileCoord = ivec2(gl_FragCoord.xy / uScreenSize * vec2(uClusterGrid.xy));
+    tileCoord = clamp(tileCoord, ivec2(0), uClusterGrid.xy - 1);
+    int slice = int(floor(log(max(viewDepth, 1e-4)) * uClusterScale + uClusterBias));
+    slice = clamp(slice, 0, uClusterGrid.z - 1);
+    int clusterIndex = (slice * uClusterGrid.y + tileCoord.y) * uClusterGrid.x + tileCoord.x;
 
-    ivec2 tileCoord = ivec2(gl_FragCoord.xy) / TILE_SIZE;
-    int tileIndex = tileCoord.y * tilesX + tileCoord.x;
+    uvec4 texelData = texelFetch(uLightClusters, clusterIndex);
 
-    uvec4 texelData = texelFetch(uLightTiles, tileIndex);
-
-    Tile tile;
-    tile.offset = texelData.x;
-    tile.count  = texelData.y;
-    return tile;
+    Cluster cluster;
+    cluster.offset = texelData.x;
+    cluster.count  = texelData.y;
+    return cluster;
 }
 
 PointLight getLightByIndex(uint linearIndex) {
@@ -1,5 +1,6 @@
 #version 330 core
 
+#include "include/camera.glsl"
 #include "include/material.glsl"
 #include "include/texture.glsl"
 #include "include/light.glsl"
@@ -11,13 +12,11 @@ in vec3 normal;
 flat in Material material;
 
 uniform sampler2D uTexture;
-uniform vec3 uCameraPosition;
-uniform vec3 uViewDirection;
 
 out vec4 fragColor;
 
 void main() {
-    Tile tile = getTile();
+    Cluster cluster = getCluster(dot(position - uCameraPosition, uViewDirection));
     vec4 textureColor = getTextureValue(material, uv);
     
     vec3 N = normalize(normal);
@@ -30,7 +29,7 @@ void main() {
     }
     
     vec3 pointLightColor = vec3(0.0, 0.0, 0.0);
-    for (uint i = tile.offset; i < tile.offset + tile.count; i++) {
+    for (uint i = cluster.offset; i < cluster.offset + cluster.count; i++) {
         PointLight pointLight = getLightByIndex(i);
         pointLightColor += calculatePointLight(pointLight, position, N, V);
     }
@@ -6,11 +6,14 @@ layout (location = 0) in vec3 vPosition;
 layout (location = 1) in vec2 vUV;
 layout (location = 2) in vec3 vNormal;
 
+// Per-instance attributes, streamed from the scene's render queue
+layout (location = 3) in vec4 iModel0;
+layout (location = 4) in vec4 iModel1;
+layout (location = 5) in vec4 iModel2;
+layout (location = 6) in vec4 iModel3;
+layout (location = 7) in float iMaterialID;
 
-uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
-uniform int uMaterialID;
+#include "include/camera.glsl"
 
 out vec3 position;
 out vec2 uv;
@@ -18,10 +21,12 @@ out vec3 normal;
 flat out Material material;
 
 void main() {
-    position = (uModel * vec4(vPosition, 1.0)).xyz;
+    mat4 model = mat4(iModel0, iModel1, iModel2, iModel3);
+
+    position = (model * vec4(vPosition, 1.0)).xyz;
     uv = vUV;
-    normal = (uModel * vec4(vNormal, 0.0)).xyz;
-    material = getMaterial(uMaterialID);
+    normal = (model * vec4(vNormal, 0.0)).xyz;
+    material = getMaterial(int(iMaterialID + 0.5));
 
-    gl_Position = uProjection * uView * uModel * vec4(vPosition, 1.0);
+    gl_Position = uProjection * uView * vec4(position, 1.0);
 }
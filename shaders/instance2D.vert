@@ -3,18 +3,24 @@
 layout (location = 0) in vec3 vPosition;
 layout (location = 1) in vec2 vUV;
 
+// Per-instance attributes, streamed from the scene's render queue
+layout (location = 2) in vec4 iModel0;
+layout (location = 3) in vec4 iModel1;
+layout (location = 4) in vec4 iModel2;
+layout (location = 5) in vec4 iModel3;
+layout (location = 6) in float iMaterialID;
+
 #include "include/material.glsl"
 
-uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
-uniform int uMaterialID;
+#include "include/camera.glsl"
 
 out vec2 uv;
 flat out Material material;
 
 void main() {
+    mat4 model = mat4(iModel0, iModel1, iModel2, iModel3);
+
     uv = vUV;
-    material = getMaterial(uMaterialID);
-    gl_Position = uProjection * uView * uModel * vec4(vPosition, 1.0);
+    material = getMaterial(int(iMaterialID + 0.5));
+    gl_Position = uProjection * uView * model * vec4(vPosition, 1.0);
 }
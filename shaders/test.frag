@@ -17,7 +17,7 @@ uniform vec3 uViewDirection;
 out vec4 fragColor;
 
 void main() {
-    Tile tile = getTile();
+    Cluster cluster = getCluster(dot(position - uCameraPosition, uViewDirection));
     vec4 textureColor = getTextureValue(material, uv);
     
     vec3 N = normalize(normal);
@@ -30,7 +30,7 @@ void main() {
     }
     
     vec3 pointLightColor = vec3(0.0, 0.0, 0.0);
-    for (uint i = tile.offset; i < tile.offset + tile.count; i++) {
+    for (uint i = cluster.offset; i < cluster.offset + cluster.count; i++) {
         PointLight pointLight = getLightByIndex(i);
         pointLightColor += calculatePointLight(pointLight, position, N, V);
     }
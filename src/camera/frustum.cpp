@@ -0,0 +1,46 @@
+#include <basilisk/camera/frustum.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief Extract the clip planes from a view projection matrix (Gribb-Hartmann)
+ * 
+ * @param viewProjection projection * view
+ */
+Frustum::Frustum(const glm::mat4& viewProjection) {
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; i++) {
+        rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    }
+
+    planes[0] = rows[3] + rows[0]; // left
+    planes[1] = rows[3] - rows[0]; // right
+    planes[2] = rows[3] + rows[1]; // bottom
+    planes[3] = rows[3] - rows[1]; // top
+    planes[4] = rows[3] + rows[2]; // near
+    planes[5] = rows[3] - rows[2]; // far
+}
+
+/**
+ * @brief Conservative AABB test. Only rejects boxes fully behind one of the planes. 
+ * 
+ * @param min World space minimum
+ * @param max World space maximum
+ * @return true if the box may be visible
+ */
+bool Frustum::intersects(const glm::vec3& min, const glm::vec3& max) const {
+    for (const glm::vec4& plane : planes) {
+        // corner furthest along the plane normal
+        glm::vec3 positive(
+            plane.x >= 0.0f ? max.x : min.x,
+            plane.y >= 0.0f ? max.y : min.y,
+            plane.z >= 0.0f ? max.z : min.z
+        );
+        if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
@@ -64,6 +64,20 @@ void StaticCamera::use(Shader* shader) {
     shader->setUniform("uViewDirection", forward);
 }
 
+/**
+ * @brief Get the camera state for the uCamera uniform block
+ * 
+ * @return CameraBlock 
+ */
+CameraBlock StaticCamera::getCameraBlock() {
+    CameraBlock block {};
+    block.view = view;
+    block.projection = projection;
+    block.position = position;
+    block.viewDirection = forward;
+    return block;
+}
+
 /**
  * @brief Look at a target and update the pitch and yaw
  *  
@@ -107,7 +107,7 @@ bsk::Mesh* meshFromCCWPolygon(const std::vector<glm::vec2>& ccwVerts) {
     return meshFromCCWPolygon(std::span<const glm::vec2>(ccwVerts.data(), ccwVerts.size()));
 }
 
-// Node2D::updateModel translates by (position.x, -position.y). World XY from getModel()*vertex uses
+// Node2D::getLocalModel translates by (position.x, -position.y). World XY from getModel()*vertex uses
 // that convention; stored position must undo the Y sign for a given world point.
 glm::vec2 worldXYToNode2DStore(glm::vec2 worldXY) {
     return glm::vec2(worldXY.x, -worldXY.y);
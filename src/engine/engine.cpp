@@ -41,6 +41,9 @@ void Engine::update() {
     frame->use();
     frame->clear();
 
+    // Stream in textures that finished loading in the background
+    resourceServer->update();
+
     // Input Updates
     keyboard->update();
     mouse->update();
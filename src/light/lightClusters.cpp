@@ -0,0 +1,263 @@
+#include <basilisk/light/lightClusters.h>
+#include <basilisk/util/threadPool.h>
+#include <latch>
+
+namespace bsk::internal {
+
+// Below this many lights the binning runs on the calling thread
+static constexpr unsigned int MIN_LIGHTS_PER_THREAD = 64;
+
+/**
+ * @brief Squared distance from a point to an AABB, zero inside
+ *
+ */
+static float distanceSquaredToAABB(const glm::vec3& point, const glm::vec3& min, const glm::vec3& max) {
+    glm::vec3 closest = glm::clamp(point, min, max);
+    glm::vec3 delta = point - closest;
+    return glm::dot(delta, delta);
+}
+
+/**
+ * @brief Construct a new Light Clusters object. The grid is unusable until a projection is set.
+ *
+ * @param clustersX Clusters across the screen
+ * @param clustersY Clusters up the screen
+ * @param slices Depth slices between the near and far plane
+ */
+LightClusters::LightClusters(unsigned int clustersX, unsigned int clustersY, unsigned int slices):
+    clustersX(clustersX), clustersY(clustersY), slices(slices), projection(0.0f), near(0.0f), far(0.0f), sliceScale(0.0f), sliceBias(0.0f) {
+    unsigned int clusterCount = getClusterCount();
+    clusterMin.resize(clusterCount);
+    clusterMax.resize(clusterCount);
+    infos.resize(clusterCount, { 0, 0, 0, 0 });
+}
+
+/**
+ * @brief Rebuild the view space bounds of every cluster. Does nothing if the projection has not changed.
+ *
+ * @param projection Perspective projection of the camera
+ * @param near Near plane distance
+ * @param far Far plane distance
+ */
+void LightClusters::setProjection(const glm::mat4& projection, float near, float far) {
+    if (projection == this->projection && near == this->near && far == this->far) { return; }
+
+    this->projection = projection;
+    this->near = near;
+    this->far = far;
+
+    // slice = log(depth) * scale + bias, so slices are thin near the camera and thick far away
+    float logRatio = std::log(far / near);
+    sliceScale = slices / logRatio;
+    sliceBias = -(float)slices * std::log(near) / logRatio;
+
+    glm::mat4 inverseProjection = glm::inverse(projection);
+    for (unsigned int y = 0; y < clustersY; y++) {
+        for (unsigned int x = 0; x < clustersX; x++) {
+            // Corners of the tile on the near plane. Every point along their rays scales linearly with depth.
+            float ndcX0 = 2.0f * x / clustersX - 1.0f;
+            float ndcX1 = 2.0f * (x + 1) / clustersX - 1.0f;
+            float ndcY0 = 2.0f * y / clustersY - 1.0f;
+            float ndcY1 = 2.0f * (y + 1) / clustersY - 1.0f;
+            glm::vec2 ndcCorners[4] = { { ndcX0, ndcY0 }, { ndcX1, ndcY0 }, { ndcX0, ndcY1 }, { ndcX1, ndcY1 } };
+
+            glm::vec3 nearCorners[4];
+            for (int i = 0; i < 4; i++) {
+                glm::vec4 corner = inverseProjection * glm::vec4(ndcCorners[i], -1.0f, 1.0f);
+                nearCorners[i] = glm::vec3(corner) / corner.w;
+            }
+
+            for (unsigned int slice = 0; slice < slices; slice++) {
+                float depth0 = near * std::pow(far / near, (float)slice / slices);
+                float depth1 = near * std::pow(far / near, (float)(slice + 1) / slices);
+
+                glm::vec3 min(std::numeric_limits<float>::max());
+                glm::vec3 max(std::numeric_limits<float>::lowest());
+                for (int i = 0; i < 4; i++) {
+                    glm::vec3 a = nearCorners[i] * (depth0 / near);
+                    glm::vec3 b = nearCorners[i] * (depth1 / near);
+                    min = glm::min(min, glm::min(a, b));
+                    max = glm::max(max, glm::max(a, b));
+                }
+
+                unsigned int cluster = (slice * clustersY + y) * clustersX + x;
+                clusterMin[cluster] = min;
+                clusterMax[cluster] = max;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Get the depth slice containing a view depth, clamped to the grid
+ *
+ */
+unsigned int LightClusters::getSlice(float depth) const {
+    if (depth <= near) { return 0; }
+    float slice = std::floor(std::log(depth) * sliceScale + sliceBias);
+    return (unsigned int)glm::clamp(slice, 0.0f, (float)(slices - 1));
+}
+
+/**
+ * @brief Get the conservative range of clusters a light sphere can touch
+ *
+ * @param light View space position and radius
+ * @param range Output cluster range
+ * @return true if the light touches the view volume at all
+ */
+bool LightClusters::getLightRange(const glm::vec4& light, LightRange& range) const {
+    glm::vec3 center = glm::vec3(light);
+    float radius = light.w;
+
+    // view space looks down -z
+    float depthMin = -center.z - radius;
+    float depthMax = -center.z + radius;
+    if (depthMax < near || depthMin > far) { return false; }
+
+    range.minSlice = getSlice(depthMin);
+    range.maxSlice = getSlice(depthMax);
+
+    // Spheres crossing the near plane project unboundedly, give them the full screen
+    if (depthMin <= near) {
+        range.minX = 0;
+        range.maxX = clustersX - 1;
+        range.minY = 0;
+        range.maxY = clustersY - 1;
+        return true;
+    }
+
+    // Screen bounds of the projected corners of the sphere's box
+    glm::vec2 ndcMin(std::numeric_limits<float>::max());
+    glm::vec2 ndcMax(std::numeric_limits<float>::lowest());
+    for (int i = 0; i < 8; i++) {
+        glm::vec3 corner = center + radius * glm::vec3(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f);
+        glm::vec4 clip = projection * glm::vec4(corner, 1.0f);
+        glm::vec2 ndc = glm::vec2(clip) / clip.w;
+        ndcMin = glm::min(ndcMin, ndc);
+        ndcMax = glm::max(ndcMax, ndc);
+    }
+    if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f) { return false; }
+
+    auto toCluster = [](float ndc, unsigned int count) {
+        float cluster = std::floor((ndc * 0.5f + 0.5f) * count);
+        return (unsigned int)glm::clamp(cluster, 0.0f, (float)(count - 1));
+    };
+    range.minX = toCluster(ndcMin.x, clustersX);
+    range.maxX = toCluster(ndcMax.x, clustersX);
+    range.minY = toCluster(ndcMin.y, clustersY);
+    range.maxY = toCluster(ndcMax.y, clustersY);
+    return true;
+}
+
+/**
+ * @brief Bin lights into the clusters [first, last). Writes the infos of those clusters with offsets into out.
+ *        Each call owns its cluster range, so calls on disjoint ranges can run concurrently.
+ *
+ */
+void LightClusters::binClusters(const std::vector<glm::vec4>& lights, unsigned int first, unsigned int last, std::vector<uint32_t>& out) {
+    unsigned int sliceSize = clustersX * clustersY;
+    unsigned int firstSlice = first / sliceSize;
+    unsigned int lastSlice = (last - 1) / sliceSize;
+
+    // (cluster, light) pairs in light order
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (unsigned int cluster = first; cluster < last; cluster++) {
+        infos[cluster] = { 0, 0, 0, 0 };
+    }
+
+    for (unsigned int i = 0; i < lights.size(); i++) {
+        if (!rangeValid[i]) { continue; }
+        const LightRange& range = ranges[i];
+        unsigned int minSlice = std::max(range.minSlice, firstSlice);
+        unsigned int maxSlice = std::min(range.maxSlice, lastSlice);
+        if (minSlice > maxSlice) { continue; }
+
+        glm::vec3 center = glm::vec3(lights[i]);
+        float radiusSquared = lights[i].w * lights[i].w;
+        for (unsigned int slice = minSlice; slice <= maxSlice; slice++) {
+            for (unsigned int y = range.minY; y <= range.maxY; y++) {
+                for (unsigned int x = range.minX; x <= range.maxX; x++) {
+                    unsigned int cluster = (slice * clustersY + y) * clustersX + x;
+                    if (cluster < first || cluster >= last) { continue; }
+                    if (distanceSquaredToAABB(center, clusterMin[cluster], clusterMax[cluster]) > radiusSquared) { continue; }
+
+                    pairs.push_back({ cluster, i });
+                    infos[cluster].count++;
+                }
+            }
+        }
+    }
+
+    // Counting sort the pairs by cluster, keeping light order within each cluster
+    uint32_t offset = 0;
+    for (unsigned int cluster = first; cluster < last; cluster++) {
+        infos[cluster].offset = offset;
+        offset += infos[cluster].count;
+    }
+
+    out.resize(pairs.size());
+    std::vector<uint32_t> cursor(last - first);
+    for (unsigned int cluster = first; cluster < last; cluster++) {
+        cursor[cluster - first] = infos[cluster].offset;
+    }
+    for (const auto& [cluster, light] : pairs) {
+        out[cursor[cluster - first]++] = light;
+    }
+}
+
+/**
+ * @brief Assign lights to every cluster they overlap. Only the clusters inside a light's projected range are tested.
+ *        The grid is split into contiguous bands of clusters that are binned in parallel on the frame workers
+ *        and then concatenated.
+ *
+ * @param lights View space position (xyz) and radius (w) of each light
+ * @param threadCount Maximum number of threads to bin with
+ */
+void LightClusters::bin(const std::vector<glm::vec4>& lights, unsigned int threadCount) {
+    ranges.resize(lights.size());
+    rangeValid.resize(lights.size());
+    for (unsigned int i = 0; i < lights.size(); i++) {
+        rangeValid[i] = getLightRange(lights[i], ranges[i]);
+    }
+
+    unsigned int clusterCount = getClusterCount();
+    unsigned int bands = std::max(1u, std::min(threadCount, (unsigned int)lights.size() / MIN_LIGHTS_PER_THREAD));
+    bands = std::min(bands, clusterCount);
+
+    std::vector<std::vector<uint32_t>> bandIndices(bands);
+    std::vector<unsigned int> bandStart(bands + 1);
+    for (unsigned int band = 0; band <= bands; band++) {
+        bandStart[band] = (unsigned int)((uint64_t)clusterCount * band / bands);
+    }
+
+    if (bands == 1) {
+        binClusters(lights, 0, clusterCount, bandIndices[0]);
+    }
+    else {
+        std::latch done(bands - 1);
+        ThreadPool& workers = ThreadPool::getFrameWorkers();
+        for (unsigned int band = 1; band < bands; band++) {
+            workers.submit([&, band]() {
+                binClusters(lights, bandStart[band], bandStart[band + 1], bandIndices[band]);
+                done.count_down();
+            });
+        }
+        binClusters(lights, bandStart[0], bandStart[1], bandIndices[0]);
+        done.wait();
+    }
+
+    // Concatenate the bands into one compact list
+    indices.clear();
+    for (unsigned int band = 0; band < bands; band++) {
+        uint32_t base = (uint32_t)indices.size();
+        for (unsigned int cluster = bandStart[band]; cluster < bandStart[band + 1]; cluster++) {
+            infos[cluster].offset += base;
+        }
+        indices.insert(indices.end(), bandIndices[band].begin(), bandIndices[band].end());
+    }
+
+    // Pad to whole groups of four so the list fills complete RGBA texels
+    indices.resize(std::max<size_t>(4, (indices.size() + 3) / 4 * 4), 0);
+}
+
+}
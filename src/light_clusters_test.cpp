@@ -0,0 +1,66 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <basilisk/light/lightClusters.h>
+
+// Bins a seeded field of point lights without a window or GL context. Checks the threaded
+// binning matches a single thread and reports how long a bin takes at a few light counts.
+
+using namespace bsk::internal;
+
+static std::vector<glm::vec4> makeLights(unsigned int count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> spread(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> depth(-100.0f, 0.0f);
+    std::uniform_real_distribution<float> radius(0.5f, 8.0f);
+
+    std::vector<glm::vec4> lights(count);
+    for (glm::vec4& light : lights) {
+        light = glm::vec4(spread(rng), spread(rng), depth(rng), radius(rng));
+    }
+    return lights;
+}
+
+int main() {
+    const float near = 0.1f;
+    const float far = 100.0f;
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, near, far);
+    const int repeats = 50;
+
+    LightClusters single;
+    LightClusters threaded;
+    single.setProjection(projection, near, far);
+    threaded.setProjection(projection, near, far);
+
+    int failures = 0;
+    for (unsigned int count : { 16u, 256u, 1024u, 4096u }) {
+        std::vector<glm::vec4> lights = makeLights(count, count);
+
+        single.bin(lights, 1);
+        threaded.bin(lights);
+
+        bool infosMatch = true;
+        for (unsigned int cluster = 0; cluster < single.getClusterCount(); cluster++) {
+            const ClusterInfo& a = single.getInfos()[cluster];
+            const ClusterInfo& b = threaded.getInfos()[cluster];
+            infosMatch = infosMatch && a.offset == b.offset && a.count == b.count;
+        }
+        if (!infosMatch || single.getIndices() != threaded.getIndices()) {
+            std::cout << count << " lights: threaded binning differs from a single thread" << std::endl;
+            failures++;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeats; i++) {
+            threaded.bin(lights);
+        }
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeats;
+        std::cout << count << " lights: " << elapsed << " us per bin, " << threaded.getIndices().size() << " indices" << std::endl;
+    }
+
+    if (failures > 0) {
+        std::cout << failures << " light counts failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
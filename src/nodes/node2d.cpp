@@ -4,22 +4,6 @@
 
 namespace {
 
-// Extract vertex position from flat vertex buffer (position is first 3 floats per vertex).
-glm::vec3 meshVertexPosition(const std::vector<float>& vertices,
-                             const std::vector<unsigned int>& indices,
-                             unsigned int vertexIndex) {
-    if (vertices.empty() || indices.empty())
-        return glm::vec3(0.0f);
-    unsigned int maxIndex = 0;
-    for (unsigned int idx : indices)
-        if (idx > maxIndex) maxIndex = idx;
-    unsigned int numVertices = maxIndex + 1;
-    unsigned int stride = static_cast<unsigned int>(vertices.size()) / numVertices;
-    if (stride < 3) stride = 3;
-    unsigned int offset = vertexIndex * stride;
-    return glm::vec3(vertices[offset], vertices[offset + 1], vertices[offset + 2]);
-}
-
 // Ray (origin + t*direction, t>=0) vs segment (a,b). Returns true if hit; t and hitPoint are set.
 bool raySegmentIntersect2(const glm::vec2& origin, const glm::vec2& direction,
                           const glm::vec2& a, const glm::vec2& b,
@@ -43,14 +27,21 @@ namespace bsk::internal {
 
 Node2D::Node2D(Scene2D* scene, Mesh* mesh, Material* material, glm::vec2 position, float rotation, glm::vec2 scale, glm::vec3 velocity, Collider* collider, float density, float friction)
     : VirtualNode(scene, mesh ? mesh : Engine::getResourceServer()->defaultQuad, material ? material : Engine::getResourceServer()->defaultMaterial, position, rotation, scale), rigid(nullptr) {
-    updateModel();
     bindRigid(mesh, material, position, rotation, scale, velocity, collider, density, friction);
     Engine::getResourceServer()->getMaterialServer()->add(getMaterial());
 }
 
+/**
+ * @brief Construct a node sharing ownership of its mesh and material, as spawnBatch does for every node of a batch
+ *
+ */
+Node2D::Node2D(Scene2D* scene, std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material, glm::vec2 position, float rotation, glm::vec2 scale, glm::vec3 velocity, Collider* collider, float density, float friction)
+    : Node2D(scene, mesh.get(), material.get(), position, rotation, scale, velocity, collider, density, friction) {
+    holdShared(std::move(mesh), std::move(material));
+}
+
 Node2D::Node2D(Node2D* parent, Mesh* mesh, Material* material, glm::vec2 position, float rotation, glm::vec2 scale, glm::vec3 velocity, Collider* collider, float density, float friction)
     : VirtualNode(parent, mesh ? mesh : Engine::getResourceServer()->defaultQuad, material ? material : Engine::getResourceServer()->defaultMaterial, position, rotation, scale), rigid(nullptr) {
-    updateModel();
     bindRigid(mesh, material, position, rotation, scale, velocity, collider, density, friction);
     Engine::getResourceServer()->getMaterialServer()->add(getMaterial());
 }
@@ -58,11 +49,11 @@ Node2D::Node2D(Node2D* parent, Mesh* mesh, Material* material, glm::vec2 positio
 Node2D::Node2D(VirtualScene2D* scene) : VirtualNode(scene), rigid(nullptr) {
     // Root node needs identity model so child hierarchy composition is valid.
     model = glm::mat4(1.0f);
+    modelDirty = false;
 }
 
 Node2D::Node2D(Mesh* mesh, Material* material, glm::vec2 position, float rotation, glm::vec2 scale, glm::vec3 velocity, Collider* collider, float density, float friction)
     : VirtualNode(mesh ? mesh : Engine::getResourceServer()->defaultQuad, material ? material : Engine::getResourceServer()->defaultMaterial, position, rotation, scale), rigid(nullptr) {
-    updateModel();
     Engine::getResourceServer()->getMaterialServer()->add(getMaterial());
 
     // save data here so that we can adopt it when the node is adopted
@@ -133,48 +124,67 @@ Node2D& Node2D::operator=(Node2D&& other) noexcept {
 }
 
 /**
- * @brief Helper to update the model matrix when node is updated. 
+ * @brief Get the model matrix of this node relative to its parent
  * 
+ * @return glm::mat4 
  */
-void Node2D::updateModel() {
-    model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(position.x, -position.y, layer));
-    model = glm::rotate(model, -rotation, glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::scale(model, glm::vec3(scale, 1.0f));
-
-    // Compose with parent transform so child nodes inherit hierarchy transforms.
-    if (parent) {
-        model = parent->getModel() * model;
-    }
-
-    for (auto child : children) {
-        child->updateModel();
-    }
+glm::mat4 Node2D::getLocalModel() const {
+    glm::mat4 local = glm::mat4(1.0f);
+    local = glm::translate(local, glm::vec3(position.x, -position.y, layer));
+    local = glm::rotate(local, -rotation, glm::vec3(0.0f, 0.0f, 1.0f));
+    local = glm::scale(local, glm::vec3(scale, 1.0f));
+    return local;
 }
 
 void Node2D::setPosition(glm::vec2 position) {
-    if (this->rigid) this->rigid->setPosition({position.x, position.y, this->rotation});
+    if (this->rigid) teleportRigid({position.x, position.y, this->rigid->getPosition().z});
     this->position = position;
-    updateModel();
+    markModelDirty();
 }
 
 void Node2D::setPosition(glm::vec3 position) {
-    if (this->rigid) this->rigid->setPosition(position);
+    if (this->rigid) teleportRigid(position);
     this->position = {position.x , position.y};
     this->rotation = position.z;
-    updateModel();
+    markModelDirty();
+}
+
+/**
+ * @brief Move the node without moving its rigid body, used to draw poses interpolated between physics steps
+ *
+ * @param pose x, y and rotation
+ */
+void Node2D::setRenderPose(const glm::vec3& pose) {
+    if (this->position == glm::vec2(pose.x, pose.y) && this->rotation == pose.z) return;
+    this->position = {pose.x, pose.y};
+    this->rotation = pose.z;
+    markModelDirty();
 }
 
 void Node2D::setRotation(float rotation) {
-    if (this->rigid) this->rigid->setPosition({this->position.x, this->position.y, rotation});
+    if (this->rigid) {
+        glm::vec3 pose = this->rigid->getPosition();
+        teleportRigid({pose.x, pose.y, rotation});
+    }
     this->rotation = rotation;
-    updateModel();
+    markModelDirty();
+}
+
+/**
+ * @brief Move the rigid body without carrying the jump into the next interpolated frame. The node's own pose may be
+ *        an interpolated one, so callers take the components they keep from the body.
+ *
+ * @param pose x, y and rotation
+ */
+void Node2D::teleportRigid(const glm::vec3& pose) {
+    this->rigid->setPosition(pose);
+    this->rigid->setInitial(pose);
 }
 
 void Node2D::setScale(glm::vec2 scale) {
     if (this->rigid) this->rigid->setScale(glm::abs(scale));
     this->scale = scale;
-    updateModel();
+    markModelDirty();
 }
 
 void Node2D::setResolvesCollisions(bool resolvesCollisions) {
@@ -406,7 +416,6 @@ bool Node2D::pointIsInside(glm::vec2 position) {
     Mesh* m = getMesh();
     if (!m) return false;
 
-    const auto& vertices = m->getVertices();
     const auto& indices = m->getIndices();
     if (indices.size() < 3) return false;
 
@@ -415,9 +424,9 @@ bool Node2D::pointIsInside(glm::vec2 position) {
     glm::vec2 modelPoint(modelPos.x, -modelPos.y);
 
     for (size_t i = 0; i + 2 < indices.size(); i += 3) {
-        glm::vec3 v0 = meshVertexPosition(vertices, indices, indices[i]);
-        glm::vec3 v1 = meshVertexPosition(vertices, indices, indices[i + 1]);
-        glm::vec3 v2 = meshVertexPosition(vertices, indices, indices[i + 2]);
+        glm::vec3 v0 = m->getPosition(indices[i]);
+        glm::vec3 v1 = m->getPosition(indices[i + 1]);
+        glm::vec3 v2 = m->getPosition(indices[i + 2]);
 
         glm::vec2 a(v0.x, v0.y);
         glm::vec2 b(v1.x, v1.y);
@@ -435,7 +444,6 @@ RayCastResult2D Node2D::raycast(glm::vec2 origin, glm::vec2 direction) {
     Mesh* m = getMesh();
     if (!m) return result;
 
-    const auto& vertices = m->getVertices();
     const auto& indices = m->getIndices();
     if (indices.size() < 3) return result;
 
@@ -452,9 +460,9 @@ RayCastResult2D Node2D::raycast(glm::vec2 origin, glm::vec2 direction) {
     float closestT = result.distance;
 
     for (size_t i = 0; i + 2 < indices.size(); i += 3) {
-        glm::vec2 a = xy(meshVertexPosition(vertices, indices, indices[i]));
-        glm::vec2 b = xy(meshVertexPosition(vertices, indices, indices[i + 1]));
-        glm::vec2 c = xy(meshVertexPosition(vertices, indices, indices[i + 2]));
+        glm::vec2 a = xy(m->getPosition(indices[i]));
+        glm::vec2 b = xy(m->getPosition(indices[i + 1]));
+        glm::vec2 c = xy(m->getPosition(indices[i + 2]));
 
         glm::vec2 edges[3][2] = {{a, b}, {b, c}, {c, a}};
         for (int e = 0; e < 3; ++e) {
@@ -1,4 +1,6 @@
 #include <basilisk/physics/cellular/cellBuffer.h>
+#include <basilisk/physics/cellular/cellFile.h>
+#include <basilisk/physics/cellular/chunkActivity.h>
 #include <basilisk/compute/gpuWrapper.hpp>
 #include <basilisk/util/resolvePath.h>
 #include <iostream>
@@ -25,9 +27,11 @@ CellBuffer::CellBuffer(int width, int height, float cellScale)
       chunksHigh((height + CHUNK_SIZE - 1) / CHUNK_SIZE),
       numChunks (((width  + CHUNK_SIZE - 1) / CHUNK_SIZE) *
                  ((height + CHUNK_SIZE - 1) / CHUNK_SIZE)),
-      chunkActive   (numChunks, 1u),  // start fully active so frame 0 runs everywhere
-      chunkActiveOut(numChunks, 0u)
-{}
+      chunkActive   (numChunks, 0u),
+      chunkActiveOut(numChunks, 1u)   // seed every chunk so frame 0 runs everywhere
+{
+    pendingChunkMask.assign(static_cast<size_t>(numChunks), 0u);
+}
 
 CellBuffer::~CellBuffer() {
     if (initialized) {
@@ -43,10 +47,16 @@ CellBuffer::~CellBuffer() {
         delete claim;
         delete gpuChunkActive;
         delete gpuActiveChunkList;
+        delete gpuApplyChunkList;
+        delete gpuChunkWake;
+        delete gpuChunkDispatchArgs;
         delete gpuChunkIntent;
         delete gpuChunkActiveOut;
         delete cellsStaging;
         delete chunkStaging;
+        delete applyListStaging;
+        delete applyArgsStaging;
+        delete activityShader;
         delete intentShader;
         delete resolveShader;
         delete applyShader;
@@ -91,6 +101,7 @@ void CellBuffer::initializeCompute() {
     const size_t cellCount  = width * height;
     gpuCellScratch.resize(cellCount);
     gpuRenderScratch.resize(cellCount);
+    pendingCells.resize(cellCount);
 
     // Storage buffers
     cellsA             = new GpuBufferU32(cellCount);
@@ -99,8 +110,12 @@ void CellBuffer::initializeCompute() {
     claim              = new GpuBufferU32(cellCount);
     gpuChunkActive     = new GpuBufferU32(numChunks);
     gpuActiveChunkList = new GpuBufferU32(numChunks);
+    gpuApplyChunkList  = new GpuBufferU32(numChunks);
+    gpuChunkWake       = new GpuBufferU32(numChunks);
+    gpuChunkDispatchArgs = new GpuBufferU32(6);
     gpuChunkIntent     = new GpuBufferU32(numChunks);
     gpuChunkActiveOut  = new GpuBufferU32(numChunks);
+    gpuChunkActiveOut->write(chunkActiveOut); // both activity paths start from the all-active seed
 
     // particles
     particlesA = new GpuBuffer<Particle>(MAX_PARTICLES);
@@ -130,6 +145,8 @@ void CellBuffer::initializeCompute() {
     // Staging buffers — sized to match what they'll receive
     cellsStaging = new StagingBufferU32(cellCount);
     chunkStaging = new StagingBufferU32(numChunks);
+    applyListStaging = new StagingBufferU32(numChunks);
+    applyArgsStaging = new StagingBufferU32(6);
 
     struct SimUniforms {
         uint32_t width;
@@ -143,10 +160,18 @@ void CellBuffer::initializeCompute() {
     const size_t uSize = sizeof(SimUniforms);
 
     // Binding layouts must match the WGSL shaders exactly (storage order in ctor order → @1..):
+    //   activity: @0=uniform  @1=chunk_active_out  @2=chunk_wake  @3=chunk_active
+    //             @4=active_chunk_list  @5=apply_chunk_list  @6=dispatch_args
     //   intent:  @0=uniform  @1=cells  @2=intent  @3=active_chunk_list  @4=chunk_intent
-    //   resolve: @0=uniform  @1=cells  @2=intent  @3=claim   @4=chunk_intent
+    //   resolve: @0=uniform  @1=cells  @2=intent  @3=claim   @4=chunk_intent  @5=apply_chunk_list
     //   apply:   @0=uniform  @1=cells  @2=intent  @3=claim  @4=out_cells
-    //            @5=chunk_active_out  @6=chunk_intent  @7=chunk_active
+    //            @5=chunk_active_out  @6=chunk_intent  @7=chunk_active  @8=apply_chunk_list
+    activityShader = new ComputeShader(
+        loadShaderSource("shaders/cellular/activity.wgsl"),
+        { gpuChunkActiveOut->handle(), gpuChunkWake->handle(), gpuChunkActive->handle(),
+          gpuActiveChunkList->handle(), gpuApplyChunkList->handle(), gpuChunkDispatchArgs->handle() },
+        uSize
+    );
     intentShader = new ComputeShader(
         loadShaderSource("shaders/cellular/intent.wgsl"),
         { cellsA->handle(), intent->handle(),
@@ -155,13 +180,15 @@ void CellBuffer::initializeCompute() {
     );
     resolveShader = new ComputeShader(
         loadShaderSource("shaders/cellular/resolve.wgsl"),
-        { cellsA->handle(), intent->handle(), claim->handle(), gpuChunkIntent->handle() },
+        { cellsA->handle(), intent->handle(), claim->handle(), gpuChunkIntent->handle(),
+          gpuApplyChunkList->handle() },
         uSize
     );
     applyShader = new ComputeShader(
         loadShaderSource("shaders/cellular/apply.wgsl"),
         { cellsA->handle(), intent->handle(), claim->handle(), cellsB->handle(),
-          gpuChunkActiveOut->handle(), gpuChunkIntent->handle(), gpuChunkActive->handle() },
+          gpuChunkActiveOut->handle(), gpuChunkIntent->handle(), gpuChunkActive->handle(),
+          gpuApplyChunkList->handle() },
         uSize
     );
     struct ParticleUniforms {
@@ -194,28 +221,131 @@ void CellBuffer::initializeCompute() {
 // Chunk dirty tracking
 // ---------------------------------------------------------------------------
 
-void CellBuffer::markChunkAndNeighborsDirty(int cx, int cy) {
-    for (int dy = -1; dy <= 1; ++dy) {
-        for (int dx = -1; dx <= 1; ++dx) {
-            int nx = cx + dx, ny = cy + dy;
-            if (nx >= 0 && nx < chunksWide && ny >= 0 && ny < chunksHigh)
-                chunkActive[ny * chunksWide + nx] = 1u;
+void CellBuffer::markChunkDirty(int px, int py) {
+    markChunkRangeDirty(px, py, px, py);
+}
+
+void CellBuffer::markChunkRangeDirty(int x0, int y0, int x1, int y1) {
+    // Record chunk indices only. They are OR'd into the next tick's activity
+    // (as the wake mask) rather than into the activity seed, so a brush
+    // stroke wakes its chunks for one tick without feeding the dilation.
+    const int cx0 = std::max(x0 / CHUNK_SIZE - 1, 0);
+    const int cy0 = std::max(y0 / CHUNK_SIZE - 1, 0);
+    const int cx1 = std::min(x1 / CHUNK_SIZE + 1, chunksWide - 1);
+    const int cy1 = std::min(y1 / CHUNK_SIZE + 1, chunksHigh - 1);
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            const int idx = cy * chunksWide + cx;
+            if (pendingChunkMask[idx] == 0u) {
+                pendingChunkMask[idx] = 1u;
+                pendingBrushChunks.push_back(idx);
+            }
         }
     }
 }
 
-void CellBuffer::markChunkDirty(int px, int py) {
-    int cx = px / CHUNK_SIZE;
-    int cy = py / CHUNK_SIZE;
-    // Record chunk indices — don't write chunkActive directly.
-    // simulateGPU applies these AFTER rebuilding from GPU output, so
-    // they don't contaminate the GPU-activity-based rebuild.
-    for (int dy = -1; dy <= 1; ++dy)
-        for (int dx = -1; dx <= 1; ++dx) {
-            int nx = cx + dx, ny = cy + dy;
-            if (nx >= 0 && nx < chunksWide && ny >= 0 && ny < chunksHigh)
-                pendingBrushChunks.push_back(ny * chunksWide + nx);
+void CellBuffer::flushPendingChunks() {
+    if (pendingBrushChunks.empty()) return;
+
+    if (gpuChunkActivity) {
+        // Upload the index range covering this frame's marks; the encoder clears it after the activity pass
+        const auto [lo, hi] = std::minmax_element(pendingBrushChunks.begin(), pendingBrushChunks.end());
+        gpuChunkWake->writeRegion(static_cast<size_t>(*lo), pendingChunkMask.data() + *lo,
+                                  static_cast<size_t>(*hi - *lo + 1));
+    }
+    for (int idx : pendingBrushChunks) {
+        pendingChunkMask[idx] = 0u;
+    }
+    pendingBrushChunks.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Particle spatial index
+// ---------------------------------------------------------------------------
+
+void CellBuffer::rebuildParticleIndex() {
+    particleIndexDirty = false;
+    particleChunkStart.assign(static_cast<size_t>(numChunks) + 1u, 0u);
+    particleChunkItems.clear();
+    if (particleCpu.empty() || nextParticleIndex == 0u) return;
+
+    auto chunkOf = [&](const Particle& p) {
+        const int px = std::clamp(static_cast<int>(std::floor(p.pos.x)), 0, width  - 1);
+        const int py = std::clamp(static_cast<int>(std::floor(p.pos.y)), 0, height - 1);
+        return (py / CHUNK_SIZE) * chunksWide + px / CHUNK_SIZE;
+    };
+
+    // Counting sort by chunk: count, prefix sum, scatter
+    for (uint32_t i = 0; i < nextParticleIndex; ++i) {
+        if (particleCpu[i].color != 0u) {
+            particleChunkStart[chunkOf(particleCpu[i]) + 1]++;
         }
+    }
+    for (int c = 0; c < numChunks; ++c) {
+        particleChunkStart[c + 1] += particleChunkStart[c];
+    }
+    particleChunkItems.resize(particleChunkStart[numChunks]);
+    particleChunkCursor.assign(particleChunkStart.begin(), particleChunkStart.end() - 1);
+    for (uint32_t i = 0; i < nextParticleIndex; ++i) {
+        if (particleCpu[i].color != 0u) {
+            particleChunkItems[particleChunkCursor[chunkOf(particleCpu[i])]++] = i;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Staged grid writes
+// ---------------------------------------------------------------------------
+
+void CellBuffer::writeRowSpan(int y, int x0, int x1, const uint32_t* src, uint32_t fill) {
+    if (x0 >= x1) return;
+    const size_t start = static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x0);
+    const size_t len = static_cast<size_t>(x1 - x0);
+
+    if (!computeInitialized) {
+        std::vector<Color>& active = getActiveBuffer();
+        for (size_t i = 0; i < len; ++i) {
+            active[start + i] = unpackCell(src ? src[i] : fill);
+        }
+        return;
+    }
+
+    uint32_t* dst = pendingCells.data() + start;
+    if (src) {
+        std::memcpy(dst, src, len * sizeof(uint32_t));
+    } else {
+        std::fill(dst, dst + len, fill);
+    }
+
+    // Writes usually arrive in raster order, so extend the previous span in place when possible
+    if (!pendingSpans.empty() && pendingSpans.back().end == start) {
+        pendingSpans.back().end = start + len;
+    } else {
+        pendingSpans.push_back({start, start + len});
+    }
+}
+
+void CellBuffer::uploadPendingSpans() {
+    if (pendingSpans.empty()) return;
+
+    // Merge overlapping and touching ranges; pendingCells already holds the last value written to each cell
+    std::sort(pendingSpans.begin(), pendingSpans.end(),
+              [](const CellSpan& a, const CellSpan& b) { return a.start < b.start; });
+    size_t merged = 0;
+    for (size_t i = 1; i < pendingSpans.size(); ++i) {
+        if (pendingSpans[i].start <= pendingSpans[merged].end) {
+            pendingSpans[merged].end = std::max(pendingSpans[merged].end, pendingSpans[i].end);
+        } else {
+            pendingSpans[++merged] = pendingSpans[i];
+        }
+    }
+    pendingSpans.resize(merged + 1);
+
+    // Region writes are staged by the queue and flushed together with this tick's submit
+    for (const CellSpan& span : pendingSpans) {
+        cellsA->writeRegion(span.start, pendingCells.data() + span.start, span.end - span.start);
+    }
+    pendingSpans.clear();
 }
 
 // ---------------------------------------------------------------------------
@@ -279,7 +409,7 @@ void CellBuffer::setActivePixel(int x, int y, const Color& color) {
 
     markChunkDirty(x, y);
     if (computeInitialized) {
-        pendingBrushPixels.push_back({y * width + x, color});
+        writeRowSpan(y, x, x + 1, nullptr, packCell(color, 0u));
         return;
     }
 
@@ -333,23 +463,68 @@ void CellBuffer::clear(const Color& color) {
 }
 
 void CellBuffer::applyBrush(int pixelX, int pixelY, int radius, const Color& color) {
-    for (int dy = -radius; dy <= radius; ++dy) {
-        for (int dx = -radius; dx <= radius; ++dx) {
-            if (dx*dx + dy*dy <= radius*radius) {
-                int x = pixelX + dx, y = pixelY + dy;
-                if (x >= 0 && x < width && y >= 0 && y < height) {
-                    markChunkDirty(x, y);
-                    if (computeInitialized) {
-                        pendingBrushPixels.push_back({y * width + x, color});
-                    } else {
-                        setActivePixel(x, y, color);
-                    }
-                }
-            }
+    if (radius < 0) return;
+    const int y0 = std::max(pixelY - radius, 0);
+    const int y1 = std::min(pixelY + radius, height - 1);
+    if (y0 > y1 || pixelX + radius < 0 || pixelX - radius >= width) return;
+
+    markChunkRangeDirty(std::max(pixelX - radius, 0), y0, std::min(pixelX + radius, width - 1), y1);
+    const uint32_t packed = packCell(color, 0u);
+    for (int y = y0; y <= y1; ++y) {
+        // widest dx with dx*dx + dy*dy <= radius*radius
+        const int dy = y - pixelY;
+        int half = static_cast<int>(std::sqrt(static_cast<float>(radius * radius - dy * dy)));
+        while (half * half + dy * dy > radius * radius) --half;
+        while ((half + 1) * (half + 1) + dy * dy <= radius * radius) ++half;
+        writeRowSpan(y, std::max(pixelX - half, 0), std::min(pixelX + half + 1, width), nullptr, packed);
+    }
+}
+
+void CellBuffer::fillRect(int x, int y, int w, int h, const Color& color) {
+    const int x0 = std::max(x, 0), x1 = std::min(x + w, width);
+    const int y0 = std::max(y, 0), y1 = std::min(y + h, height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    markChunkRangeDirty(x0, y0, x1 - 1, y1 - 1);
+    const uint32_t packed = packCell(color, 0u);
+    for (int row = y0; row < y1; ++row) {
+        writeRowSpan(row, x0, x1, nullptr, packed);
+    }
+}
+
+void CellBuffer::stampMask(int x, int y, int w, int h, const uint8_t* mask, const Color& color) {
+    if (mask == nullptr) return;
+    const int x0 = std::max(x, 0), x1 = std::min(x + w, width);
+    const int y0 = std::max(y, 0), y1 = std::min(y + h, height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    markChunkRangeDirty(x0, y0, x1 - 1, y1 - 1);
+    const uint32_t packed = packCell(color, 0u);
+    for (int row = y0; row < y1; ++row) {
+        const uint8_t* maskRow = mask + static_cast<size_t>(row - y) * static_cast<size_t>(w);
+        int px = x0;
+        while (px < x1) {
+            while (px < x1 && maskRow[px - x] == 0u) ++px;
+            const int runStart = px;
+            while (px < x1 && maskRow[px - x] != 0u) ++px;
+            writeRowSpan(row, runStart, px, nullptr, packed);
         }
     }
 }
 
+void CellBuffer::writePackedRegion(int x, int y, int w, int h, const uint32_t* packed) {
+    if (packed == nullptr) return;
+    const int x0 = std::max(x, 0), x1 = std::min(x + w, width);
+    const int y0 = std::max(y, 0), y1 = std::min(y + h, height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    markChunkRangeDirty(x0, y0, x1 - 1, y1 - 1);
+    for (int row = y0; row < y1; ++row) {
+        const uint32_t* src = packed + static_cast<size_t>(row - y) * static_cast<size_t>(w) + (x0 - x);
+        writeRowSpan(row, x0, x1, src, 0u);
+    }
+}
+
 void CellBuffer::explode(int pixelX, int pixelY, int radius, float fireChance) {
     if (radius < 0) {
         return;
@@ -402,12 +577,7 @@ void CellBuffer::explode(int pixelX, int pixelY, int radius, float fireChance) {
                         continue;
                     }
 
-                    markChunkDirty(x, y);
-                    if (computeInitialized) {
-                        pendingBrushPixels.push_back({y * width + x, empty});
-                    } else {
-                        setActivePixel(x, y, empty);
-                    }
+                    setActivePixel(x, y, empty);
                 }
             }
         }
@@ -456,29 +626,108 @@ bool CellBuffer::blitRgbaBuffer(
         return false;
     }
 
-    for (int y = 0; y < imageHeight; ++y) {
-        for (int x = 0; x < imageWidth; ++x) {
-            const size_t idx = (static_cast<size_t>(y) * static_cast<size_t>(imageWidth) + static_cast<size_t>(x)) * 4u;
-            const uint8_t a = rgba[idx + 3u];
-            if (a < alphaThreshold) {
-                continue;
+    // Every image row maps to one grid row, so opaque runs become row spans
+    const int x0 = std::max(offsetX, 0);
+    const int x1 = std::min(offsetX + imageWidth, width);
+    std::vector<uint32_t> rowCells(static_cast<size_t>(std::max(x1 - x0, 0)));
+    for (int y = 0; y < imageHeight && x0 < x1; ++y) {
+        const int py = flipYToBufferSpace ? (height - y + offsetY) : (y + offsetY);
+        if (py < 0 || py >= height) {
+            continue;
+        }
+
+        int px = x0;
+        while (px < x1) {
+            auto alphaAt = [&](int gx) {
+                return rgba[(static_cast<size_t>(y) * static_cast<size_t>(imageWidth) + static_cast<size_t>(gx - offsetX)) * 4u + 3u];
+            };
+            while (px < x1 && alphaAt(px) < alphaThreshold) ++px;
+            const int runStart = px;
+            for (; px < x1 && alphaAt(px) >= alphaThreshold; ++px) {
+                const size_t idx = (static_cast<size_t>(y) * static_cast<size_t>(imageWidth) + static_cast<size_t>(px - offsetX)) * 4u;
+                const Color c(
+                    rgba[idx + 0u],
+                    rgba[idx + 1u],
+                    rgba[idx + 2u],
+                    materialId,
+                    onFire ? 1u : 0u,
+                    isStatic
+                );
+                rowCells[static_cast<size_t>(px - x0)] = packCell(c, 0u);
+            }
+            if (px > runStart) {
+                markChunkRangeDirty(runStart, py, px - 1, py);
+                writeRowSpan(py, runStart, px, rowCells.data() + (runStart - x0), 0u);
             }
+        }
+    }
+
+    return true;
+}
+
+bool CellBuffer::saveCells(const std::string& path) const {
+    if (computeInitialized) {
+        // The mirror trails the device by the readback in flight (and a tick more with GPU chunk
+        // activity), so snapshot the authoritative cellsA and lay this frame's staged writes over it
+        const size_t cellCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+        std::vector<uint32_t> snapshot(cellCount);
+        StagingBufferU32 snapshotStaging(cellCount);
+        {
+            GpuEncoder enc;
+            enc.copyToStaging(*cellsA, snapshotStaging);
+            enc.submit();
+        }
+        snapshotStaging.collect(snapshot.data(), snapshot.size());
+        for (const CellSpan& span : pendingSpans) {
+            std::copy(pendingCells.begin() + span.start, pendingCells.begin() + span.end, snapshot.begin() + span.start);
+        }
+        return writeCellFile(path, snapshot.data(), width, height, CHUNK_SIZE);
+    }
+
+    const std::vector<Color>& active = getActiveBuffer();
+    std::vector<uint32_t> packed(active.size());
+    for (size_t i = 0; i < active.size(); ++i) {
+        packed[i] = packCell(active[i], 0u);
+    }
+    return writeCellFile(path, packed.data(), width, height, CHUNK_SIZE);
+}
+
+bool CellBuffer::loadCells(const std::string& path) {
+    std::vector<uint32_t> packed;
+    if (!readCellFile(path, width, height, CHUNK_SIZE, packed)) {
+        return false;
+    }
+    return setPackedCells(packed);
+}
 
-            const Color c(
-                rgba[idx + 0u],
-                rgba[idx + 1u],
-                rgba[idx + 2u],
-                materialId,
-                onFire ? 1u : 0u,
-                isStatic
-            );
-
-            const int px = x + offsetX;
-            const int py = flipYToBufferSpace ? (height - y + offsetY) : (y + offsetY);
-            setActivePixel(px, py, c);
+bool CellBuffer::setPackedCells(const std::vector<uint32_t>& packed) {
+    const size_t cellCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+    if (packed.size() != cellCount) {
+        return false;
+    }
+
+    // Queued brush writes predate the new grid and would land on top of it
+    pendingSpans.clear();
+
+    if (!computeInitialized) {
+        std::vector<Color>& active = getActiveBuffer();
+        for (size_t i = 0; i < cellCount; ++i) {
+            active[i] = unpackCell(packed[i]);
         }
+        return true;
+    }
+
+    // Drain an in-flight readback so it can't overwrite the mirror with the pre-load grid next tick
+    if (pendingCellsReadback) {
+        cellsStaging->collect(gpuCellScratch.data(), gpuCellScratch.size());
+        pendingCellsReadback = false;
     }
 
+    cellsA->write(packed.data(), cellCount);
+    gpuCellScratch = packed;
+
+    // Wake every chunk so the next tick settles the whole grid and reads it all back
+    markChunkRangeDirty(0, 0, width - 1, height - 1);
     return true;
 }
 
@@ -523,6 +772,7 @@ bool CellBuffer::addParticle(const glm::vec2& pos, const glm::vec2& vel, const C
     };
     particlesA->writeRegion(idx, &particleCpu[idx], 1);
     activeParticleCount++;
+    particleIndexDirty = true;
     if (poppedFromFree) {
         particleFreeCount->write(&particleFreeCountCpu, 1);
     }
@@ -538,6 +788,72 @@ bool CellBuffer::addParticle(const glm::vec2& pos, const glm::vec2& vel, char co
 // GPU simulation — pipelined
 // ---------------------------------------------------------------------------
 
+void CellBuffer::setGpuChunkActivity(bool enabled) {
+    if (enabled == gpuChunkActivity) return;
+    gpuChunkActivity = enabled;
+    if (!computeInitialized) return;
+
+    // Unmap a chunk readback still in flight from the CPU path
+    if (pendingChunkReadback) {
+        chunkStaging->collect(chunkActiveOut.data(), chunkActiveOut.size());
+        pendingChunkReadback = false;
+    }
+    // Likewise the apply list readback of the GPU path
+    if (pendingApplyListReadback) {
+        uint32_t args[6] = {};
+        applyArgsStaging->collect(args, 6);
+        gpuApplyChunkReadback.resize(static_cast<size_t>(numChunks));
+        applyListStaging->collect(gpuApplyChunkReadback.data(), gpuApplyChunkReadback.size());
+        gpuApplyChunkReadback.clear();
+        pendingApplyListReadback = false;
+    }
+
+    // Neither path can trust the other's seed, so restart both from all-active
+    std::fill(chunkActiveOut.begin(), chunkActiveOut.end(), 1u);
+    gpuChunkActiveOut->write(chunkActiveOut);
+}
+
+void CellBuffer::getCpuChunkActivity(std::vector<uint32_t>& active, std::vector<uint32_t>& intentList, std::vector<uint32_t>& applyList) const {
+    active = chunkActive;
+    intentList = intentChunkList;
+    applyList = applyChunkList;
+}
+
+void CellBuffer::readGpuChunkActivity(std::vector<uint32_t>& active, std::vector<uint32_t>& intentList, std::vector<uint32_t>& applyList) const {
+    active.clear();
+    intentList.clear();
+    applyList.clear();
+    if (!computeInitialized) return;
+
+    active.resize(static_cast<size_t>(numChunks));
+    intentList.resize(static_cast<size_t>(numChunks));
+    applyList.resize(static_cast<size_t>(numChunks));
+
+    StagingBufferU32 activeStaging(static_cast<size_t>(numChunks));
+    StagingBufferU32 intentStaging(static_cast<size_t>(numChunks));
+    StagingBufferU32 applyStaging(static_cast<size_t>(numChunks));
+    StagingBufferU32 argsStaging(6);
+    {
+        GpuEncoder enc;
+        enc.copyToStaging(*gpuChunkActive, activeStaging);
+        enc.copyToStaging(*gpuActiveChunkList, intentStaging);
+        enc.copyToStaging(*gpuApplyChunkList, applyStaging);
+        enc.copyToStaging(*gpuChunkDispatchArgs, argsStaging);
+        enc.submit();
+    }
+    uint32_t args[6] = {};
+    activeStaging.collect(active.data(), active.size());
+    intentStaging.collect(intentList.data(), intentList.size());
+    applyStaging.collect(applyList.data(), applyList.size());
+    argsStaging.collect(args, 6);
+
+    // The activity pass appends with atomics, sort so the lists compare against the CPU ones directly
+    intentList.resize(std::min<size_t>(args[0], intentList.size()));
+    applyList.resize(std::min<size_t>(args[3], applyList.size()));
+    std::sort(intentList.begin(), intentList.end());
+    std::sort(applyList.begin(), applyList.end());
+}
+
 void CellBuffer::simulate(float deltaTime) {
     explosionHappened = false;
     if (!computeInitialized) return;
@@ -580,6 +896,7 @@ void CellBuffer::simulate(float deltaTime) {
             }
         }
         pendingParticleReadback = false;
+        particleIndexDirty = true;
     }
 
     if (pendingExplosionReadback) {
@@ -608,102 +925,85 @@ void CellBuffer::simulate(float deltaTime) {
     }
 
     // ------------------------------------------------------------------
-    // STEP 2 — Collect chunk readback, rebuild chunkActive cleanly
+    // STEP 2 — Chunk activity for this tick
+    // GPU path: the activity pass rebuilds it on-device; only this frame's
+    // brush marks go up as the wake mask. Last tick's apply list and count
+    // come back here, so the readback below copies just the chunks that
+    // tick wrote. CPU path: rebuild from last tick's chunk_active_out
+    // readback with the reference implementation.
     // ------------------------------------------------------------------
-    if (runSandStep && pendingChunkReadback) {
-        chunkStaging->collect(chunkActiveOut.data(), chunkActiveOut.size());
-        pendingChunkReadback = false;
-
-        // Zero, then re-expand from GPU output only
-        std::fill(chunkActive.begin(), chunkActive.end(), 0u);
-        for (int cy = 0; cy < chunksHigh; ++cy)
-            for (int cx = 0; cx < chunksWide; ++cx)
-                if (chunkActiveOut[cy * chunksWide + cx] != 0u)
-                    markChunkAndNeighborsDirty(cx, cy);
-
-        // Apply brush chunk marks recorded this frame on top of GPU expansion
-        for (int idx : pendingBrushChunks)
-            chunkActive[idx] = 1u;
-        pendingBrushChunks.clear();
-    }
-
-    // ------------------------------------------------------------------
-    // STEP 3 — If brush happened before the first chunk readback,
-    // integrate brush chunk marks now. (Later frames: step 2 already did.)
-    // ------------------------------------------------------------------
-    if (runSandStep && !pendingBrushChunks.empty()) {
-        for (int idx : pendingBrushChunks)
-            chunkActive[idx] = 1u;
-        pendingBrushChunks.clear();
+    uint32_t intentChunkCount = 0u;
+    uint32_t applyChunkCount  = 0u;
+    uint32_t readbackChunkCount = 0u;
+    const uint32_t* readbackChunkList = nullptr;
+    bool applyListKnown = false;
+    if (runSandStep && gpuChunkActivity) {
+        if (pendingApplyListReadback) {
+            uint32_t args[6] = {};
+            applyArgsStaging->collect(args, 6);
+            gpuApplyChunkReadback.resize(static_cast<size_t>(numChunks));
+            applyListStaging->collect(gpuApplyChunkReadback.data(), gpuApplyChunkReadback.size());
+            gpuApplyChunkReadback.resize(std::min<size_t>(args[3], gpuApplyChunkReadback.size()));
+            pendingApplyListReadback = false;
+            applyListKnown = true;
+        }
+        readbackChunkCount = static_cast<uint32_t>(gpuApplyChunkReadback.size());
+        readbackChunkList = gpuApplyChunkReadback.data();
+        flushPendingChunks();
+    } else if (runSandStep) {
+        if (pendingChunkReadback) {
+            chunkStaging->collect(chunkActiveOut.data(), chunkActiveOut.size());
+            pendingChunkReadback = false;
+        }
+        buildChunkActivity(chunkActiveOut.data(), pendingChunkMask.data(), chunksWide, chunksHigh,
+                           chunkActive, intentChunkList, applyChunkList);
+        flushPendingChunks();
+        intentChunkCount = static_cast<uint32_t>(intentChunkList.size());
+        applyChunkCount  = static_cast<uint32_t>(applyChunkList.size());
+        readbackChunkCount = applyChunkCount;
+        readbackChunkList = applyChunkList.data();
+        applyListKnown = true;
     }
 
     // ------------------------------------------------------------------
-    // STEP 4 — Upload pending brush pixels to GPU cellsA only.
+    // STEP 3 — Upload staged write spans to GPU cellsA only.
     // (No full-grid CPU->GPU upload; simulation state stays on GPU.)
     // ------------------------------------------------------------------
-    if (runSandStep && !pendingBrushPixels.empty()) {
-
-        std::sort(pendingBrushPixels.begin(), pendingBrushPixels.end(),
-                  [](const BrushPixel& a, const BrushPixel& b) { return a.idx < b.idx; });
-
-        size_t i = 0;
-        while (i < pendingBrushPixels.size()) {
-            int startIdx = pendingBrushPixels[i].idx;
-            size_t j = i + 1;
-            while (j < pendingBrushPixels.size() &&
-                   pendingBrushPixels[j].idx == startIdx + static_cast<int>(j - i)) {
-                ++j;
-            }
-
-            const size_t len = j - i;
-            std::vector<uint32_t> values;
-            values.resize(len);
-            for (size_t k = 0; k < len; ++k) {
-                const Color& c = pendingBrushPixels[i + k].color;
-                values[k] = packCell(c, 0u);
-            }
-            cellsA->writeRegion(static_cast<size_t>(startIdx), values.data(), len);
-            i = j;
-        }
-
-        pendingBrushPixels.clear();
+    if (runSandStep) {
+        uploadPendingSpans();
     }
 
     // ------------------------------------------------------------------
-    // STEP 5 — Advance frame parity
+    // STEP 4 — Advance frame parity
     // ------------------------------------------------------------------
     if (runSandStep) {
         isLeftFrame = !isLeftFrame;
     }
 
     // ------------------------------------------------------------------
-    // STEP 6 — Upload chunk flags, zero transient GPU buffers
+    // STEP 5 — Reset indirect args / upload CPU-built chunk lists,
+    // zero transient GPU buffers
     // ------------------------------------------------------------------
-    // Build a compact list of active chunks so the intent pass can be
-    // dispatched sparsely (one workgroup per active chunk).
-    std::vector<uint32_t> activeChunkListIndices(numChunks, 0u);
-    uint32_t activeChunkCount = 0u;
-    if (runSandStep) {
-        for (uint32_t ci = 0; ci < chunkActive.size(); ++ci) {
-            if (chunkActive[ci] != 0u) {
-                activeChunkListIndices[activeChunkCount++] = ci;
-            }
-        }
-    }
-
-    if (runSandStep) {
+    if (runSandStep && gpuChunkActivity) {
+        // x is counted by the activity pass, y and z stay 1
+        const uint32_t dispatchArgs[6] = { 0u, 1u, 1u, 0u, 1u, 1u };
+        gpuChunkDispatchArgs->write(dispatchArgs, 6);
+    } else if (runSandStep) {
         gpuChunkActive->write(chunkActive.data(), chunkActive.size());
-        gpuActiveChunkList->write(activeChunkListIndices.data(), activeChunkListIndices.size());
-        gpuChunkIntent   ->zero();
+        if (intentChunkCount > 0u) gpuActiveChunkList->write(intentChunkList.data(), intentChunkCount);
+        if (applyChunkCount  > 0u) gpuApplyChunkList ->write(applyChunkList.data(), applyChunkCount);
         gpuChunkActiveOut->zero();
     }
+    if (runSandStep) {
+        gpuChunkIntent->zero();
+    }
     {
         const uint32_t zero = 0u;
         explosionCount->write(&zero, 1);
     }
 
     // ------------------------------------------------------------------
-    // STEP 7 — Build encoder, submit ONE batch
+    // STEP 6 — Build encoder, submit ONE batch
     // cellsA = permanent input, cellsB = permanent output, no pointer swap
     // ------------------------------------------------------------------
     struct SimUniforms {
@@ -726,10 +1026,10 @@ void CellBuffer::simulate(float deltaTime) {
     u.is_left_frame = isLeftFrame ? 1u : 0u;
     u.chunk_size    = CHUNK_SIZE;
     u.chunks_wide   = chunksWide;
-    thread_local std::mt19937 simUniformRng{std::random_device{}()};
-    u.random_seed   = static_cast<uint32_t>(simUniformRng());
+    u.random_seed   = static_cast<uint32_t>(simRng());
     u.pad[0] = u.pad[1] = 0;
 
+    activityShader->setUniform(u);
     intentShader ->setUniform(u);
     resolveShader->setUniform(u);
     applyShader  ->setUniform(u);
@@ -743,22 +1043,81 @@ void CellBuffer::simulate(float deltaTime) {
     pU.chunks_wide = static_cast<uint32_t>(chunksWide);
     particleShader->setUniform(pU);
 
-    const uint32_t gx = static_cast<uint32_t>(chunksWide);
-    const uint32_t gy = static_cast<uint32_t>(chunksHigh);
+    // Lazy readback: copy only the chunk squares apply wrote into staging, the rest
+    // of staging still holds what earlier readbacks left there. Memory layout is
+    // row-major, so each 16x16 chunk goes as CHUNK_SIZE contiguous row segments.
+    // Without a known apply list the grid is read back in one copy.
+    const uint64_t sparseRowCopyOpsLimit = 4096ull; // avoid thousands of tiny copies
+    const bool forceFullReadbackForParticles = activeParticleCount > 0u;
+    const bool fullReadback = !applyListKnown ||
+        forceFullReadbackForParticles ||
+        readbackChunkCount == static_cast<uint32_t>(numChunks) ||
+        (static_cast<uint64_t>(readbackChunkCount) * static_cast<uint64_t>(CHUNK_SIZE)) > sparseRowCopyOpsLimit;
+    auto copyChunkRows = [&](GpuEncoder& enc, GpuBufferU32& source) {
+        // Sparse readback: one 16-element copy per chunk row.
+        for (uint32_t ai = 0; ai < readbackChunkCount; ++ai) {
+            const uint32_t chunkIndex = readbackChunkList[ai];
+            const uint32_t cx = chunkIndex % static_cast<uint32_t>(chunksWide);
+            const uint32_t cy = chunkIndex / static_cast<uint32_t>(chunksWide);
+
+            const uint32_t originX = cx * static_cast<uint32_t>(CHUNK_SIZE);
+            const uint32_t originY = cy * static_cast<uint32_t>(CHUNK_SIZE);
+
+            if (originX >= static_cast<uint32_t>(width)) continue;
+
+            const uint32_t rowCopyLen =
+                std::min<uint32_t>(static_cast<uint32_t>(CHUNK_SIZE),
+                                   static_cast<uint32_t>(width) - originX);
+
+            for (uint32_t ly = 0; ly < static_cast<uint32_t>(CHUNK_SIZE); ++ly) {
+                const uint32_t y = originY + ly;
+                if (y >= static_cast<uint32_t>(height)) break;
+
+                const size_t srcOffset =
+                    static_cast<size_t>(y) * static_cast<size_t>(width) +
+                    static_cast<size_t>(originX);
+
+                enc.copyRegionToStagingAtOffset(source, *cellsStaging,
+                                                srcOffset, srcOffset,
+                                                rowCopyLen);
+            }
+        }
+    };
 
     {
         GpuEncoder enc;
-        if (runSandStep) {
-            if (activeChunkCount > 0u) {
-                enc.dispatch(intentShader->handle(), activeChunkCount, 1u, 1u);
-            }
-            enc.dispatch(resolveShader->handle(), gx, gy);
-            enc.dispatch(applyShader  ->handle(), gx, gy);
-        } else if (nextParticleIndex > 0u) {
-            // Keep particle updates smooth between fixed sand ticks:
-            // seed cellsB from authoritative cellsA for particle collision/deposit.
+        if (runSandStep && gpuChunkActivity && !fullReadback) {
+            // The GPU apply list is a tick behind, so read its chunks from cellsA
+            // before this tick steps: the CPU mirror lags the device by one tick.
+            copyChunkRows(enc, *cellsA);
+        }
+        if (runSandStep || nextParticleIndex > 0u) {
+            // Seed cellsB from authoritative cellsA: resolve/apply only rewrite listed
+            // chunks, and between sand ticks particles collide/deposit against it.
             enc.copyBuffer(*cellsA, *cellsB);
         }
+        if (runSandStep && gpuChunkActivity) {
+            const uint32_t activityGroups = (static_cast<uint32_t>(numChunks) + 63u) / 64u;
+            const uint64_t applyArgsOffset = 3u * sizeof(uint32_t);
+            enc.dispatch(activityShader->handle(), activityGroups, 1u, 1u);
+            // Both were consumed above; apply and particles accumulate the next seed from zero
+            enc.clearBuffer(*gpuChunkActiveOut);
+            enc.clearBuffer(*gpuChunkWake);
+            enc.dispatchIndirect(intentShader ->handle(), *gpuChunkDispatchArgs, 0u);
+            enc.dispatchIndirect(resolveShader->handle(), *gpuChunkDispatchArgs, applyArgsOffset);
+            enc.dispatchIndirect(applyShader  ->handle(), *gpuChunkDispatchArgs, applyArgsOffset);
+            // This tick's apply list drives next tick's sparse readback
+            enc.copyToStaging(*gpuApplyChunkList, *applyListStaging);
+            enc.copyToStaging(*gpuChunkDispatchArgs, *applyArgsStaging);
+        } else if (runSandStep) {
+            if (intentChunkCount > 0u) {
+                enc.dispatch(intentShader->handle(), intentChunkCount, 1u, 1u);
+            }
+            if (applyChunkCount > 0u) {
+                enc.dispatch(resolveShader->handle(), applyChunkCount, 1u, 1u);
+                enc.dispatch(applyShader  ->handle(), applyChunkCount, 1u, 1u);
+            }
+        }
         if (nextParticleIndex > 0u) {
             const uint32_t particleGroups = (nextParticleIndex + 255u) / 256u;
             enc.dispatch(particleShader->handle(), particleGroups, 1u, 1u);
@@ -772,47 +1131,13 @@ void CellBuffer::simulate(float deltaTime) {
             // Keep simulation state on GPU: cellsA remains authoritative.
             enc.copyBuffer(*cellsB, *cellsA);
         }
-        if (runSandStep) {
-            // Lazy readback: copy only active chunk squares into staging.
-            // Memory layout is row-major, so each 16x16 chunk is uploaded as
-            // CHUNK_SIZE contiguous row segments.
-            const uint64_t sparseRowCopyOpsLimit = 4096ull; // avoid thousands of tiny copies
-            const bool forceFullReadbackForParticles = activeParticleCount > 0u;
-            if (forceFullReadbackForParticles ||
-                activeChunkCount == static_cast<uint32_t>(numChunks) ||
-                (static_cast<uint64_t>(activeChunkCount) * static_cast<uint64_t>(CHUNK_SIZE)) > sparseRowCopyOpsLimit) {
-                // Too large/sparse not beneficial: just read back the full buffer.
-                enc.copyToStaging(*cellsB, *cellsStaging);
-            } else if (activeChunkCount > 0u) {
-                // Sparse readback: one 16-element copy per chunk row.
-                for (uint32_t ai = 0; ai < activeChunkCount; ++ai) {
-                    const uint32_t chunkIndex = activeChunkListIndices[ai];
-                    const uint32_t cx = chunkIndex % static_cast<uint32_t>(chunksWide);
-                    const uint32_t cy = chunkIndex / static_cast<uint32_t>(chunksWide);
-
-                    const uint32_t originX = cx * static_cast<uint32_t>(CHUNK_SIZE);
-                    const uint32_t originY = cy * static_cast<uint32_t>(CHUNK_SIZE);
-
-                    if (originX >= static_cast<uint32_t>(width)) continue;
-
-                    const uint32_t rowCopyLen =
-                        std::min<uint32_t>(static_cast<uint32_t>(CHUNK_SIZE),
-                                           static_cast<uint32_t>(width) - originX);
-
-                    for (uint32_t ly = 0; ly < static_cast<uint32_t>(CHUNK_SIZE); ++ly) {
-                        const uint32_t y = originY + ly;
-                        if (y >= static_cast<uint32_t>(height)) break;
-
-                        const size_t srcOffset =
-                            static_cast<size_t>(y) * static_cast<size_t>(width) +
-                            static_cast<size_t>(originX);
-
-                        enc.copyRegionToStagingAtOffset(*cellsB, *cellsStaging,
-                                                        srcOffset, srcOffset,
-                                                        rowCopyLen);
-                    }
-                }
-            }
+        if (runSandStep && fullReadback) {
+            // Too large/sparse not beneficial: just read back the full buffer.
+            enc.copyToStaging(*cellsB, *cellsStaging);
+        } else if (runSandStep && !gpuChunkActivity) {
+            copyChunkRows(enc, *cellsB);
+        }
+        if (runSandStep && !gpuChunkActivity) {
             enc.copyToStaging(*gpuChunkActiveOut, *chunkStaging);
         }
         enc.submit();
@@ -823,8 +1148,14 @@ void CellBuffer::simulate(float deltaTime) {
     // ------------------------------------------------------------------
     if (runSandStep) {
         cellsStaging->mapAsync();
-        chunkStaging->mapAsync();
         pendingCellsReadback = true;
+    }
+    if (runSandStep && gpuChunkActivity) {
+        applyListStaging->mapAsync();
+        applyArgsStaging->mapAsync();
+        pendingApplyListReadback = true;
+    } else if (runSandStep) {
+        chunkStaging->mapAsync();
         pendingChunkReadback = true;
     }
     if (nextParticleIndex > 0u) {
@@ -0,0 +1,223 @@
+#include <basilisk/physics/cellular/cellFile.h>
+#include <basilisk/util/mappedFile.h>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+namespace bsk::internal {
+
+// momentum (bits 31-30), see cellFile.h for why it is not persisted
+static constexpr uint32_t CELL_PERSIST_MASK = 0x3FFFFFFFu;
+
+static void appendWords(std::vector<uint8_t>& out, const uint32_t* words, size_t count) {
+    const size_t start = out.size();
+    out.resize(start + count * sizeof(uint32_t));
+    std::memcpy(out.data() + start, words, count * sizeof(uint32_t));
+}
+
+void encodeCellChunks(const uint32_t* cells, int width, int height, int chunkSize, std::vector<uint8_t>& out) {
+    const int chunksWide = (width  + chunkSize - 1) / chunkSize;
+    const int chunksHigh = (height + chunkSize - 1) / chunkSize;
+    const size_t numChunks = static_cast<size_t>(chunksWide) * static_cast<size_t>(chunksHigh);
+
+    std::vector<CellChunkEntry> entries(numChunks);
+    std::vector<uint32_t> payload;
+    std::vector<uint32_t> chunkCells;
+    std::vector<uint32_t> runs;
+    chunkCells.reserve(static_cast<size_t>(chunkSize) * static_cast<size_t>(chunkSize));
+
+    for (int cy = 0; cy < chunksHigh; ++cy) {
+        for (int cx = 0; cx < chunksWide; ++cx) {
+            const int x0 = cx * chunkSize;
+            const int y0 = cy * chunkSize;
+            const int x1 = std::min(x0 + chunkSize, width);
+            const int y1 = std::min(y0 + chunkSize, height);
+
+            chunkCells.clear();
+            for (int y = y0; y < y1; ++y) {
+                const uint32_t* row = cells + static_cast<size_t>(y) * static_cast<size_t>(width);
+                for (int x = x0; x < x1; ++x) {
+                    chunkCells.push_back(row[x] & CELL_PERSIST_MASK);
+                }
+            }
+
+            runs.clear();
+            for (size_t i = 0; i < chunkCells.size();) {
+                size_t j = i + 1;
+                while (j < chunkCells.size() && chunkCells[j] == chunkCells[i]) ++j;
+                runs.push_back(static_cast<uint32_t>(j - i));
+                runs.push_back(chunkCells[i]);
+                i = j;
+            }
+
+            CellChunkEntry& entry = entries[static_cast<size_t>(cy) * chunksWide + cx];
+            const size_t runCount = runs.size() / 2;
+            if (runCount == 1) {
+                entry.encoding = static_cast<uint32_t>(runs[1] == 0u ? CellChunkEncoding::EMPTY : CellChunkEncoding::UNIFORM);
+                entry.value = runs[1];
+                entry.offset = 0u;
+            } else if (runs.size() < chunkCells.size()) {
+                entry.encoding = static_cast<uint32_t>(CellChunkEncoding::RLE);
+                entry.value = static_cast<uint32_t>(runCount);
+                entry.offset = static_cast<uint32_t>(payload.size());
+                payload.insert(payload.end(), runs.begin(), runs.end());
+            } else {
+                entry.encoding = static_cast<uint32_t>(CellChunkEncoding::RAW);
+                entry.value = static_cast<uint32_t>(chunkCells.size());
+                entry.offset = static_cast<uint32_t>(payload.size());
+                payload.insert(payload.end(), chunkCells.begin(), chunkCells.end());
+            }
+        }
+    }
+
+    CellFileHeader header{};
+    header.magic        = CELL_FILE_MAGIC;
+    header.version      = CELL_FILE_VERSION;
+    header.width        = static_cast<uint32_t>(width);
+    header.height       = static_cast<uint32_t>(height);
+    header.chunkSize    = static_cast<uint32_t>(chunkSize);
+    header.chunksWide   = static_cast<uint32_t>(chunksWide);
+    header.chunksHigh   = static_cast<uint32_t>(chunksHigh);
+    header.payloadWords = static_cast<uint32_t>(payload.size());
+
+    out.clear();
+    out.reserve(sizeof(CellFileHeader) + numChunks * sizeof(CellChunkEntry) + payload.size() * sizeof(uint32_t));
+    appendWords(out, reinterpret_cast<const uint32_t*>(&header), sizeof(CellFileHeader) / sizeof(uint32_t));
+    appendWords(out, reinterpret_cast<const uint32_t*>(entries.data()), numChunks * sizeof(CellChunkEntry) / sizeof(uint32_t));
+    appendWords(out, payload.data(), payload.size());
+}
+
+bool decodeCellChunks(const uint8_t* data, size_t size, int width, int height, int chunkSize, uint32_t* cells) {
+    if (data == nullptr || size < sizeof(CellFileHeader)) {
+        return false;
+    }
+
+    CellFileHeader header;
+    std::memcpy(&header, data, sizeof(CellFileHeader));
+    if (header.magic != CELL_FILE_MAGIC || header.version != CELL_FILE_VERSION) {
+        return false;
+    }
+    if (header.width != static_cast<uint32_t>(width) ||
+        header.height != static_cast<uint32_t>(height) ||
+        header.chunkSize != static_cast<uint32_t>(chunkSize)) {
+        return false;
+    }
+
+    const int chunksWide = (width  + chunkSize - 1) / chunkSize;
+    const int chunksHigh = (height + chunkSize - 1) / chunkSize;
+    if (header.chunksWide != static_cast<uint32_t>(chunksWide) || header.chunksHigh != static_cast<uint32_t>(chunksHigh)) {
+        return false;
+    }
+
+    const size_t numChunks = static_cast<size_t>(chunksWide) * static_cast<size_t>(chunksHigh);
+    const size_t tableBytes = numChunks * sizeof(CellChunkEntry);
+    const size_t payloadBytes = static_cast<size_t>(header.payloadWords) * sizeof(uint32_t);
+    if (size < sizeof(CellFileHeader) + tableBytes + payloadBytes) {
+        return false;
+    }
+
+    const uint8_t* table = data + sizeof(CellFileHeader);
+    const uint8_t* payload = table + tableBytes;
+    auto payloadWord = [&](size_t i) {
+        uint32_t w;
+        std::memcpy(&w, payload + i * sizeof(uint32_t), sizeof(uint32_t));
+        return w;
+    };
+
+    for (int cy = 0; cy < chunksHigh; ++cy) {
+        for (int cx = 0; cx < chunksWide; ++cx) {
+            CellChunkEntry entry;
+            std::memcpy(&entry, table + (static_cast<size_t>(cy) * chunksWide + cx) * sizeof(CellChunkEntry), sizeof(CellChunkEntry));
+
+            const int x0 = cx * chunkSize;
+            const int y0 = cy * chunkSize;
+            const int x1 = std::min(x0 + chunkSize, width);
+            const int y1 = std::min(y0 + chunkSize, height);
+            const int rowLen = x1 - x0;
+            const size_t chunkCellCount = static_cast<size_t>(rowLen) * static_cast<size_t>(y1 - y0);
+
+            switch (static_cast<CellChunkEncoding>(entry.encoding)) {
+                case CellChunkEncoding::EMPTY:
+                case CellChunkEncoding::UNIFORM: {
+                    const uint32_t value = entry.encoding == static_cast<uint32_t>(CellChunkEncoding::EMPTY) ? 0u : entry.value;
+                    for (int y = y0; y < y1; ++y) {
+                        uint32_t* row = cells + static_cast<size_t>(y) * static_cast<size_t>(width);
+                        std::fill(row + x0, row + x1, value);
+                    }
+                    break;
+                }
+                case CellChunkEncoding::RLE: {
+                    if (static_cast<size_t>(entry.offset) + static_cast<size_t>(entry.value) * 2u > header.payloadWords) {
+                        return false;
+                    }
+                    size_t written = 0;
+                    for (uint32_t r = 0; r < entry.value; ++r) {
+                        const uint32_t count = payloadWord(entry.offset + r * 2u);
+                        const uint32_t value = payloadWord(entry.offset + r * 2u + 1u);
+                        if (written + count > chunkCellCount) {
+                            return false;
+                        }
+                        for (uint32_t k = 0; k < count; ++k, ++written) {
+                            const size_t lx = written % static_cast<size_t>(rowLen);
+                            const size_t ly = written / static_cast<size_t>(rowLen);
+                            cells[(y0 + ly) * static_cast<size_t>(width) + x0 + lx] = value;
+                        }
+                    }
+                    if (written != chunkCellCount) {
+                        return false;
+                    }
+                    break;
+                }
+                case CellChunkEncoding::RAW: {
+                    if (entry.value != chunkCellCount ||
+                        static_cast<size_t>(entry.offset) + chunkCellCount > header.payloadWords) {
+                        return false;
+                    }
+                    const uint8_t* src = payload + static_cast<size_t>(entry.offset) * sizeof(uint32_t);
+                    for (int y = y0; y < y1; ++y) {
+                        uint32_t* row = cells + static_cast<size_t>(y) * static_cast<size_t>(width);
+                        std::memcpy(row + x0, src, static_cast<size_t>(rowLen) * sizeof(uint32_t));
+                        src += static_cast<size_t>(rowLen) * sizeof(uint32_t);
+                    }
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool writeCellFile(const std::string& path, const uint32_t* cells, int width, int height, int chunkSize) {
+    std::vector<uint8_t> bytes;
+    encodeCellChunks(cells, width, height, chunkSize, bytes);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open cell file for writing: " << path << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+bool readCellFile(const std::string& path, int width, int height, int chunkSize, std::vector<uint32_t>& cells) {
+    // Decoded straight from the mapping, the encoded image is never copied into memory
+    MappedFile file(path);
+    if (file.getData() == nullptr) {
+        std::cerr << "Failed to map cell file (missing or empty): " << path << std::endl;
+        return false;
+    }
+
+    cells.resize(static_cast<size_t>(width) * static_cast<size_t>(height));
+    if (!decodeCellChunks(file.getData(), file.getSize(), width, height, chunkSize, cells.data())) {
+        std::cerr << "Invalid or mismatched cell file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}
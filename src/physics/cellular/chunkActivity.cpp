@@ -0,0 +1,48 @@
+#include <basilisk/physics/cellular/chunkActivity.h>
+#include <algorithm>
+
+namespace bsk::internal {
+
+// OR of each chunk's 3x3 neighbourhood in src, clipped to the grid
+static void dilateChunks(const uint32_t* src, int chunksWide, int chunksHigh, std::vector<uint32_t>& dst) {
+    dst.assign(static_cast<size_t>(chunksWide) * static_cast<size_t>(chunksHigh), 0u);
+    for (int cy = 0; cy < chunksHigh; ++cy) {
+        for (int cx = 0; cx < chunksWide; ++cx) {
+            if (src[cy * chunksWide + cx] == 0u) continue;
+            for (int ny = std::max(cy - 1, 0); ny <= std::min(cy + 1, chunksHigh - 1); ++ny) {
+                for (int nx = std::max(cx - 1, 0); nx <= std::min(cx + 1, chunksWide - 1); ++nx) {
+                    dst[ny * chunksWide + nx] = 1u;
+                }
+            }
+        }
+    }
+}
+
+void buildChunkActivity(
+    const uint32_t* activeOut,
+    const uint32_t* wake,
+    int chunksWide,
+    int chunksHigh,
+    std::vector<uint32_t>& chunkActive,
+    std::vector<uint32_t>& intentList,
+    std::vector<uint32_t>& applyList
+) {
+    const size_t numChunks = static_cast<size_t>(chunksWide) * static_cast<size_t>(chunksHigh);
+
+    dilateChunks(activeOut, chunksWide, chunksHigh, chunkActive);
+    for (size_t i = 0; i < numChunks; ++i) {
+        if (wake[i] != 0u) chunkActive[i] = 1u;
+    }
+
+    std::vector<uint32_t> applyMask;
+    dilateChunks(chunkActive.data(), chunksWide, chunksHigh, applyMask);
+
+    intentList.clear();
+    applyList.clear();
+    for (size_t i = 0; i < numChunks; ++i) {
+        if (chunkActive[i] != 0u) intentList.push_back(static_cast<uint32_t>(i));
+        if (applyMask[i]   != 0u) applyList.push_back(static_cast<uint32_t>(i));
+    }
+}
+
+}
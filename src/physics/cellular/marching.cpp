@@ -1,4 +1,7 @@
 #include <basilisk/physics/cellular/marching.h>
+#include <bit>
+#include <cassert>
+#include <numeric>
 
 namespace bsk::internal {
 
@@ -631,96 +634,152 @@ std::vector<BayazitConvex>& Polygon::decompose() {
 // MarchingGrid
 // ----------------------------------------------
 
-void MarchingGrid::bfs() {
+int MarchingGrid::findRoot(std::vector<int>& parent, int i) const {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+void MarchingGrid::labelComponents() {
     components.clear();
-    std::unordered_set<int> unvisited;
-    unvisited.reserve(width * height);
-    for (int x = 0; x < width; ++x) {
-        for (int y = 0; y < height; ++y) {
-            if (isValid(x, y)) {
-                unvisited.insert(encode(x, y));
+    labels.assign(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), -1);
+    if (cells.empty()) {
+        return;
+    }
+
+    // Split every row into runs of set cells, straight from the bitset words
+    std::vector<MarchRun> runs;
+    std::vector<int> rowStart(static_cast<std::size_t>(height) + 1, 0);
+    for (int y = 0; y < height; ++y) {
+        rowStart[y] = static_cast<int>(runs.size());
+        const uint64_t* row = cells.row(y);
+        for (int w = 0; w < cells.getWordsPerRow(); ++w) {
+            uint64_t bits = row[w];
+            while (bits != 0) {
+                const int start = std::countr_zero(bits);
+                const int len = std::countr_one(bits >> start);
+                const int end = start + len;
+                bits &= end >= 64 ? 0ull : ~0ull << end;
+
+                const int x0 = w * 64 + start;
+                const int x1 = x0 + len - 1;
+                // a run crossing a word boundary continues the previous one
+                if (static_cast<int>(runs.size()) > rowStart[y] && runs.back().x1 + 1 == x0) {
+                    runs.back().x1 = x1;
+                } else {
+                    runs.push_back({y, x0, x1});
+                }
             }
         }
     }
-
-    std::deque<std::pair<int, int>> queue;
-    while (!unvisited.empty()) {
-        // Flood-fill one connected component at a time.
-        const int seed = *unvisited.begin();
-        unvisited.erase(seed);
-        queue.push_back(decode(seed));
-        components.emplace_back();
-        auto& current = components.back();
-
-        while (!queue.empty()) {
-            const auto [x, y] = queue.front();
-            queue.pop_front();
-            current.emplace_back(x, y);
-
-            for (int dx = -1; dx <= 1; ++dx) {
-                for (int dy = -1; dy <= 1; ++dy) {
-                    if (dx == 0 && dy == 0) {
-                        continue;
-                    }
-                    const int nx = x + dx;
-                    const int ny = y + dy;
-                    if (!isInside(nx, ny)) {
-                        continue;
-                    }
-                    const int key = encode(nx, ny);
-                    auto it = unvisited.find(key);
-                    if (it != unvisited.end()) {
-                        queue.emplace_back(nx, ny);
-                        unvisited.erase(it);
-                    }
+    rowStart[height] = static_cast<int>(runs.size());
+
+    // Union runs with the runs they touch (8-connected) in the row below
+    std::vector<int> parent(runs.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    for (int y = 1; y < height; ++y) {
+        int i = rowStart[y - 1];
+        int j = rowStart[y];
+        while (i < rowStart[y] && j < rowStart[y + 1]) {
+            const MarchRun& below = runs[i];
+            const MarchRun& above = runs[j];
+            if (below.x1 + 1 < above.x0) {
+                ++i;
+            } else if (above.x1 + 1 < below.x0) {
+                ++j;
+            } else {
+                const int a = findRoot(parent, i);
+                const int b = findRoot(parent, j);
+                if (a != b) {
+                    parent[std::max(a, b)] = std::min(a, b);
                 }
+                if (below.x1 < above.x1) ++i; else ++j;
             }
         }
     }
+
+    // Number components in raster order of their first run
+    std::vector<int> componentOfRoot(runs.size(), -1);
+    for (std::size_t r = 0; r < runs.size(); ++r) {
+        const int root = findRoot(parent, static_cast<int>(r));
+        if (componentOfRoot[root] < 0) {
+            componentOfRoot[root] = static_cast<int>(components.size());
+            components.emplace_back();
+        }
+        const int component = componentOfRoot[root];
+        const MarchRun& run = runs[r];
+        components[component].push_back(run);
+        int* labelRow = labels.data() + static_cast<std::size_t>(run.y) * static_cast<std::size_t>(width);
+        std::fill(labelRow + run.x0, labelRow + run.x1 + 1, component);
+    }
+}
+
+MarchingGrid::MarchQuadWord MarchingGrid::getMarchQuad(int qy, int word) const {
+    // bit i is cell word * 64 + i, i.e. the right-hand corners of quad bit i
+    auto right = [&](int y) -> uint64_t {
+        return (y < 0 || y >= height) ? 0ull : cells.row(y)[word];
+    };
+    // the same row shifted up one bit, i.e. the left-hand corners
+    auto left = [&](int y) -> uint64_t {
+        if (y < 0 || y >= height) return 0ull;
+        const uint64_t* row = cells.row(y);
+        return (row[word] << 1) | (word > 0 ? row[word - 1] >> 63 : 0ull);
+    };
+    return { left(qy), right(qy), right(qy + 1), left(qy + 1) };
 }
 
 std::vector<MarchComponentGeometry> MarchingGrid::genMarch() {
-    std::vector<MarchComponentGeometry> out;
-    out.reserve(components.size());
-
-    std::size_t componentIndex = 0;
-    for (const auto& component : components) {
-        Polygon polygon;
-        std::unordered_set<int> seenAnchors;
-        std::vector<std::pair<int, int>> orderedAnchors;
-
-        for (const auto& [x, y] : component) {
-            for (int dx : {0, -1}) {
-                for (int dy : {0, -1}) {
-                    const int ax = x + dx;
-                    const int ay = y + dy;
-                    const int key = encode(ax, ay);
-                    if (seenAnchors.insert(key).second) {
-                        orderedAnchors.emplace_back(ax, ay);
-                    }
+    std::vector<Polygon> polygons(components.size());
+
+    // Quads cover [-1, width - 1] x [-1, height - 1] so outlines close around border cells.
+    // Quad column qx sits at bit qx + 1, which the spare bit in every row leaves room for.
+    for (int qy = -1; qy < height; ++qy) {
+        for (int w = 0; w < cells.getWordsPerRow(); ++w) {
+            const MarchQuadWord q = getMarchQuad(qy, w);
+            // cases 0 and 15 emit nothing
+            uint64_t boundary = (q.c1 | q.c2 | q.c4 | q.c8) & ~(q.c1 & q.c2 & q.c4 & q.c8);
+            while (boundary != 0) {
+                const int bit = std::countr_zero(boundary);
+                boundary &= boundary - 1;
+
+                const int idx = static_cast<int>((q.c1 >> bit) & 1ull)
+                              | static_cast<int>((q.c2 >> bit) & 1ull) << 1
+                              | static_cast<int>((q.c4 >> bit) & 1ull) << 2
+                              | static_cast<int>((q.c8 >> bit) & 1ull) << 3;
+                const int qx = w * 64 + bit - 1;
+
+                // the set corners of one quad are 8-connected, so any set corner names the component
+                int cx, cy;
+                if (idx & 1)      { cx = qx;     cy = qy; }
+                else if (idx & 2) { cx = qx + 1; cy = qy; }
+                else if (idx & 4) { cx = qx + 1; cy = qy + 1; }
+                else              { cx = qx;     cy = qy + 1; }
+                const int component = labels[static_cast<std::size_t>(cy) * static_cast<std::size_t>(width) + static_cast<std::size_t>(cx)];
+                assert(component >= 0);
+
+                const glm::vec2 origin(static_cast<float>(qx), static_cast<float>(qy));
+                for (const auto& e : marchCases[static_cast<std::size_t>(idx)]) {
+                    polygons[static_cast<std::size_t>(component)].add(origin + e.a, origin + e.b);
                 }
             }
         }
+    }
 
-        for (const auto& [qx, qy] : orderedAnchors) {
-            const int idx = getMarchQuad(qx, qy);
-            for (const auto& e : marchCases[static_cast<std::size_t>(idx)]) {
-                polygon.add(glm::vec2(static_cast<float>(qx), static_cast<float>(qy)) + e.a,
-                    glm::vec2(static_cast<float>(qx), static_cast<float>(qy)) + e.b);
-            }
-        }
-
+    std::vector<MarchComponentGeometry> out;
+    out.reserve(polygons.size());
+    for (Polygon& polygon : polygons) {
         polygon.earcut();
 
         MarchComponentGeometry geom;
         geom.filledVertices = polygon.filledVerts();
         geom.filledIndices = polygon.filledIndices();
         geom.convexPieces = std::move(polygon.decompose());
-        ++componentIndex;
         out.push_back(std::move(geom));
     }
 
     return out;
 }
 
-} // namespace bsk::internal
\ No newline at end of file
+} // namespace bsk::internal
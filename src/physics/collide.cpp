@@ -65,8 +65,9 @@ int Manifold::collide(
 
 // The normal points from A to B
 int Manifold::collide(Rigid* bodyA, Rigid* bodyB, Contact* contacts) {
-	std::vector<glm::vec2> verticesA;
-	std::vector<glm::vec2> verticesB;
+	// reused between calls, every manifold collides once per step
+	thread_local std::vector<glm::vec2> verticesA;
+	thread_local std::vector<glm::vec2> verticesB;
 	getTransformedVertices(bodyA, verticesA);
 	getTransformedVertices(bodyB, verticesB);
 
@@ -83,7 +84,7 @@ int Manifold::collide(Rigid* bodyA, Rigid* bodyB, Contact* contacts) {
 }
 
 int Manifold::collide(Rigid* bodyA, const std::vector<glm::vec2>& worldVerticesB, Contact* contacts) {
-	std::vector<glm::vec2> verticesA;
+	thread_local std::vector<glm::vec2> verticesA;
 	getTransformedVertices(bodyA, verticesA);
 
 	const int numContacts = collide(verticesA, worldVerticesB, contacts);
@@ -60,6 +60,75 @@ void BVH::insert(Rigid* rigid) {
     size++;
 }
 
+/**
+ * @brief Insert many rigids at once. Inserting one by one walks the tree for every rigid, so the tree is instead
+ *        rebuilt top down over the existing and new rigids together, splitting at the median along the longest axis.
+ *
+ * @param rigids Rigids not yet in the tree
+ */
+void BVH::insert(const std::vector<Rigid*>& rigids) {
+    if (rigids.empty()) return;
+
+    std::vector<Rigid*> allRigids;
+    allRigids.reserve(primitives.size() + rigids.size());
+    for (auto& [rigid, _] : primitives) {
+        allRigids.push_back(rigid);
+    }
+    for (Rigid* rigid : rigids) {
+        if (rigid != nullptr && primitives.find(rigid) == primitives.end()) {
+            allRigids.push_back(rigid);
+        }
+    }
+
+    // Clear tree
+    delete root;
+    root = nullptr;
+    primitives.clear();
+    primitives.reserve(allRigids.size());
+    size = 0;
+    if (allRigids.empty()) return;
+
+    std::vector<Primitive*> leaves;
+    leaves.reserve(allRigids.size());
+    for (Rigid* rigid : allRigids) {
+        glm::vec2 bl, tr;
+        rigid->getAABB(bl, tr);
+        Primitive* primitive = new Primitive(bl, tr, rigid);
+        primitives[rigid] = primitive;
+        leaves.push_back(primitive);
+    }
+
+    root = build(leaves, 0, leaves.size());
+    root->setParent(nullptr);
+    size = leaves.size();
+}
+
+/**
+ * @brief Build a subtree over leaves[begin, end), reordering that range in place
+ *
+ * @return Primitive* Root of the subtree
+ */
+Primitive* BVH::build(std::vector<Primitive*>& leaves, size_t begin, size_t end) {
+    if (end - begin == 1) return leaves[begin];
+
+    // split along the axis the leaf centers spread the most, centers compared doubled to skip the halving
+    glm::vec2 low(std::numeric_limits<float>::max());
+    glm::vec2 high(std::numeric_limits<float>::lowest());
+    for (size_t i = begin; i < end; i++) {
+        glm::vec2 center = leaves[i]->getBL() + leaves[i]->getTR();
+        low = glm::min(low, center);
+        high = glm::max(high, center);
+    }
+    int axis = (high.x - low.x >= high.y - low.y) ? 0 : 1;
+
+    size_t mid = begin + (end - begin) / 2;
+    std::nth_element(leaves.begin() + begin, leaves.begin() + mid, leaves.begin() + end, [axis](Primitive* a, Primitive* b) {
+        return a->getBL()[axis] + a->getTR()[axis] < b->getBL()[axis] + b->getTR()[axis];
+    });
+
+    return new Primitive(build(leaves, begin, mid), build(leaves, mid, end));
+}
+
 void BVH::remove(Rigid* rigid) {
     if (rigid == nullptr) return;
 
@@ -184,6 +253,14 @@ std::vector<Rigid*> BVH::query(Rigid* rigid) const {
     return query(bl, tr);
 }
 
+void BVH::query(Rigid* rigid, std::vector<Rigid*>& results) const {
+    results.clear();
+    if (rigid == nullptr || root == nullptr) return;
+    glm::vec2 bl, tr;
+    rigid->getAABB(bl, tr);
+    root->query(bl, tr, results);
+}
+
 std::vector<PrimitiveInfo> BVH::getAllPrimitives() const {
     std::vector<PrimitiveInfo> results;
     if (root != nullptr) {
@@ -8,6 +8,8 @@ namespace bsk::internal {
 Force::Force(Solver* solver, Rigid* bodyA, Rigid* bodyB)
     : solver(solver), forceTable(solver->getForceTable()), bodyA(bodyA), bodyB(bodyB), next(nullptr), nextA(nullptr), nextB(nullptr), prev(nullptr), prevA(nullptr), prevB(nullptr)
 {
+    solver->finishStep(); // the solver may be stepping on its own thread
+
     // Add to solver linked list
     solver->insert(this);
     solver->getForceTable()->insert(this);
@@ -23,6 +25,8 @@ Force::Force(Solver* solver, Rigid* bodyA, Rigid* bodyB)
 }
 
 Force::~Force() {
+    solver->finishStep(); // the solver may be stepping on its own thread
+
     // Remove from solver linked list
     solver->remove(this);
     solver->getForceTable()->markAsDeleted(this->index);
@@ -54,36 +58,36 @@ void Force::disable() {
 }
 
 // getters
-bsk::vec3& Force::getJ(int index) const { return forceTable->getJ(this->index, index); }
-bsk::mat3x3& Force::getH(int index) const { return forceTable->getH(this->index, index); }
-float Force::getC(int index) const { return forceTable->getC(this->index, index); }
-float Force::getFmin(int index) const { return forceTable->getFmin(this->index, index); }
-float Force::getFmax(int index) const { return forceTable->getFmax(this->index, index); }
-float Force::getStiffness(int index) const { return forceTable->getStiffness(this->index, index); }
-float Force::getFracture(int index) const { return forceTable->getFracture(this->index, index); }
-float Force::getPenalty(int index) const { return forceTable->getPenalty(this->index, index); }
-float Force::getLambda(int index) const { return forceTable->getLambda(this->index, index); }
+bsk::vec3& Force::getJ(int index) const { solver->finishStep(); return forceTable->getJ(this->index, index); }
+bsk::mat3x3& Force::getH(int index) const { solver->finishStep(); return forceTable->getH(this->index, index); }
+float Force::getC(int index) const { solver->finishStep(); return forceTable->getC(this->index, index); }
+float Force::getFmin(int index) const { solver->finishStep(); return forceTable->getFmin(this->index, index); }
+float Force::getFmax(int index) const { solver->finishStep(); return forceTable->getFmax(this->index, index); }
+float Force::getStiffness(int index) const { solver->finishStep(); return forceTable->getStiffness(this->index, index); }
+float Force::getFracture(int index) const { solver->finishStep(); return forceTable->getFracture(this->index, index); }
+float Force::getPenalty(int index) const { solver->finishStep(); return forceTable->getPenalty(this->index, index); }
+float Force::getLambda(int index) const { solver->finishStep(); return forceTable->getLambda(this->index, index); }
 
-glm::vec3 Force::getPosA() const { return forceTable->getPosA(index); }
-glm::vec3 Force::getPosB() const { return forceTable->getPosB(index); }
-glm::vec3 Force::getInitialA() const { return forceTable->getInitialA(index); }
-glm::vec3 Force::getInitialB() const { return forceTable->getInitialB(index); }
-ForceType Force::getForceType() const { return forceTable->getForceType(index); }
+glm::vec3 Force::getPosA() const { solver->finishStep(); return forceTable->getPosA(index); }
+glm::vec3 Force::getPosB() const { solver->finishStep(); return forceTable->getPosB(index); }
+glm::vec3 Force::getInitialA() const { solver->finishStep(); return forceTable->getInitialA(index); }
+glm::vec3 Force::getInitialB() const { solver->finishStep(); return forceTable->getInitialB(index); }
+ForceType Force::getForceType() const { solver->finishStep(); return forceTable->getForceType(index); }
 
 // setters
-void Force::setJ(int index, const glm::vec3& value) { forceTable->setJ(this->index, index, value); }
-void Force::setH(int index, const glm::mat3& value) { forceTable->setH(this->index, index, value); }
-void Force::setC(int index, float value) { forceTable->setC(this->index, index, value); }
-void Force::setFmin(int index, float value) { forceTable->setFmin(this->index, index, value); }
-void Force::setFmax(int index, float value) { forceTable->setFmax(this->index, index, value); }
-void Force::setStiffness(int index, float value) { forceTable->setStiffness(this->index, index, value); }
-void Force::setFracture(int index, float value) { forceTable->setFracture(this->index, index, value); }
-void Force::setPenalty(int index, float value) { forceTable->setPenalty(this->index, index, value); }
-void Force::setLambda(int index, float value) { forceTable->setLambda(this->index, index, value); }
+void Force::setJ(int index, const glm::vec3& value) { solver->finishStep(); forceTable->setJ(this->index, index, value); }
+void Force::setH(int index, const glm::mat3& value) { solver->finishStep(); forceTable->setH(this->index, index, value); }
+void Force::setC(int index, float value) { solver->finishStep(); forceTable->setC(this->index, index, value); }
+void Force::setFmin(int index, float value) { solver->finishStep(); forceTable->setFmin(this->index, index, value); }
+void Force::setFmax(int index, float value) { solver->finishStep(); forceTable->setFmax(this->index, index, value); }
+void Force::setStiffness(int index, float value) { solver->finishStep(); forceTable->setStiffness(this->index, index, value); }
+void Force::setFracture(int index, float value) { solver->finishStep(); forceTable->setFracture(this->index, index, value); }
+void Force::setPenalty(int index, float value) { solver->finishStep(); forceTable->setPenalty(this->index, index, value); }
+void Force::setLambda(int index, float value) { solver->finishStep(); forceTable->setLambda(this->index, index, value); }
 
-void Force::setPosA(const glm::vec3& value) { forceTable->setPosA(index, value); }
-void Force::setPosB(const glm::vec3& value) { forceTable->setPosB(index, value); }
-void Force::setInitialA(const glm::vec3& value) { forceTable->setInitialA(index, value); }
-void Force::setInitialB(const glm::vec3& value) { forceTable->setInitialB(index, value); }
-void Force::setForceType(ForceType value) { forceTable->setForceType(index, value); }
+void Force::setPosA(const glm::vec3& value) { solver->finishStep(); forceTable->setPosA(index, value); }
+void Force::setPosB(const glm::vec3& value) { solver->finishStep(); forceTable->setPosB(index, value); }
+void Force::setInitialA(const glm::vec3& value) { solver->finishStep(); forceTable->setInitialA(index, value); }
+void Force::setInitialB(const glm::vec3& value) { solver->finishStep(); forceTable->setInitialB(index, value); }
+void Force::setForceType(ForceType value) { solver->finishStep(); forceTable->setForceType(index, value); }
 }
\ No newline at end of file
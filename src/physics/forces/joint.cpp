@@ -28,6 +28,8 @@ Joint::Joint(Solver* solver, Rigid* bodyA, Rigid* bodyB, glm::vec2 rA, glm::vec2
 }
 
 Joint::~Joint() {
+    solver->finishStep(); // runs before ~Force, which would otherwise be the first to wait
+
     // unregister from joint table
     solver->getForceTable()->getJointTable()->markAsDeleted(this->specialIndex);
 }
@@ -86,8 +88,8 @@ void Joint::computeDerivatives(ForceTable* forceTable, uint32_t specialIndex, ui
 }
 
 // Getters
-JointStruct& Joint::getData() { return solver->getForceTable()->getJointTable()->getData(specialIndex); }
-const JointStruct& Joint::getData() const { return solver->getForceTable()->getJointTable()->getData(specialIndex); }
+JointStruct& Joint::getData() { solver->finishStep(); return solver->getForceTable()->getJointTable()->getData(specialIndex); }
+const JointStruct& Joint::getData() const { solver->finishStep(); return solver->getForceTable()->getJointTable()->getData(specialIndex); }
 glm::vec2 Joint::getRA() const { return getData().rA; }
 glm::vec2 Joint::getRB() const { return getData().rB; }
 glm::vec3 Joint::getC0() const { return getData().C0; }
@@ -38,6 +38,8 @@ Manifold::Manifold(Solver* solver, Rigid* bodyA, const std::vector<glm::vec2>& w
 }
 
 Manifold::~Manifold() {
+    solver->finishStep(); // runs before ~Force, which would otherwise be the first to wait
+
     // unregister from manifold table
     solver->getForceTable()->getManifoldTable()->markAsDeleted(this->specialIndex);
 }
@@ -175,8 +177,8 @@ Contact& Manifold::getContactRef(int index) { return getData().contacts[index];
 int Manifold::getNumContacts() const { return getData().numContacts; }
 float Manifold::getFriction() const { return getData().friction; }
 const Contact& Manifold::getContact(int index) const { return getData().contacts[index]; }
-ManifoldData& Manifold::getData() { return solver->getForceTable()->getManifoldTable()->getData(specialIndex); }
-const ManifoldData& Manifold::getData() const { return solver->getForceTable()->getManifoldTable()->getData(specialIndex); }
+ManifoldData& Manifold::getData() { solver->finishStep(); return solver->getForceTable()->getManifoldTable()->getData(specialIndex); }
+const ManifoldData& Manifold::getData() const { solver->finishStep(); return solver->getForceTable()->getManifoldTable()->getData(specialIndex); }
 
 // setters
 void Manifold::setData(const ManifoldData& value) { getData() = value; }
@@ -19,6 +19,8 @@ Motor::Motor(Solver* solver, Rigid* bodyA, Rigid* bodyB, float speed, float maxT
 }
 
 Motor::~Motor() {
+    solver->finishStep(); // runs before ~Force, which would otherwise be the first to wait
+
     // unregister from motor table
     solver->getForceTable()->getMotorTable()->markAsDeleted(this->specialIndex);
 }
@@ -49,8 +51,8 @@ void Motor::computeDerivatives(ForceTable* forceTable, uint32_t specialIndex, ui
 }
 
 // Getters
-MotorStruct& Motor::getData() { return solver->getForceTable()->getMotorTable()->getData(specialIndex); }
-const MotorStruct& Motor::getData() const { return solver->getForceTable()->getMotorTable()->getData(specialIndex); }
+MotorStruct& Motor::getData() { solver->finishStep(); return solver->getForceTable()->getMotorTable()->getData(specialIndex); }
+const MotorStruct& Motor::getData() const { solver->finishStep(); return solver->getForceTable()->getMotorTable()->getData(specialIndex); }
 float Motor::getSpeed() const { return getData().speed; }
 
 // Setters
@@ -25,6 +25,8 @@ Spring::Spring(Solver* solver, Rigid* bodyA, Rigid* bodyB, glm::vec2 rA, glm::ve
 }
 
 Spring::~Spring() {
+    solver->finishStep(); // runs before ~Force, which would otherwise be the first to wait
+
     // unregister from spring table
     solver->getForceTable()->getSpringTable()->markAsDeleted(this->specialIndex);
 }
@@ -92,8 +94,8 @@ void Spring::computeDerivatives(ForceTable* forceTable, uint32_t specialIndex, u
 }
 
 // Getters
-SpringStruct& Spring::getData() { return solver->getForceTable()->getSpringTable()->getData(specialIndex); }
-const SpringStruct& Spring::getData() const { return solver->getForceTable()->getSpringTable()->getData(specialIndex); }
+SpringStruct& Spring::getData() { solver->finishStep(); return solver->getForceTable()->getSpringTable()->getData(specialIndex); }
+const SpringStruct& Spring::getData() const { solver->finishStep(); return solver->getForceTable()->getSpringTable()->getData(specialIndex); }
 glm::vec2 Spring::getRA() const { return getData().rA; }
 glm::vec2 Spring::getRB() const { return getData().rB; }
 float Spring::getRest() const { return getData().rest; }
@@ -12,12 +12,16 @@ namespace bsk::internal {
 
 Rigid::Rigid(Solver* solver, Node2D* node, Collider* collider, glm::vec3 position, glm::vec2 size, float density, float friction, glm::vec3 velocity)
     : solver(solver), node(node), forces(nullptr), next(nullptr), prev(nullptr), collider(collider), degree(0), satur(0) {
+    solver->finishStep(); // the solver may be stepping on its own thread
+
     // Add to linked list
     solver->insert(this);
     this->solver->getBodyTable()->insert(this, position, size, density, friction, velocity, collider);
 }
 
 Rigid::~Rigid() {
+    solver->finishStep(); // the solver may be stepping on its own thread
+
     // Remove from linked list
     solver->remove(this);
 
@@ -35,6 +39,7 @@ Rigid::~Rigid() {
 }
 
 bool Rigid::constrainedTo(Rigid* other) const {
+    this->solver->finishStep();
     // Check if this body is constrained to the other body
     for (Force* f = forces; f != nullptr; f = (f->getBodyA() == this) ? f->getNextA() : f->getNextB())
         if ((f->getBodyA() == this && f->getBodyB() == other) || (f->getBodyA() == other && f->getBodyB() == this))
@@ -43,6 +48,7 @@ bool Rigid::constrainedTo(Rigid* other) const {
 }
 
 void Rigid::resetColoring() {
+    this->solver->finishStep();
     setColor(-1);
     setDegree(0);
     setSatur(0);
@@ -98,6 +104,7 @@ bool Rigid::verifyColoring() const {
 }
 
 void Rigid::insert(Force* force) {
+    this->solver->finishStep();
     if (force == nullptr) {
         return;
     }
@@ -136,6 +143,7 @@ void Rigid::insert(Force* force) {
 }
 
 void Rigid::remove(Force* force) {
+    this->solver->finishStep();
     if (force == nullptr) {
         return;
     }
@@ -180,68 +188,84 @@ void Rigid::remove(Force* force) {
 }
 
 void Rigid::setPosition(const glm::vec3& pos) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setPos(this->index, pos);
 }
 
 void Rigid::setScale(const glm::vec2& scale) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setScale(this->index, scale);
 }
 
 void Rigid::setVelocity(const glm::vec3& vel) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setVel(this->index, vel);
 }
 
 glm::vec3 Rigid::getVelocity() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getVel(this->index);
 }
 
 glm::vec3& Rigid::getVelocityRef() {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getVel(this->index);
 }
 
 float Rigid::getDensity() const {
+    this->solver->finishStep();
     float mass = this->solver->getBodyTable()->getMass(this->index);
     glm::vec2 size = this->solver->getBodyTable()->getScale(this->index);
     return mass / (size.x * size.y);
 }
 
 float Rigid::getFriction() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getFriction(this->index);
 }
 
 glm::vec3 Rigid::getVel() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getVel(this->index);
 }
 
 void Rigid::setInitial(const glm::vec3& initial) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setInitial(this->index, initial);
 }
 
 void Rigid::setInertial(const glm::vec3& inertial) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setInertial(this->index, inertial);
 }
 
 void Rigid::setPrevVelocity(const glm::vec3& prevVelocity) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setPrevVel(this->index, prevVelocity);
 }
 
 void Rigid::setMass(float mass) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setMass(this->index, mass);
 }
 
 void Rigid::setMoment(float moment) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setMoment(this->index, moment);
 }
 
 void Rigid::setFriction(float friction) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setFriction(this->index, friction);
 }
 
 void Rigid::setRadius(float radius) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setRadius(this->index, radius);
 }
 
 void Rigid::setColor(int color) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setColor(this->index, color);
 }
 
@@ -254,6 +278,7 @@ void Rigid::setSatur(int satur) {
 }
 
 void Rigid::setCollider(Collider* collider) {
+    this->solver->finishStep();
     this->collider = collider;
 }
 
@@ -278,42 +303,52 @@ void Rigid::setIndex(uint32_t index) {
 }
 
 void Rigid::setDensity(float density) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setDensity(this->index, density);
 }
 
 glm::vec3 Rigid::getPosition() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getPos(this->index);
 }
 
 glm::vec3 Rigid::getInitial() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getInitial(this->index);
 }
 
 glm::vec3 Rigid::getInertial() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getInertial(this->index);
 }
 
 glm::vec3 Rigid::getPrevVelocity() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getPrevVel(this->index);
 }
 
 glm::vec2 Rigid::getSize() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getScale(this->index);
 }
 
 float Rigid::getMass() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getMass(this->index);
 }
 
 float Rigid::getMoment() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getMoment(this->index);
 }
 
 float Rigid::getRadius() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getRadius(this->index);
 }
 
 int Rigid::getColor() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getColor(this->index);
 }
 
@@ -358,6 +393,7 @@ void Rigid::getAABB(glm::vec2& bl, glm::vec2& tr) const {
 }
 
 std::vector<CollisionData> Rigid::getCollisions() {
+    this->solver->finishStep();
     std::vector<CollisionData> collisions;
 
     // iterate through all forces
@@ -419,11 +455,28 @@ std::vector<CollisionData> Rigid::getCollisions() {
     return collisions;
 }
 
+void Rigid::setResolvesCollisions(bool resolvesCollisions) {
+    this->solver->finishStep();
+    this->resolvesCollisions = resolvesCollisions;
+}
+
+void Rigid::setCollisionGroup(int group) {
+    this->solver->finishStep();
+    this->collisionGroup = group;
+}
+
+void Rigid::setHasGravity(bool hasGravity) {
+    this->solver->finishStep();
+    this->hasGravity = hasGravity;
+}
+
 void Rigid::setJacobianMask(const glm::vec3& jacobianMask) {
+    this->solver->finishStep();
     this->solver->getBodyTable()->setJacobianMask(this->index, jacobianMask);
 }
 
 glm::vec3 Rigid::getJacobianMask() const {
+    this->solver->finishStep();
     return this->solver->getBodyTable()->getJacobianMask(this->index);
 }
 
@@ -446,4 +499,4 @@ bool Rigid::pointCollision(const glm::vec2& worldPoint, glm::vec2& local) {
     return true;
 }
 
-}
\ No newline at end of file
+}
@@ -20,6 +20,8 @@
 
 namespace bsk::internal {
 
+thread_local bool Solver::onSolverThread = false;
+
 // Continuous grid coordinates (same convention as marching / particles.wgsl) -> world space.
 static glm::vec2 gridPixelToWorld(const CellBuffer* cellBuffer, float px, float py) {
     const float cs = cellBuffer->getCellScale();
@@ -33,13 +35,7 @@ static glm::vec2 sandCellCenterWorld(const CellBuffer* cellBuffer, int px, int p
     return gridPixelToWorld(cellBuffer, static_cast<float>(px) + 0.5f, static_cast<float>(py) + 0.5f);
 }
 
-std::optional<glm::ivec2> Solver::fillSandGridFromRigidAABB(
-    Rigid* body,
-    std::vector<std::vector<int>>& sand,
-    bool includeFluid,
-    bool skipSparseNonStatic
-) const {
-    sand.clear();
+std::optional<glm::ivec4> Solver::sandPixelRect(Rigid* body) const {
     if (body == nullptr || cellBuffer == nullptr || bodyTable == nullptr) {
         return std::nullopt;
     }
@@ -66,38 +62,55 @@ std::optional<glm::ivec2> Solver::fillSandGridFromRigidAABB(
     if (bl_x > tr_x || bl_y > tr_y) {
         return std::nullopt;
     }
+    return glm::ivec4(bl_x, bl_y, tr_x, tr_y);
+}
 
-    auto is_occupied_for_mask = [&](int px, int py) -> bool {
-        const Color c = cellBuffer->getActivePixel(px, py);
-        if (c.getMatId() == 0) {
-            return false;
-        }
-        if (!includeFluid && is_fluid(c)) {
-            return false;
-        }
-        return true;
-    };
-
-    sand.assign(static_cast<std::size_t>(tr_x - bl_x + 1), std::vector<int>(static_cast<std::size_t>(tr_y - bl_y + 1), 0));
-    for (int x = bl_x; x <= tr_x; x++) {
-        for (int y = bl_y; y <= tr_y; y++) {
-            const Color color = cellBuffer->getActivePixel(x, y);
+std::optional<glm::ivec2> Solver::fillSandGridFromRigidAABB(
+    Rigid* body,
+    MarchBitset& sand,
+    bool includeFluid,
+    bool skipSparseNonStatic
+) const {
+    sand.reset(0, 0);
+    const std::optional<glm::ivec4> rect = sandPixelRect(body);
+    if (!rect) {
+        return std::nullopt;
+    }
+    const int bl_x = rect->x;
+    const int bl_y = rect->y;
+    const int tr_x = rect->z;
+    const int tr_y = rect->w;
+
+    const int w = tr_x - bl_x + 1;
+    const int h = tr_y - bl_y + 1;
+    sand.reset(w, h);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            const Color color = cellBuffer->getActivePixel(bl_x + x, bl_y + y);
             if (color.getMatId() == 0 || (!includeFluid && is_fluid(color))) {
                 continue;
             }
+            sand.set(x, y);
+        }
+    }
 
-            if (skipSparseNonStatic) {
-                int neighbors = 0;
-                if (x > bl_x && is_occupied_for_mask(x - 1, y)) { neighbors++; }
-                if (x < tr_x && is_occupied_for_mask(x + 1, y)) { neighbors++; }
-                if (y > bl_y && is_occupied_for_mask(x, y - 1)) { neighbors++; }
-                if (y < tr_y && is_occupied_for_mask(x, y + 1)) { neighbors++; }
-                if (neighbors <= 2) {
-                    continue;
-                }
+    if (skipSparseNonStatic) {
+        // Keep cells with at least 3 of their 4 edge neighbours occupied inside the AABB,
+        // 64 cells at a time. The tests read the unfiltered rows, so filter into a copy.
+        const MarchBitset occupied = sand;
+        const int words = occupied.getWordsPerRow();
+        for (int y = 0; y < h; y++) {
+            const uint64_t* row = occupied.row(y);
+            const uint64_t* below = y > 0 ? occupied.row(y - 1) : nullptr;
+            const uint64_t* above = y + 1 < h ? occupied.row(y + 1) : nullptr;
+            uint64_t* out = sand.row(y);
+            for (int i = 0; i < words; i++) {
+                const uint64_t l = (row[i] << 1) | (i > 0 ? row[i - 1] >> 63 : 0ull);
+                const uint64_t r = (row[i] >> 1) | (i + 1 < words ? row[i + 1] << 63 : 0ull);
+                const uint64_t d = below ? below[i] : 0ull;
+                const uint64_t u = above ? above[i] : 0ull;
+                out[i] = row[i] & ((l & r & (u | d)) | (u & d & (l | r)));
             }
-
-            sand[static_cast<std::size_t>(x - bl_x)][static_cast<std::size_t>(y - bl_y)] = 1;
         }
     }
     return glm::ivec2(bl_x, bl_y);
@@ -120,7 +133,9 @@ Solver::Solver(int cellWidth, int cellHeight, float cellScale) :
     currentAlpha(0.0f),
     currentColor(0),
     running(true),
-    workers()
+    workers(),
+    stepStart(0),
+    stepFinish(0)
 {
     this->bodyTable = new BodyTable(this, 8, velocityShader);
 
@@ -147,6 +162,8 @@ Solver::~Solver() {
 }
 
 void Solver::clear() {
+    finishStep();
+
     while (forces)
         delete forces;
 
@@ -171,6 +188,12 @@ void Solver::clear() {
 
     for (auto& w : workers)
         w.join();
+
+    if (stepThread.joinable()) {
+        running.store(false, std::memory_order_release);
+        stepStart.release();
+        stepThread.join();
+    }
 }
 
 void Solver::insert(Rigid* body) {
@@ -251,6 +274,7 @@ void Solver::remove(Force* force) {
 }
 
 void Solver::defaultParams() {
+    finishStep();
     gravity = { 0.0f, -9.81f, 0.0f };
     // gravity = std::nullopt;
     iterations = 10;
@@ -300,6 +324,7 @@ void Solver::remapSandManifoldForceIndices(const std::vector<uint32_t>& forceInd
 }
 
 void Solver::step(float dtIncoming) {    
+    finishStep();
     this->dt = glm::min(dtIncoming, 1.0f / 20.0f);
 
     // this is at the top so that the user can see the forces from the previous frame
@@ -318,6 +343,9 @@ void Solver::step(float dtIncoming) {
     }
     clearSandManifoldForceIndices();
 
+    // nothing from the last step is left using the arena now that its sand manifolds are gone
+    stepArena.reset();
+
     // compact body table
     bodyTable->compact();
 
@@ -325,12 +353,13 @@ void Solver::step(float dtIncoming) {
     bodyTable->getBVH()->update();
 
     // Use BVH to find potential collisions
+    std::vector<Rigid*> results;
     for (Rigid* bodyA = bodies; bodyA != nullptr; bodyA = bodyA->getNext()) {
 
         // if static, skip
         if (bodyA->getMass() <= 0.0f) continue;
 
-        std::vector<Rigid*> results = bodyTable->getBVH()->query(bodyA);
+        bodyTable->getBVH()->query(bodyA, results);
         for (Rigid* bodyB : results) {
             // Skip pairs in the same non-zero collision group (they ignore each other)
             // checking collision group is cheaper than constrained so it comes first
@@ -355,10 +384,11 @@ void Solver::step(float dtIncoming) {
     const float halfWidth = static_cast<float>(cellBuffer->getWidth()) * 0.5f;
     const float halfHeight = static_cast<float>(cellBuffer->getHeight()) * 0.5f;
 
+    std::vector<glm::vec2> worldVertices;
     for (Rigid* body = bodies; body != nullptr; body = body->getNext()) {
         if (body->getMass() <= 0.0f) continue;
 
-        std::vector<std::vector<int>> sand;
+        MarchBitset sand;
         const std::optional<glm::ivec2> aabbOrigin = fillSandGridFromRigidAABB(body, sand, false, true);
         if (!aabbOrigin) {
             continue;
@@ -367,7 +397,7 @@ void Solver::step(float dtIncoming) {
         const int bl_y = aabbOrigin->y;
 
         MarchingGrid grid(std::move(sand));
-        grid.bfs();
+        grid.labelComponents();
         std::vector<MarchComponentGeometry> marchGeom = grid.genMarch();
 
         // create manifold with rigid and all convex comps
@@ -375,8 +405,7 @@ void Solver::step(float dtIncoming) {
             for (const BayazitConvex& convex : geom.convexPieces) {
                 if (convex.vertices.size() < 3) continue;
 
-                std::vector<glm::vec2> worldVertices;
-                worldVertices.reserve(convex.vertices.size());
+                worldVertices.clear();
 
                 for (const glm::vec2& v : convex.vertices) {
                     // Marching output is local-to-AABB in pixel units.
@@ -478,6 +507,61 @@ void Solver::step(float dtIncoming) {
     }
 }
 
+/**
+ * @brief Start a step on the solver's step thread and return immediately. Until finishStep returns, nothing may
+ *        touch the solver, its tables or its bodies; nodes are safe to read because the step does not write them
+ *        while stepping asynchronously.
+ *
+ * @param dt Time per step, clamped as in step
+ * @param substeps Number of steps to run back to back
+ */
+void Solver::beginStep(float dt, int substeps) {
+    std::lock_guard<std::mutex> lock(stepMutex);
+    waitForStep();
+    if (!stepThread.joinable()) {
+        stepThread = std::thread(&Solver::stepLoop, this);
+    }
+
+    asyncDt = dt;
+    asyncSubsteps = substeps;
+    stepInFlight.store(true, std::memory_order_release);
+    stepStart.release();
+}
+
+/**
+ * @brief Wait for the step started by beginStep, if any. Every entry point that reads or writes solver state from
+ *        outside the step calls this first: rigids and forces on creation, destruction and through their accessors,
+ *        the solver's setters and queries, and the scene. A no-op on the solver's own threads and when the solver
+ *        is stepped inline.
+ *
+ */
+void Solver::finishStep() {
+    if (!stepInFlight.load(std::memory_order_acquire) || onSolverThread) return;
+    std::lock_guard<std::mutex> lock(stepMutex);
+    waitForStep();
+}
+
+// Caller holds stepMutex
+void Solver::waitForStep() {
+    if (!stepInFlight.load(std::memory_order_acquire)) return;
+    stepFinish.acquire();
+    stepInFlight.store(false, std::memory_order_release);
+    stepUncollected = true;
+}
+
+/**
+ * @brief Wait for the step started by beginStep and claim its results
+ *
+ * @return true if an asynchronous step finished since the last collect, so its poses still need publishing
+ */
+bool Solver::collectStep() {
+    finishStep();
+    std::lock_guard<std::mutex> lock(stepMutex);
+    bool collected = stepUncollected;
+    stepUncollected = false;
+    return collected;
+}
+
 // Coloring
 void Solver::resetColoring() {
     for (Rigid* body = bodies; body != nullptr; body = body->getNext()) {
@@ -492,7 +576,7 @@ void Solver::resetColoring() {
 
 void Solver::dsatur() {
     // Use a set instead of priority_queue for O(log n) updates
-    std::set<Rigid*, RigidComparator> colorSet;
+    std::pmr::set<Rigid*, RigidComparator> colorSet(&stepArena);
     std::vector<std::vector<ColorForce>> tempIndices;
 
     // add vector in temp indices for each force type
@@ -581,6 +665,7 @@ void Solver::dsatur() {
 }
 
 Rigid* Solver::pick(glm::vec2 at, glm::vec2& local) {
+    finishStep();
     // Find which body is at the given point
     for (Rigid* body = bodies; body != nullptr; body = body->getNext()) {
         if (body->pointCollision(at, local)) {
@@ -591,6 +676,7 @@ Rigid* Solver::pick(glm::vec2 at, glm::vec2& local) {
 }
 
 void Solver::rebuildVelocityShader() {
+    finishStep();
     delete velocityShader;
     velocityShader = nullptr;
 
@@ -608,6 +694,7 @@ void Solver::rebuildVelocityShader() {
 }
 
 bool Solver::isTouching(Rigid* rigid, int materialId) {
+    finishStep();
     if (rigid == nullptr || cellBuffer == nullptr) {
         return false;
     }
@@ -615,29 +702,15 @@ bool Solver::isTouching(Rigid* rigid, int materialId) {
 }
 
 bool Solver::isTouchingSand(Rigid* rigid, int materialId) {
-    if (rigid == nullptr || cellBuffer == nullptr) {
+    finishStep();
+    const std::optional<glm::ivec4> rect = sandPixelRect(rigid);
+    if (!rect) {
         return false;
     }
-    std::vector<std::vector<int>> sand;
-    const std::optional<glm::ivec2> origin = fillSandGridFromRigidAABB(rigid, sand, true);
-    if (!origin) {
-        return false;
-    }
-    const int bl_x = origin->x;
-    const int bl_y = origin->y;
-
-    for (std::size_t ix = 0; ix < sand.size(); ++ix) {
-        for (std::size_t iy = 0; iy < sand[ix].size(); ++iy) {
-            if (sand[ix][iy] == 0) {
-                continue;
-            }
-            const int px = bl_x + static_cast<int>(ix);
-            const int py = bl_y + static_cast<int>(iy);
-            const Color c = cellBuffer->getActivePixel(px, py);
-            if (c.getMatId() == 0) {
-                continue;
-            }
-            if (materialId != -1 && static_cast<int>(c.getMatId()) != materialId) {
+    for (int py = rect->y; py <= rect->w; ++py) {
+        for (int px = rect->x; px <= rect->z; ++px) {
+            const int mid = static_cast<int>(cellBuffer->getActivePixel(px, py).getMatId());
+            if (mid == 0 || (materialId != -1 && mid != materialId)) {
                 continue;
             }
 
@@ -652,64 +725,94 @@ bool Solver::isTouchingSand(Rigid* rigid, int materialId) {
 }
 
 bool Solver::isTouchingParticle(Rigid* rigid, int materialId) {
-    if (rigid == nullptr || cellBuffer == nullptr) {
+    finishStep();
+    const std::optional<glm::ivec4> rect = sandPixelRect(rigid);
+    if (!rect) {
         return false;
     }
-    const std::vector<Particle>& particles = cellBuffer->getParticles();
-    for (const Particle& particle : particles) {
-        if (particle.color == 0u) {
-            continue;
+    bool touching = false;
+    cellBuffer->forEachParticleInRect(rect->x, rect->y, rect->z, rect->w, [&](const Particle& particle) {
+        if (touching) {
+            return;
         }
-        const Color pColor = unpackCell(particle.color);
-        const int mid = static_cast<int>(pColor.mat_id);
-        if (materialId == -1) {
-            if (mid == 0) {
-                continue;
-            }
-        } else if (mid != materialId) {
-            continue;
+        const int mid = static_cast<int>(unpackCell(particle.color).getMatId());
+        if (mid == 0 || (materialId != -1 && mid != materialId)) {
+            return;
         }
 
         const glm::vec2 world = gridPixelToWorld(cellBuffer, particle.pos.x, particle.pos.y);
         glm::vec2 local;
-        if (!rigid->pointCollision(world, local)) {
-            continue;
-        }
-
-        return true;
-    }
-    return false;
+        touching = rigid->pointCollision(world, local);
+    });
+    return touching;
 }
 
 std::vector<CellParticle> Solver::getTouchedParticles(Rigid* rigid, int materialId) {
+    finishStep();
     std::vector<CellParticle> touchedParticles;
-    if (rigid == nullptr || cellBuffer == nullptr) {
+    const std::optional<glm::ivec4> rect = sandPixelRect(rigid);
+    if (!rect) {
         return touchedParticles;
     }
-    const std::vector<Particle>& particles = cellBuffer->getParticles();
-    for (const Particle& particle : particles) {
-        if (particle.color == 0u) {
-            continue;
-        }
+    cellBuffer->forEachParticleInRect(rect->x, rect->y, rect->z, rect->w, [&](const Particle& particle) {
         const Color pColor = unpackCell(particle.color);
-        const int mid = static_cast<int>(pColor.mat_id);
-        if (materialId == -1) {
+        const int mid = static_cast<int>(pColor.getMatId());
+        if (mid == 0 || (materialId != -1 && mid != materialId)) {
+            return;
+        }
+
+        const glm::vec2 world = gridPixelToWorld(cellBuffer, particle.pos.x, particle.pos.y);
+        glm::vec2 local;
+        if (rigid->pointCollision(world, local)) {
+            touchedParticles.emplace_back(world, particle.vel, pColor);
+        }
+    });
+    return touchedParticles;
+}
+
+void Solver::collectTouches(Rigid* rigid, CellTouchReport& report) {
+    const std::optional<glm::ivec4> rect = sandPixelRect(rigid);
+    if (!rect) {
+        return;
+    }
+
+    for (int py = rect->y; py <= rect->w; ++py) {
+        for (int px = rect->x; px <= rect->z; ++px) {
+            const unsigned char mid = cellBuffer->getActivePixel(px, py).getMatId();
             if (mid == 0) {
                 continue;
             }
-        } else if (mid != materialId) {
-            continue;
+            const glm::vec2 world = sandCellCenterWorld(cellBuffer, px, py);
+            glm::vec2 local;
+            if (rigid->pointCollision(world, local)) {
+                report.sand[mid]++;
+            }
         }
+    }
 
+    cellBuffer->forEachParticleInRect(rect->x, rect->y, rect->z, rect->w, [&](const Particle& particle) {
+        const unsigned char mid = unpackCell(particle.color).getMatId();
+        if (mid == 0) {
+            return;
+        }
         const glm::vec2 world = gridPixelToWorld(cellBuffer, particle.pos.x, particle.pos.y);
         glm::vec2 local;
-        if (!rigid->pointCollision(world, local)) {
-            continue;
+        if (rigid->pointCollision(world, local)) {
+            report.particles[mid]++;
         }
+    });
+}
 
-        touchedParticles.emplace_back(world, particle.vel, pColor);
+std::vector<CellTouchReport> Solver::queryTouches(const std::vector<Rigid*>& rigids) {
+    finishStep();
+    std::vector<CellTouchReport> reports(rigids.size());
+    if (cellBuffer == nullptr) {
+        return reports;
     }
-    return touchedParticles;
+    for (std::size_t i = 0; i < rigids.size(); ++i) {
+        collectTouches(rigids[i], reports[i]);
+    }
+    return reports;
 }
 
 }
\ No newline at end of file
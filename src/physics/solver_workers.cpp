@@ -16,6 +16,7 @@ namespace bsk::internal {
 
 void Solver::workerLoop(unsigned int threadID) {
     ThreadScratch scratch;
+    onSolverThread = true;
 
     while (true) {
         startSignal.acquire();
@@ -45,6 +46,21 @@ void Solver::workerLoop(unsigned int threadID) {
     }
 }
 
+// Runs whole steps handed over by beginStep, the semaphores order the step's writes before finishStep returns
+void Solver::stepLoop() {
+    onSolverThread = true;
+    while (true) {
+        stepStart.acquire();
+        if (!running.load(std::memory_order_acquire))
+            return;
+
+        for (int i = 0; i < asyncSubsteps; i++) {
+            step(asyncDt);
+        }
+        stepFinish.release();
+    }
+}
+
 // ------------------------------------------------------------
 // Primal Stage
 // ------------------------------------------------------------
@@ -10,6 +10,12 @@
 
 namespace bsk::internal {
 
+// Push a solved pose to the node without writing it back to the body. Node2D::setRenderPose returns early
+// for an unchanged pose, so resting bodies keep a clean model for their subtree.
+static void syncNodePosition(Node2D* node, const glm::vec3& pos) {
+    node->setRenderPose(pos);
+}
+
 BodyTable::BodyTable(Solver* solver, uint32_t capacity, ComputeShader*& velocityShader) : 
     solver(solver),
     bvh(new BVH()),
@@ -115,8 +121,8 @@ void BodyTable::updateVelocities(float dt) {
     velStagingBuffer->collect(vel.data(), vel.size());
     prevVelStagingBuffer->collect(prevVel.data(), prevVel.size());
 
-    for (uint32_t i = 0; i < size; i++) {
-        bodies[i]->getNode()->setPosition(pos[i]);
+    if (syncNodes) {
+        writeToNodes();
     }
 }
 
@@ -131,6 +137,7 @@ void BodyTable::writeToGpu() {
 void BodyTable::markAsDeleted(uint32_t index) {
     toDelete[index] = true;
     bodies[index] = nullptr;
+    idRows[ids[index]] = NO_ROW;
 }
 
 void BodyTable::resize(uint32_t newCapacity) {
@@ -139,10 +146,11 @@ void BodyTable::resize(uint32_t newCapacity) {
     const bool hadGpuResources = (capacity > 0);
 
     expandTensors(newCapacity,
-    bodies, toDelete, pos, initial, inertial, vel, prevVel, scale, friction, radius, mass, moment, collider, mat, imat, rmat, updated, color, sleeping, jacobianMask, indexMap
+    bodies, toDelete, pos, initial, inertial, vel, prevVel, scale, friction, radius, mass, moment, collider, mat, imat, rmat, updated, color, sleeping, jacobianMask, indexMap, ids
     );
 
     capacity = newCapacity;
+    layoutVersion++;
 
     // Recreate GPU buffers and velocity shader only when growing an already-initialized table.
     // Skip on first call from constructor (capacity was 0, velocityShader not yet created).
@@ -181,10 +189,11 @@ void BodyTable::compact() {
 
     // TODO check to see who needs to be compacted and who will just get cleared anyway
     compactTensors(toDelete, size,
-bodies, pos, initial, inertial, vel, prevVel, scale, friction, radius, mass, moment, collider, mat, imat, rmat, updated, color, sleeping, jacobianMask
+bodies, pos, initial, inertial, vel, prevVel, scale, friction, radius, mass, moment, collider, mat, imat, rmat, updated, color, sleeping, jacobianMask, ids
     );
 
     size = active;
+    layoutVersion++;
 
     // remap body indices
     solver->getForceTable()->remapBodyIndices();
@@ -192,6 +201,7 @@ bodies, pos, initial, inertial, vel, prevVel, scale, friction, radius, mass, mom
     for (uint32_t i = 0; i < size; i++) {
         toDelete[i] = false;
         bodies[i]->setIndex(i);
+        idRows[ids[i]] = i;
     }
 }
 
@@ -205,6 +215,7 @@ void BodyTable::insert(Rigid* body, glm::vec3 position, glm::vec2 size, float de
     this->toDelete[this->size] = false;
     this->sleeping[this->size] = false;
     this->pos[this->size] = position;
+    this->initial[this->size] = position; // so poses interpolated before its first step start where it spawned
     this->vel[this->size] = velocity;
     this->prevVel[this->size] = velocity;
     this->scale[this->size] = size;
@@ -218,19 +229,77 @@ void BodyTable::insert(Rigid* body, glm::vec3 position, glm::vec2 size, float de
     this->rmat[this->size] = glm::mat2x2(1.0f);
     this->updated[this->size] = false;
     this->jacobianMask[this->size] = glm::vec3(1.0f, 1.0f, 1.0f);
+    this->ids[this->size] = (uint32_t)idRows.size();
+    idRows.push_back(this->size);
 
     body->setIndex(this->size);
     this->size++;
+    layoutVersion++;
 
     // insert into bvh
-    bvh->insert(body);
+    if (batching) {
+        batchedBodies.push_back(body);
+    } else {
+        bvh->insert(body);
+    }
+}
+
+/**
+ * @brief Make room for count more bodies with at most one resize, so a large spawn reallocates the columns,
+ *        the GPU buffers and the velocity shader once instead of once per doubling
+ *
+ * @param count Bodies about to be inserted
+ */
+void BodyTable::reserve(uint32_t count) {
+    uint32_t needed = this->size + count;
+    if (needed <= capacity) return;
+
+    uint32_t newCapacity = std::max(capacity, 1u);
+    while (newCapacity < needed) {
+        newCapacity *= 2;
+    }
+    resize(newCapacity);
+}
+
+/**
+ * @brief Hold back bvh insertion of the bodies inserted from here until endBatch
+ *
+ */
+void BodyTable::beginBatch() {
+    batching = true;
+}
+
+/**
+ * @brief Add every body inserted since beginBatch to the bvh in one bulk build
+ *
+ */
+void BodyTable::endBatch() {
+    batching = false;
+    bvh->insert(batchedBodies);
+    batchedBodies.clear();
 }
 
 void BodyTable::writeToNodes() {
     for (uint32_t i = 0; i < size; i++) {
-        Node2D* node = bodies[i]->getNode();
-        glm::vec3& pos = this->pos[i];
-        node->setPosition(pos);
+        if (bodies[i] == nullptr) continue; // removed, waiting for compact()
+        syncNodePosition(bodies[i]->getNode(), this->pos[i]);
+    }
+}
+
+// Push the poses of selected rows to their nodes, after a bulk write to the position column
+void BodyTable::writeToNodes(const uint32_t* rows, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        Rigid* body = bodies[rows[i]];
+        if (body == nullptr) continue; // removed, waiting for compact()
+        syncNodePosition(body->getNode(), this->pos[rows[i]]);
+    }
+}
+
+// Push poses blended between the start (alpha 0) and end (alpha 1) of the last step, bodies keep the solved pose
+void BodyTable::writeToNodes(float alpha) {
+    for (uint32_t i = 0; i < size; i++) {
+        if (bodies[i] == nullptr) continue; // removed, waiting for compact()
+        bodies[i]->getNode()->setRenderPose(glm::mix(this->initial[i], this->pos[i], alpha));
     }
 }
 
@@ -56,6 +56,7 @@ void Cubemap::applyImages(const std::vector<Image*>& faces) {
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
     // Upload the faces to the texture
     for (unsigned int i = 0; i < faces.size(); i++) {
+        faces[i]->wait();
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, faces[i]->getWidth(), faces[i]->getHeight(), 0, GL_RGBA, GL_UNSIGNED_BYTE, faces[i]->getData());
     }
 }
@@ -1,6 +1,8 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <basilisk/render/image.h>
 #include <basilisk/util/resolvePath.h>
+#include <basilisk/util/threadPool.h>
+#include <basilisk/engine/engine.h>
 #include <cstdlib>
 
 namespace bsk::internal {
@@ -9,16 +11,48 @@ namespace bsk::internal {
  * @brief Construct a new Image object from image file
  * 
  * @param file Path to the image to load
+ * @param flip_vertically Flip the rows so the first row is the bottom of the image
+ * @param async Decode on the loader pool and return immediately. The image is empty until isLoaded(),
+ *              and the texture server shows the default texture in its place until then.
  */
-Image::Image(std::string file, bool flip_vertically) {
-    stbi_set_flip_vertically_on_load(flip_vertically);  
+Image::Image(std::string file, bool flip_vertically, bool async): data(nullptr), width(0), height(0), nChannels(0), async(async) {
     std::string resolvedPath = externalPath(file);
+    if (!async) {
+        decode(resolvedPath, flip_vertically);
+        return;
+    }
+
+    loaded.store(false, std::memory_order_relaxed);
+    ThreadPool::getLoader().submit([this, resolvedPath, flip_vertically]() {
+        decode(resolvedPath, flip_vertically);
+        loaded.store(true, std::memory_order_release);
+        loaded.notify_all();
+    });
+}
+
+/**
+ * @brief Decode an image file into this image. Safe to call from any thread.
+ * 
+ */
+void Image::decode(const std::string& resolvedPath, bool flip_vertically) {
+    // The flip flag is thread local so concurrent decodes do not race on it
+    stbi_set_flip_vertically_on_load_thread(flip_vertically);
     data = stbi_load(resolvedPath.c_str(), &width, &height, &nChannels, 4);
     if (!data) {
+        width = 0;
+        height = 0;
         std::cout << "Failed to load texture from path: " << resolvedPath << std::endl;
     }
 }
 
+/**
+ * @brief Block until the image has finished loading. Returns immediately for images that are not async.
+ * 
+ */
+void Image::wait() const {
+    loaded.wait(false, std::memory_order_acquire);
+}
+
 /**
  * @brief Construct a new Image object from float vector data
  *        Converts float values (0.0-1.0) to unsigned char (0-255)
@@ -28,7 +62,7 @@ Image::Image(std::string file, bool flip_vertically) {
  * @param height Image height
  * @param nChannels Number of channels (default 4 for RGBA)
  */
-Image::Image(const std::vector<float>& data, int width, int height, int nChannels) {
+Image::Image(const std::vector<float>& data, int width, int height, int nChannels): async(false) {
     this->width = width;
     this->height = height;
     this->nChannels = nChannels;
@@ -54,6 +88,13 @@ Image::Image(const std::vector<float>& data, int width, int height, int nChannel
  * 
  */
 Image::~Image() {
+    // An async decode still in flight writes into this image
+    wait();
+
+    // The server is gone at shutdown, together with every mapping
+    if (ResourceServer* server = Engine::getResourceServer()) {
+        server->getTextureServer()->remove(this);
+    }
     stbi_image_free(data);
 }
 
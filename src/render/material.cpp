@@ -26,6 +26,17 @@ Material::Material(const glm::vec3& color, Image* albedo, Image* normal, float a
     if (!this->normal) this->normal = Engine::getResourceServer()->defaultImage;
 }
 
+/**
+ * @brief Destroy the Material object and release its slot in the material server
+ * 
+ */
+Material::~Material() {
+    // The server is gone at shutdown, together with every slot
+    if (ResourceServer* server = Engine::getResourceServer()) {
+        server->getMaterialServer()->remove(this);
+    }
+}
+
 void Material::update() {
     Engine::getResourceServer()->getMaterialServer()->update(this);
 }
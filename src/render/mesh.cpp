@@ -1,22 +1,30 @@
 #include <basilisk/render/mesh.h>
+#include <basilisk/render/meshCache.h>
+#include <basilisk/render/meshOptimizer.h>
 #include <basilisk/util/resolvePath.h>
 
 namespace bsk::internal {
 
 /**
- * @brief Construct a new Mesh object from a model
+ * @brief Construct a new Mesh object from a model. The first import of a model is optimized and cooked to a binary cache,
+ *        later loads of the unchanged file with the same options read that instead of running Assimp.
  * 
  * @param modelPath The path to the model to load
  */
 Mesh::Mesh(const std::string modelPath, bool generateUV, bool generateNormals) {
-    Assimp::Importer importer;
-
     std::string resolvedPath = externalPath(modelPath);
     const unsigned int postprocessFlags =
         aiProcess_Triangulate |
         aiProcess_FlipUVs |
         (generateNormals ? aiProcess_GenSmoothNormals : 0u) |
         (generateUV ? aiProcess_GenUVCoords : 0u);
+
+    if (readMeshCache(resolvedPath, postprocessFlags, vertices, indices, attributes)) {
+        computeLayout();
+        return;
+    }
+
+    Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile(resolvedPath.c_str(), postprocessFlags);
 
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
@@ -25,12 +33,19 @@ Mesh::Mesh(const std::string modelPath, bool generateUV, bool generateNormals) {
     }
 
     unsigned int vertexOffset = 0;
+    uint32_t layout = 0;
+    bool layoutConsistent = true;
 
     for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
         aiMesh* mesh = scene->mMeshes[i];
 
         if (!mesh->HasPositions()) { continue; }
 
+        // The layout is only known if every submesh interleaves the same attributes
+        uint32_t meshLayout = (mesh->HasTextureCoords(0) ? MESH_UV : 0u) | (mesh->HasNormals() ? MESH_NORMAL : 0u);
+        if (vertexOffset == 0) { layout = meshLayout; }
+        else if (meshLayout != layout) { layoutConsistent = false; }
+
         for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
             if (mesh->HasPositions()) {
                 vertices.push_back(mesh->mVertices[i].x);
@@ -61,6 +76,69 @@ Mesh::Mesh(const std::string modelPath, bool generateUV, bool generateNormals) {
     }
 
     importer.FreeScene();
+    if (layoutConsistent && !vertices.empty()) {
+        attributes = layout | MESH_LAYOUT_KNOWN;
+    }
+    computeLayout();
+    optimize();
+    writeMeshCache(resolvedPath, postprocessFlags, stride, attributes, vertices, indices);
+}
+
+/**
+ * @brief Derives the vertex stride and the model space bounds from the vertex data. Meshes with a known layout
+ *        take the stride from their attributes, other indexed meshes from the highest index, unindexed meshes are positions only. 
+ * 
+ */
+void Mesh::computeLayout() {
+    stride = 3;
+    if (hasLayout()) {
+        stride += (attributes & MESH_UV ? 2 : 0) + (attributes & MESH_NORMAL ? 3 : 0);
+    }
+    else if (!indices.empty()) {
+        unsigned int numVertices = *std::max_element(indices.begin(), indices.end()) + 1;
+        stride = std::max(3u, static_cast<unsigned int>(vertices.size()) / numVertices);
+    }
+
+    if (vertices.size() < 3) {
+        boundsMin = boundsMax = glm::vec3(0.0f);
+        return;
+    }
+
+    boundsMin = glm::vec3(std::numeric_limits<float>::max());
+    boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (unsigned int i = 0; i < getVertexCount(); i++) {
+        glm::vec3 position = getPosition(i);
+        boundsMin = glm::min(boundsMin, position);
+        boundsMax = glm::max(boundsMax, position);
+    }
 }
 
-}
\ No newline at end of file
+/**
+ * @brief Prepare the mesh for the GPU: weld duplicate vertices, order triangles for the post transform cache,
+ *        then order vertices by first use for fetch locality. Only meshes with a known layout are touched,
+ *        for anything else the stride is a guess and welding with a wrong one would scramble the data.
+ * 
+ */
+void Mesh::optimize() {
+    if (!hasLayout() || vertices.empty()) { return; }
+
+    weldVertices(vertices, indices, stride);
+    optimizeVertexCache(indices, getVertexCount());
+    optimizeVertexFetch(vertices, indices, stride);
+    computeLayout();
+    bvh.reset();
+}
+
+/**
+ * @brief Get the triangle hierarchy of this mesh, building it on first use
+ * 
+ * @return const MeshBVH& 
+ */
+const MeshBVH& Mesh::getBVH() {
+    if (!bvh) {
+        bvh = std::make_shared<MeshBVH>(vertices, indices, stride);
+    }
+    return *bvh;
+}
+
+}
@@ -0,0 +1,166 @@
+#include <basilisk/render/meshBVH.h>
+#include <basilisk/util/maths.h>
+#include <basilisk/util/aabbTree.h>
+
+namespace bsk::internal {
+
+static constexpr unsigned int MESH_BVH_LEAF_SIZE = 4;
+
+/**
+ * @brief Build the hierarchy over the triangles of a mesh
+ * 
+ * @param vertices Interleaved vertex data, position first
+ * @param indices Triangle indices, or empty for an unindexed triangle list
+ * @param stride Floats per vertex
+ */
+MeshBVH::MeshBVH(const std::vector<float>& vertices, const std::vector<unsigned int>& indices, unsigned int stride) {
+    auto position = [&](unsigned int vertex) {
+        return glm::vec3(vertices[vertex * stride], vertices[vertex * stride + 1], vertices[vertex * stride + 2]);
+    };
+
+    // Gather triangle corners once so the build and the leaves never touch the index buffer again
+    std::vector<glm::vec3> triangles;
+    if (indices.empty()) {
+        unsigned int vertexCount = vertices.size() / stride;
+        for (unsigned int i = 0; i + 2 < vertexCount; i += 3) {
+            triangles.push_back(position(i));
+            triangles.push_back(position(i + 1));
+            triangles.push_back(position(i + 2));
+        }
+    } else {
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            triangles.push_back(position(indices[i]));
+            triangles.push_back(position(indices[i + 1]));
+            triangles.push_back(position(indices[i + 2]));
+        }
+    }
+
+    unsigned int triangleCount = triangles.size() / 3;
+    if (triangleCount == 0) { return; }
+
+    std::vector<unsigned int> order(triangleCount);
+    std::vector<glm::vec3> centroids(triangleCount);
+    for (unsigned int i = 0; i < triangleCount; i++) {
+        order[i] = i;
+        centroids[i] = (triangles[3 * i] + triangles[3 * i + 1] + triangles[3 * i + 2]) / 3.0f;
+    }
+
+    nodes.reserve(2 * triangleCount / MESH_BVH_LEAF_SIZE + 1);
+    build(order, centroids, triangles, 0, triangleCount);
+
+    // Lay the corners out in leaf order
+    corners.resize(triangles.size());
+    triangleIds = order;
+    for (unsigned int i = 0; i < triangleCount; i++) {
+        corners[3 * i]     = triangles[3 * order[i]];
+        corners[3 * i + 1] = triangles[3 * order[i] + 1];
+        corners[3 * i + 2] = triangles[3 * order[i] + 2];
+    }
+}
+
+/**
+ * @brief Recursively split the range at the centroid median of its longest axis
+ * 
+ * @return unsigned int Index of the created node
+ */
+unsigned int MeshBVH::build(std::vector<unsigned int>& order, std::vector<glm::vec3>& centroids, const std::vector<glm::vec3>& triangles, unsigned int start, unsigned int count) {
+    unsigned int index = nodes.size();
+    nodes.push_back({});
+
+    glm::vec3 min(std::numeric_limits<float>::max());
+    glm::vec3 max(std::numeric_limits<float>::lowest());
+    glm::vec3 centroidMin = min;
+    glm::vec3 centroidMax = max;
+    for (unsigned int i = start; i < start + count; i++) {
+        unsigned int triangle = order[i];
+        for (int k = 0; k < 3; k++) {
+            min = glm::min(min, triangles[3 * triangle + k]);
+            max = glm::max(max, triangles[3 * triangle + k]);
+        }
+        centroidMin = glm::min(centroidMin, centroids[triangle]);
+        centroidMax = glm::max(centroidMax, centroids[triangle]);
+    }
+    nodes[index].min = min;
+    nodes[index].max = max;
+
+    glm::vec3 extent = centroidMax - centroidMin;
+    int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+    // Small or degenerate ranges become leaves
+    if (count <= MESH_BVH_LEAF_SIZE || extent[axis] <= 0.0f) {
+        nodes[index].start = start;
+        nodes[index].count = count;
+        return index;
+    }
+
+    unsigned int half = count / 2;
+    std::nth_element(order.begin() + start, order.begin() + start + half, order.begin() + start + count,
+        [&](unsigned int a, unsigned int b) { return centroids[a][axis] < centroids[b][axis]; });
+
+    build(order, centroids, triangles, start, half);
+    unsigned int right = build(order, centroids, triangles, start + half, count - half);
+    nodes[index].start = right;
+    nodes[index].count = 0;
+    return index;
+}
+
+/**
+ * @brief Find the closest triangle hit by a model space ray
+ * 
+ * @param origin Ray origin
+ * @param direction Ray direction, t is measured in multiples of it
+ * @param maxT Ignore hits further than this
+ * @param hit Closest hit if any
+ * @return true if a triangle was hit before maxT
+ */
+bool MeshBVH::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxT, MeshRayHit& hit) const {
+    if (nodes.empty()) { return false; }
+
+    glm::vec3 inverseDirection = 1.0f / direction;
+    bool found = false;
+
+    unsigned int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const BVHNode& node = nodes[stack[--top]];
+
+        float tEnter;
+        if (!rayIntersectsAABB(origin, inverseDirection, node.min, node.max, maxT, tEnter)) { continue; }
+
+        if (node.count > 0) {
+            for (unsigned int i = node.start; i < node.start + node.count; i++) {
+                const glm::vec3& v0 = corners[3 * i];
+                const glm::vec3& v1 = corners[3 * i + 1];
+                const glm::vec3& v2 = corners[3 * i + 2];
+
+                float t, u, v;
+                if (!rayTriangleIntersect(origin, direction, v0, v1, v2, t, u, v) || t >= maxT) { continue; }
+
+                maxT = t;
+                found = true;
+                hit.t = t;
+                hit.triangle = triangleIds[i];
+                hit.normal = glm::cross(v1 - v0, v2 - v0);
+            }
+            continue;
+        }
+
+        // Visit the nearer child first so maxT shrinks early
+        unsigned int left = &node - nodes.data() + 1;
+        unsigned int right = node.start;
+        float tLeft, tRight;
+        bool hitLeft = rayIntersectsAABB(origin, inverseDirection, nodes[left].min, nodes[left].max, maxT, tLeft);
+        bool hitRight = rayIntersectsAABB(origin, inverseDirection, nodes[right].min, nodes[right].max, maxT, tRight);
+        if (hitLeft && hitRight) {
+            if (tLeft < tRight) { stack[top++] = right; stack[top++] = left; }
+            else                { stack[top++] = left; stack[top++] = right; }
+        }
+        else if (hitLeft)  { stack[top++] = left; }
+        else if (hitRight) { stack[top++] = right; }
+    }
+
+    return found;
+}
+
+}
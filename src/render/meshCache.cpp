@@ -0,0 +1,140 @@
+#include <basilisk/render/meshCache.h>
+#include <basilisk/util/cacheFile.h>
+#include <basilisk/util/mappedFile.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief Bytes of source path stored after the header, padded so the vertex blob stays 4 byte aligned
+ *
+ */
+static uint32_t paddedPathLength(const std::string& path) {
+    return (uint32_t)((path.size() + 3) / 4 * 4);
+}
+
+/**
+ * @brief Get the last write time and size of a source file
+ *
+ * @return true if the file exists
+ */
+static bool getSourceStamp(const std::string& sourcePath, int64_t& time, uint64_t& size) {
+    std::error_code error;
+    auto writeTime = std::filesystem::last_write_time(sourcePath, error);
+    if (error) { return false; }
+    size = std::filesystem::file_size(sourcePath, error);
+    if (error) { return false; }
+    time = (int64_t)writeTime.time_since_epoch().count();
+    return true;
+}
+
+/**
+ * @brief Get the cooked file for a source path and import flags. The name is an FNV-1a hash of both,
+ *        the header repeats them in full so a hash collision is detected rather than loaded.
+ *
+ */
+static std::filesystem::path getCachePath(const std::string& sourcePath, unsigned int importFlags) {
+    const std::filesystem::path& directory = getMeshCacheDirectory();
+    if (directory.empty()) { return {}; }
+
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* bytes, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            hash ^= ((const unsigned char*)bytes)[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(sourcePath.data(), sourcePath.size());
+    mix(&importFlags, sizeof(importFlags));
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bskmesh", (unsigned long long)hash);
+    return directory / name;
+}
+
+/**
+ * @brief Get the directory cooked meshes are written to, resolved once per process
+ *
+ * @return const std::filesystem::path& Empty when meshes are not cached
+ */
+const std::filesystem::path& getMeshCacheDirectory() {
+    static const std::filesystem::path directory = getCacheDirectory("meshes");
+    return directory;
+}
+
+/**
+ * @brief Load a mesh from its cooked file if one exists and is still current. The file is memory mapped and its
+ *        vertex and index blobs are copied out in one go each.
+ *
+ * @param sourcePath Resolved path of the source model
+ * @param importFlags Assimp post processing flags the mesh would be imported with
+ * @param vertices Output vertex floats
+ * @param indices Output indices
+ * @param attributes Output MESH_* layout flags
+ * @return true if the mesh was loaded from the cache
+ */
+bool readMeshCache(const std::string& sourcePath, unsigned int importFlags, std::vector<float>& vertices, std::vector<unsigned int>& indices, uint32_t& attributes) {
+    int64_t sourceTime;
+    uint64_t sourceSize;
+    if (!getSourceStamp(sourcePath, sourceTime, sourceSize)) { return false; }
+
+    std::filesystem::path cachePath = getCachePath(sourcePath, importFlags);
+    if (cachePath.empty()) { return false; }
+
+    MappedFile file(cachePath);
+    const unsigned char* data = file.getData();
+    if (!data || file.getSize() < sizeof(MeshCacheHeader)) { return false; }
+
+    MeshCacheHeader header;
+    std::memcpy(&header, data, sizeof(MeshCacheHeader));
+    if (std::memcmp(header.magic, "BSKM", 4) != 0 || header.version != MESH_CACHE_VERSION) { return false; }
+    if (header.importFlags != importFlags || header.sourceTime != sourceTime || header.sourceSize != sourceSize) { return false; }
+    if (header.pathLength != paddedPathLength(sourcePath)) { return false; }
+
+    size_t pathOffset = sizeof(MeshCacheHeader);
+    size_t vertexOffset = pathOffset + header.pathLength;
+    size_t indexOffset = vertexOffset + header.vertexCount * sizeof(float);
+    size_t end = indexOffset + header.indexCount * sizeof(unsigned int);
+    if (end != file.getSize()) { return false; }
+    if (std::memcmp(data + pathOffset, sourcePath.data(), sourcePath.size()) != 0) { return false; }
+
+    vertices.resize(header.vertexCount);
+    indices.resize(header.indexCount);
+    std::memcpy(vertices.data(), data + vertexOffset, header.vertexCount * sizeof(float));
+    std::memcpy(indices.data(), data + indexOffset, header.indexCount * sizeof(unsigned int));
+    attributes = header.attributes;
+    return true;
+}
+
+/**
+ * @brief Cook a freshly imported mesh to disk so later loads skip the importer
+ *
+ * @param sourcePath Resolved path of the source model
+ * @param importFlags Assimp post processing flags the mesh was imported with
+ * @param stride Floats per vertex
+ * @param attributes MESH_* layout flags
+ * @param vertices Vertex floats
+ * @param indices Indices
+ */
+void writeMeshCache(const std::string& sourcePath, unsigned int importFlags, unsigned int stride, uint32_t attributes, const std::vector<float>& vertices, const std::vector<unsigned int>& indices) {
+    MeshCacheHeader header = {};
+    std::memcpy(header.magic, "BSKM", 4);
+    header.version = MESH_CACHE_VERSION;
+    header.importFlags = importFlags;
+    header.stride = stride;
+    header.attributes = attributes;
+    header.vertexCount = vertices.size();
+    header.indexCount = indices.size();
+    header.pathLength = paddedPathLength(sourcePath);
+    if (!getSourceStamp(sourcePath, header.sourceTime, header.sourceSize)) { return; }
+
+    std::string path = sourcePath;
+    path.resize(header.pathLength, '\0');
+    writeCacheFile(getCachePath(sourcePath, importFlags), {
+        { &header, sizeof(MeshCacheHeader) },
+        { path.data(), path.size() },
+        { vertices.data(), vertices.size() * sizeof(float) },
+        { indices.data(), indices.size() * sizeof(unsigned int) }
+    });
+}
+
+}
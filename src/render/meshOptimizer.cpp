@@ -0,0 +1,310 @@
+#include <basilisk/render/meshOptimizer.h>
+#include <basilisk/render/mesh.h>
+#include <basilisk/util/hash.h>
+
+namespace bsk::internal {
+
+// Marks a vertex or triangle that has not been assigned yet
+static constexpr unsigned int NO_INDEX = std::numeric_limits<unsigned int>::max();
+
+/**
+ * @brief Convert a float in [0, 1] to a normalized unsigned short
+ *
+ */
+static uint16_t floatToUnorm16(float value) {
+    return (uint16_t)std::round(glm::clamp(value, 0.0f, 1.0f) * 65535.0f);
+}
+
+/**
+ * @brief Convert a float in [-1, 1] to a normalized signed short
+ *
+ */
+static int16_t floatToSnorm16(float value) {
+    return (int16_t)std::round(glm::clamp(value, -1.0f, 1.0f) * 32767.0f);
+}
+
+/**
+ * @brief Score of a vertex for triangle ordering. Vertices still in the simulated cache score high, as do vertices
+ *        with few triangles left, so isolated triangles are finished off instead of revisited later.
+ *
+ * @param cachePosition Position in the cache, -1 if not cached
+ * @param remaining Unemitted triangles using the vertex
+ */
+static float vertexScore(int cachePosition, unsigned int remaining) {
+    if (remaining == 0) { return -1.0f; }
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        // the last triangle's vertices get a fixed score so the next triangle doesn't just reuse one edge
+        if (cachePosition < 3) { score = 0.75f; }
+        else { score = std::pow(1.0f - (float)(cachePosition - 3) / (VERTEX_CACHE_SIZE - 3), 1.5f); }
+    }
+    return score + 2.0f * std::pow((float)remaining, -0.5f);
+}
+
+/**
+ * @brief Merge vertices whose attributes are bitwise identical. Unindexed vertex data comes out indexed.
+ *
+ * @param vertices Interleaved vertex floats, rewritten with unique vertices only
+ * @param indices Triangle indices, remapped to the unique vertices
+ * @param stride Floats per vertex
+ */
+void weldVertices(std::vector<float>& vertices, std::vector<unsigned int>& indices, unsigned int stride) {
+    unsigned int vertexCount = vertices.size() / stride;
+    if (vertexCount == 0) { return; }
+
+    size_t vertexBytes = stride * sizeof(float);
+    std::vector<unsigned int> remap(vertexCount);
+    std::vector<float> welded;
+    welded.reserve(vertices.size());
+    std::unordered_multimap<uint64_t, unsigned int> unique;
+    unique.reserve(vertexCount);
+
+    for (unsigned int vertex = 0; vertex < vertexCount; vertex++) {
+        const float* data = &vertices[vertex * stride];
+        uint64_t hash = hashBytes(data, vertexBytes);
+
+        unsigned int match = NO_INDEX;
+        auto [first, last] = unique.equal_range(hash);
+        for (auto it = first; it != last; it++) {
+            if (std::memcmp(&welded[it->second * stride], data, vertexBytes) == 0) {
+                match = it->second;
+                break;
+            }
+        }
+
+        if (match == NO_INDEX) {
+            match = welded.size() / stride;
+            welded.insert(welded.end(), data, data + stride);
+            unique.emplace(hash, match);
+        }
+        remap[vertex] = match;
+    }
+
+    if (indices.empty()) {
+        indices = std::move(remap);
+    }
+    else {
+        for (unsigned int& index : indices) {
+            index = remap[index];
+        }
+    }
+    vertices.swap(welded);
+}
+
+/**
+ * @brief Reorder triangles so consecutive triangles share vertices still in the GPU's post transform cache.
+ *        Greedy ordering after Forsyth: the next triangle is the best scoring one touching the simulated cache.
+ *
+ * @param indices Triangle indices, reordered in place
+ * @param vertexCount Number of vertices the indices refer to
+ */
+void optimizeVertexCache(std::vector<unsigned int>& indices, unsigned int vertexCount) {
+    unsigned int triangleCount = indices.size() / 3;
+    if (triangleCount < 2 || indices.size() % 3 != 0) { return; }
+
+    // Triangles using each vertex, packed into one array. remaining[v] shrinks as triangles are emitted.
+    std::vector<unsigned int> remaining(vertexCount, 0);
+    std::vector<unsigned int> offsets(vertexCount + 1, 0);
+    std::vector<unsigned int> adjacency(triangleCount * 3);
+    for (unsigned int i = 0; i < triangleCount * 3; i++) {
+        remaining[indices[i]]++;
+    }
+    for (unsigned int vertex = 0; vertex < vertexCount; vertex++) {
+        offsets[vertex + 1] = offsets[vertex] + remaining[vertex];
+    }
+    std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+    for (unsigned int i = 0; i < triangleCount * 3; i++) {
+        adjacency[fill[indices[i]]++] = i / 3;
+    }
+
+    std::vector<float> scores(vertexCount);
+    for (unsigned int vertex = 0; vertex < vertexCount; vertex++) {
+        scores[vertex] = vertexScore(-1, remaining[vertex]);
+    }
+    std::vector<float> triangleScores(triangleCount);
+    for (unsigned int triangle = 0; triangle < triangleCount; triangle++) {
+        const unsigned int* corners = &indices[triangle * 3];
+        triangleScores[triangle] = scores[corners[0]] + scores[corners[1]] + scores[corners[2]];
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<unsigned int> ordered;
+    ordered.reserve(triangleCount * 3);
+    std::vector<unsigned int> cache;
+    std::vector<unsigned int> nextCache;
+    cache.reserve(VERTEX_CACHE_SIZE + 3);
+    nextCache.reserve(VERTEX_CACHE_SIZE + 3);
+
+    unsigned int best = 0;
+    unsigned int cursor = 0; // first triangle that may still be unemitted, for restarts
+    while (ordered.size() < triangleCount * 3) {
+        // Nothing in the cache touches an unemitted triangle, start over from the next one in input order
+        if (best == NO_INDEX) {
+            while (emitted[cursor]) { cursor++; }
+            best = cursor;
+        }
+
+        emitted[best] = true;
+        const unsigned int* corners = &indices[best * 3];
+        ordered.insert(ordered.end(), corners, corners + 3);
+
+        for (int k = 0; k < 3; k++) {
+            unsigned int vertex = corners[k];
+            auto begin = adjacency.begin() + offsets[vertex];
+            auto end = begin + remaining[vertex];
+            std::iter_swap(std::find(begin, end, best), end - 1);
+            remaining[vertex]--;
+        }
+
+        // The emitted triangle's vertices move to the front, everything else shifts back
+        nextCache.assign(corners, corners + 3);
+        for (unsigned int vertex : cache) {
+            if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2]) {
+                nextCache.push_back(vertex);
+            }
+        }
+
+        // Rescore every vertex that moved, including the ones pushed out, and carry the change to their triangles
+        for (unsigned int i = 0; i < nextCache.size(); i++) {
+            unsigned int vertex = nextCache[i];
+            float score = vertexScore(i < VERTEX_CACHE_SIZE ? (int)i : -1, remaining[vertex]);
+            float delta = score - scores[vertex];
+            scores[vertex] = score;
+            for (unsigned int j = offsets[vertex]; j < offsets[vertex] + remaining[vertex]; j++) {
+                triangleScores[adjacency[j]] += delta;
+            }
+        }
+        if (nextCache.size() > VERTEX_CACHE_SIZE) { nextCache.resize(VERTEX_CACHE_SIZE); }
+        cache.swap(nextCache);
+
+        best = NO_INDEX;
+        float bestScore = -1.0f;
+        for (unsigned int vertex : cache) {
+            for (unsigned int j = offsets[vertex]; j < offsets[vertex] + remaining[vertex]; j++) {
+                unsigned int triangle = adjacency[j];
+                if (triangleScores[triangle] > bestScore) {
+                    bestScore = triangleScores[triangle];
+                    best = triangle;
+                }
+            }
+        }
+    }
+
+    indices.swap(ordered);
+}
+
+/**
+ * @brief Reorder vertices into the order the indices first use them, so vertex fetches walk memory forward.
+ *        Vertices no index refers to are dropped.
+ *
+ * @param vertices Interleaved vertex floats, reordered in place
+ * @param indices Triangle indices, remapped to the new order
+ * @param stride Floats per vertex
+ */
+void optimizeVertexFetch(std::vector<float>& vertices, std::vector<unsigned int>& indices, unsigned int stride) {
+    if (indices.empty()) { return; }
+
+    std::vector<unsigned int> remap(vertices.size() / stride, NO_INDEX);
+    std::vector<float> ordered;
+    ordered.reserve(vertices.size());
+
+    unsigned int next = 0;
+    for (unsigned int& index : indices) {
+        if (remap[index] == NO_INDEX) {
+            remap[index] = next++;
+            ordered.insert(ordered.end(), vertices.begin() + index * stride, vertices.begin() + (index + 1) * stride);
+        }
+        index = remap[index];
+    }
+    vertices.swap(ordered);
+}
+
+/**
+ * @brief Build the GPU copy of a mesh with a known layout. Positions stay full floats. When quantizing,
+ *        UVs become normalized unsigned shorts if they all lie in [0, 1], a step of 1/65535 is far below a texel
+ *        of any texture we load, and stay floats when they tile. Normals become normalized shorts padded to four.
+ *        Indices are 16 bit whenever the vertex count allows it.
+ *
+ * @param mesh Mesh with MESH_LAYOUT_KNOWN set
+ * @param quantize Pack normals and UVs into smaller types
+ * @return PackedMesh
+ */
+PackedMesh packMesh(Mesh& mesh, bool quantize) {
+    const std::vector<float>& vertices = mesh.getVertices();
+    const std::vector<unsigned int>& indices = mesh.getIndices();
+    unsigned int stride = mesh.getStride();
+    unsigned int vertexCount = mesh.getVertexCount();
+    bool hasUV = mesh.getAttributes() & MESH_UV;
+    bool hasNormal = mesh.getAttributes() & MESH_NORMAL;
+
+    bool shortUV = hasUV && quantize;
+    for (unsigned int vertex = 0; shortUV && vertex < vertexCount; vertex++) {
+        const float* uv = &vertices[vertex * stride + 3];
+        shortUV = uv[0] >= 0.0f && uv[0] <= 1.0f && uv[1] >= 0.0f && uv[1] <= 1.0f;
+    }
+    bool shortNormal = hasNormal && quantize;
+
+    PackedMesh packed;
+    packed.format.add(3, GL_FLOAT, GL_FALSE, 3 * sizeof(float));
+    if (hasUV) {
+        if (shortUV) { packed.format.add(2, GL_UNSIGNED_SHORT, GL_TRUE, 2 * sizeof(uint16_t)); }
+        else         { packed.format.add(2, GL_FLOAT, GL_FALSE, 2 * sizeof(float)); }
+    }
+    if (hasNormal) {
+        if (shortNormal) { packed.format.add(3, GL_SHORT, GL_TRUE, 4 * sizeof(int16_t)); }
+        else             { packed.format.add(3, GL_FLOAT, GL_FALSE, 3 * sizeof(float)); }
+    }
+
+    packed.vertices.resize((size_t)vertexCount * packed.format.stride);
+    unsigned char* out = packed.vertices.data();
+    for (unsigned int vertex = 0; vertex < vertexCount; vertex++) {
+        const float* in = &vertices[vertex * stride];
+        std::memcpy(out, in, 3 * sizeof(float));
+        out += 3 * sizeof(float);
+        in += 3;
+
+        if (hasUV) {
+            if (shortUV) {
+                uint16_t uv[2] = { floatToUnorm16(in[0]), floatToUnorm16(in[1]) };
+                std::memcpy(out, uv, sizeof(uv));
+                out += sizeof(uv);
+            }
+            else {
+                std::memcpy(out, in, 2 * sizeof(float));
+                out += 2 * sizeof(float);
+            }
+            in += 2;
+        }
+
+        if (hasNormal) {
+            if (shortNormal) {
+                int16_t normal[4] = { floatToSnorm16(in[0]), floatToSnorm16(in[1]), floatToSnorm16(in[2]), 0 };
+                std::memcpy(out, normal, sizeof(normal));
+                out += sizeof(normal);
+            }
+            else {
+                std::memcpy(out, in, 3 * sizeof(float));
+                out += 3 * sizeof(float);
+            }
+        }
+    }
+
+    if (vertexCount <= 65536) {
+        packed.indexType = GL_UNSIGNED_SHORT;
+        packed.indices.resize(indices.size() * sizeof(uint16_t));
+        uint16_t* shortIndices = (uint16_t*)packed.indices.data();
+        for (size_t i = 0; i < indices.size(); i++) {
+            shortIndices[i] = (uint16_t)indices[i];
+        }
+    }
+    else {
+        packed.indexType = GL_UNSIGNED_INT;
+        packed.indices.resize(indices.size() * sizeof(unsigned int));
+        std::memcpy(packed.indices.data(), indices.data(), packed.indices.size());
+    }
+
+    return packed;
+}
+
+}
@@ -0,0 +1,72 @@
+#include <basilisk/render/pbo.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief Construct a new pixel unpack buffer used to stage texture uploads
+ *
+ * @param size Initial size of the buffer in bytes
+ */
+PBO::PBO(unsigned int size): size(size) {
+    glGenBuffers(1, &ID);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ID);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+/**
+ * @brief Destroy the PBO object
+ *
+ */
+PBO::~PBO() {
+    glDeleteBuffers(1, &ID);
+}
+
+/**
+ * @brief Binds this PBO as the pixel unpack buffer. While bound, texture uploads read from it and take byte offsets instead of pointers.
+ *
+ */
+void PBO::bind() {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ID);
+}
+
+/**
+ * @brief Unbinds the pixel unpack buffer so texture uploads read from client memory again
+ *
+ */
+void PBO::unbind() {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+/**
+ * @brief Maps the start of the buffer for writing. The previous contents are invalidated, so the driver never
+ *        waits on uploads still reading them. Grows the buffer if it is smaller than requested.
+ *
+ * @param size Number of bytes to map
+ * @return void* Pointer to the mapped memory, nullptr on failure. Must be released with unmap().
+ */
+void* PBO::map(unsigned int size) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ID);
+    if (size > this->size) {
+        this->size = size;
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    }
+    void* data = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (!data) {
+        std::cerr << "Failed to map pixel buffer of " << size << " bytes" << std::endl;
+    }
+    return data;
+}
+
+/**
+ * @brief Releases a mapping made by map()
+ *
+ */
+void PBO::unmap() {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ID);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+}
@@ -0,0 +1,207 @@
+#include <basilisk/render/renderQueue.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief Get the byte offset of a named instance attribute within InstanceData
+ *
+ * @param name Name of the attribute in the shader
+ * @return int Offset in bytes, -1 if the attribute is not part of InstanceData
+ */
+int getInstanceAttributeOffset(const std::string& name) {
+    if (name == "iModel0")     return offsetof(InstanceData, model) + 0  * sizeof(float);
+    if (name == "iModel1")     return offsetof(InstanceData, model) + 4  * sizeof(float);
+    if (name == "iModel2")     return offsetof(InstanceData, model) + 8  * sizeof(float);
+    if (name == "iModel3")     return offsetof(InstanceData, model) + 12 * sizeof(float);
+    if (name == "iMaterialID") return offsetof(InstanceData, materialID);
+    return -1;
+}
+
+// Sort key layout, most significant first:
+//   opaque:      [63] 0 | [62..40] mesh  | [39..24] depth, front to back
+//   translucent: [63] 1 | [62..47] depth, back to front | [46..24] mesh
+static constexpr uint64_t TRANSLUCENT_BIT = 1ull << 63;
+static constexpr unsigned int MESH_BITS = 23;
+static constexpr uint64_t MESH_MASK = (1ull << MESH_BITS) - 1;
+
+/**
+ * @brief Quantize a view depth to 16 bits while keeping its order. The float bits are flipped so that negative
+ *        depths sort below positive ones, then the top half is kept, which leaves precision relative to magnitude.
+ *
+ */
+static uint64_t quantizeDepth(float depth) {
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(float));
+    bits = (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+    return bits >> 16;
+}
+
+/**
+ * @brief Stable LSD radix sort of draw commands by key, one byte per pass.
+ *        Passes where every key shares the same byte are skipped, so unused low bits cost nothing.
+ *
+ */
+template<typename Command>
+static void radixSort(std::vector<Command>& commands, std::vector<Command>& scratch) {
+    size_t count = commands.size();
+    if (count < 2) { return; }
+    scratch.resize(count);
+
+    // All eight histograms in one read of the keys
+    std::array<std::array<uint32_t, 256>, 8> histograms = {};
+    for (const Command& command : commands) {
+        for (unsigned int pass = 0; pass < 8; pass++) {
+            histograms[pass][(command.key >> (pass * 8)) & 0xFF]++;
+        }
+    }
+
+    Command* source = commands.data();
+    Command* destination = scratch.data();
+    for (unsigned int pass = 0; pass < 8; pass++) {
+        std::array<uint32_t, 256>& histogram = histograms[pass];
+        if (histogram[(source[0].key >> (pass * 8)) & 0xFF] == count) { continue; }
+
+        uint32_t offset = 0;
+        for (uint32_t& bucket : histogram) {
+            uint32_t size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+        for (size_t i = 0; i < count; i++) {
+            destination[histogram[(source[i].key >> (pass * 8)) & 0xFF]++] = source[i];
+        }
+        std::swap(source, destination);
+    }
+
+    if (source != commands.data()) {
+        commands.swap(scratch);
+    }
+}
+
+/**
+ * @brief Construct a new Render Queue for the given shader
+ *
+ * @param shader Shader used for every draw in this queue. Must declare the instance attributes.
+ */
+RenderQueue::RenderQueue(Shader* shader): shader(shader), capacity(256), view(1.0f), sorted(true) {
+    instanceBuffer = new VBO(nullptr, capacity * sizeof(InstanceData), GL_STREAM_DRAW);
+
+    for (const Attribute& attrib : shader->getInstanceAttributes()) {
+        int offset = getInstanceAttributeOffset(attrib.name);
+        if (offset < 0) {
+            std::cerr << "Unknown instance attribute on shader: " << attrib.name << std::endl;
+            continue;
+        }
+        instanceAttributes.push_back({ attrib.location, attrib.count, attrib.dataType, (unsigned int)offset });
+    }
+}
+
+/**
+ * @brief Destroy the Render Queue object and release the instance buffer
+ *
+ */
+RenderQueue::~RenderQueue() {
+    delete instanceBuffer;
+}
+
+/**
+ * @brief Empties the queue for a new frame. Storage is kept for reuse.
+ *
+ * @param view View matrix of the camera this frame, instance depths are measured along it
+ */
+void RenderQueue::clear(const glm::mat4& view) {
+    this->view = view;
+    meshLookup.clear();
+    meshVAOs.clear();
+    instances.clear();
+    commands.clear();
+    runs.clear();
+    sorted = true;
+}
+
+/**
+ * @brief Add one instance of a mesh to this frame's queue
+ *
+ * @param mesh Mesh to draw, instances are grouped by it
+ * @param vao A VAO holding the vertex and index buffers of the mesh
+ * @param model World model matrix of the instance
+ * @param materialID Location of the instance's material in the material server
+ * @param translucent Draw after all opaque instances, sorted back to front
+ */
+void RenderQueue::push(Mesh* mesh, VAO* vao, const glm::mat4& model, unsigned int materialID, bool translucent) {
+    auto [it, inserted] = meshLookup.try_emplace(mesh, (unsigned int)meshVAOs.size());
+    if (inserted) {
+        meshVAOs.push_back(vao);
+    }
+    uint64_t meshID = it->second & MESH_MASK;
+
+    // Depth of the instance origin in front of the camera, view space looks down -z
+    float depth = -(view[0][2] * model[3][0] + view[1][2] * model[3][1] + view[2][2] * model[3][2] + view[3][2]);
+
+    uint64_t key;
+    if (translucent) {
+        key = TRANSLUCENT_BIT | ((0xFFFFull - quantizeDepth(depth)) << 47) | (meshID << 24);
+    }
+    else {
+        key = (meshID << 40) | (quantizeDepth(depth) << 24);
+    }
+
+    commands.push_back({ key, (uint32_t)instances.size(), it->second });
+    instances.push_back({ model, (float)materialID, { 0.0f, 0.0f, 0.0f } });
+    sorted = false;
+}
+
+/**
+ * @brief Sort the queued commands and lay the instances out in draw order. Touches no GL state, so it may run
+ *        away from the render thread. Called by render() if the queue changed since the last sort.
+ *
+ */
+void RenderQueue::sort() {
+    radixSort(commands, scratch);
+
+    sortedInstances.resize(commands.size());
+    runs.clear();
+    for (unsigned int i = 0; i < commands.size(); i++) {
+        const DrawCommand& command = commands[i];
+        sortedInstances[i] = instances[command.instance];
+
+        VAO* vao = meshVAOs[command.mesh];
+        if (runs.empty() || runs.back().vao != vao) {
+            runs.push_back({ vao, i, 0 });
+        }
+        runs.back().count++;
+    }
+    sorted = true;
+}
+
+/**
+ * @brief Uploads all queued instances in sorted order and issues one instanced draw per run of equal meshes
+ *
+ */
+void RenderQueue::render() {
+    if (!sorted) { sort(); }
+    if (runs.empty()) { return; }
+
+    // Grow if needed, then orphan so this frame's upload never waits on last frame's draws
+    unsigned int total = sortedInstances.size();
+    if (total > capacity) {
+        capacity = std::max(total, capacity * 2);
+    }
+    instanceBuffer->orphan(capacity * sizeof(InstanceData));
+    instanceBuffer->write(sortedInstances.data(), total * sizeof(InstanceData), 0);
+
+    shader->use();
+    for (const DrawRun& run : runs) {
+        // Point the instance attributes of this mesh's VAO at its slice of the buffer
+        unsigned int offset = run.first * sizeof(InstanceData);
+        run.vao->bind();
+        instanceBuffer->bind();
+        for (const InstanceAttribute& attrib : instanceAttributes) {
+            run.vao->bindAttribute(attrib.location, attrib.count, attrib.dataType, sizeof(InstanceData), offset + attrib.offset, 1);
+        }
+
+        run.vao->render(run.count);
+    }
+}
+
+}
@@ -1,10 +1,10 @@
 #include <basilisk/render/shader.h>
+#include <basilisk/render/renderQueue.h>
 #include <basilisk/util/resolvePath.h>
-#include <regex>
-#include <filesystem>
 
 namespace bsk::internal {
 
+unsigned int Shader::boundProgram = 0;
 
 /**
  * @brief Get the component count of an OpenGL type. Not an exhaustive function, only valid for BOOL, INT, and FLOAT type. 
@@ -92,124 +92,9 @@ std::string loadFile(const char* path) {
 }
 
 
-std::string loadShaderSource(std::string filepath, std::unordered_set<std::string>& includedFiles, bool isRootFile) {
-    // Mark as included
-    std::replace(filepath.begin(), filepath.end(), '\\', '/');
-    includedFiles.insert(filepath);
-    
-    // Open the file
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << filepath << std::endl;
-        return "";
-    }
-
-    // Get directory of file
-    std::filesystem::path currentFilePath(filepath);
-    std::filesystem::path currentDir = currentFilePath.parent_path();
-
-    std::string line;
-    std::stringstream fullSource;
-    
-    // Regex for #include "path/to/file.glsl"
-    std::regex includeRegex(R"(#include\s+["<](.*)[">])");
-    // Regex for #version
-    std::regex versionRegex(R"(#version\s+.*)");
-
-    while (std::getline(file, line)) {
-
-        // Filter out #version unless at root
-        if (std::regex_match(line, versionRegex)) {
-            if (isRootFile) {
-                fullSource << line << "\n";
-            }
-            continue;
-        }
-
-        // Add include files if needed
-        std::smatch match;
-        if (std::regex_search(line, match, includeRegex)) {
-            std::string includeName = match[1].str();
-            std::filesystem::path includePath = currentDir / includeName;
-            std::string includePathStr = includePath.string();
-            std::replace(includePathStr.begin(), includePathStr.end(), '\\', '/');
-            
-            if (!includedFiles.contains(includePathStr)) {
-                fullSource << "// == Begin "  << includePathStr << " include ==\n";
-                fullSource << "\n" << loadShaderSource(includePathStr, includedFiles, false) << "\n";
-                fullSource << "// == End "  << includePathStr << " include ==\n";
-            }
-        } 
-        // Add line as is if not an include
-        else {
-            fullSource << line << "\n";
-        }
-    }
-
-    return fullSource.str();
-}
-std::string loadShaderSource(const std::string& filepath) {
-    std::unordered_set<std::string> includedFiles;
-    return loadShaderSource(filepath, includedFiles, true);
-}
-
-/**
- * @brief Compiles a shader from source code and returns the ID.
- * 
- * @param source C-String containg the shader source code
- * @param shaderType The type of shader. May be GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
- * @return unsigned int of the shader ID
- */
-unsigned int loadShader(std::string source, unsigned int shaderType) {
-    int success;
-    char infoLog[512];
-
-    // Load Shader
-    unsigned int shader = glCreateShader(shaderType);
-    const char* sourceCode = source.c_str();
-    glShaderSource(shader, 1, &sourceCode, NULL);
-    glCompileShader(shader);
-
-    // Check for compilation errors
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(shader, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::COMPILATION_FAILED\n" << infoLog << std::endl;
-    }
-
-    return shader;
-}
-
-/**
- * @brief Links a shader program given a vertex and fragment shader. Returns program ID. 
- * 
- * @param vertex ID of the vertex shader
- * @param fragment ID of the fragment shader
- * @return unsigned int 
- */
-unsigned int loadProgram(unsigned int vertex, unsigned int fragment) {
-    int success;
-    char infoLog[512];
-
-    // Shader program
-    unsigned int program = glCreateProgram();
-    glAttachShader(program, vertex);
-    glAttachShader(program, fragment);
-    glLinkProgram (program);
-
-    // Check for linking errors
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if(!success)
-    {
-        glGetProgramInfoLog(program, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
-    }
-
-    return program;
-}
-
 /**
- * @brief Construct a new Shader object from vertex and fragment source
+ * @brief Construct a new Shader object from vertex and fragment source. Sources and programs come from the
+ *        shader cache, so shaders built from the same files share one program and with it its uniform values.
  * 
  * @param vertexPath 
  * @param fragmentPath 
@@ -220,8 +105,9 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     std::string resolvedFragmentPath = externalPath(fragmentPath);
 
     //  Load the source code
-    std::string vertexShaderSource   = loadShaderSource(resolvedVertexPath);
-    std::string fragmentShaderSource = loadShaderSource(resolvedFragmentPath);
+    ShaderCache& cache = ShaderCache::getGlobal();
+    std::string vertexShaderSource   = cache.getSource(resolvedVertexPath);
+    std::string fragmentShaderSource = cache.getSource(resolvedFragmentPath);
 
     if (vertexShaderSource.empty()) {
         std::cout << "Failed to load shader from path: " << vertexPath << std::endl;
@@ -230,23 +116,20 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
         std::cout << "Failed to load shader from path: " << fragmentPath << std::endl;
     }
 
-    // Compile shaders from source
-    unsigned int vertex   = loadShader(vertexShaderSource,   GL_VERTEX_SHADER);
-    unsigned int fragment = loadShader(fragmentShaderSource, GL_FRAGMENT_SHADER);
-
-    // Shader program
-    ID = loadProgram(vertex, fragment);
-
-    // Release hanging shaders
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
+    // Shared, cached or freshly compiled program
+    program = cache.getProgram(vertexShaderSource, fragmentShaderSource);
+    ID = program->id;
 
     // Get all of the active attributes in the shader for VAO use
     loadAttributes();
+    // Resolve uniform and block locations once instead of on every set
+    loadUniforms();
 }
 
 /**
- * @brief Get all of the active attributes in the shader and saves them on the shader
+ * @brief Get all of the active attributes in the shader and saves them on the shader.
+ *        The engine's instance attributes (iModel0..iModel3, iMaterialID) are kept out of the vertex
+ *        stride so they can be sourced from the render queue's instance buffer. Any other name is per-vertex.
  * 
  */
 void Shader::loadAttributes() {
@@ -259,36 +142,85 @@ void Shader::loadAttributes() {
 
     glGetProgramiv(ID, GL_ACTIVE_ATTRIBUTES, &nAttributes);
 
-    attributes.resize(nAttributes);
+    attributes.clear();
+    instanceAttributes.clear();
 
     for (GLint i = 0; i < nAttributes; i++) {
         glGetActiveAttrib(ID, (GLuint)i, bufSize, &length, &size, &type, name);
         GLint location = glGetAttribLocation(ID, name);
-        attributes.at(location) = {name, location, getGLTypeComponentCount(type), type, 0};
+        Attribute attribute = {name, location, getGLTypeComponentCount(type), type, 0};
+
+        bool perInstance = getInstanceAttributeOffset(attribute.name) >= 0;
+        if (perInstance) { instanceAttributes.push_back(attribute); }
+        else             { attributes.push_back(attribute); }
     }
 
+    // Vertex data is interleaved in location order
+    auto byLocation = [](const Attribute& a, const Attribute& b) { return a.location < b.location; };
+    std::sort(attributes.begin(), attributes.end(), byLocation);
+    std::sort(instanceAttributes.begin(), instanceAttributes.end(), byLocation);
+
     stride = 0;
-    for (GLint i = 0; i < nAttributes; i++) {
-        attributes.at(i).offset = stride;
-        stride += getGLTypeSize(attributes.at(i).dataType);
+    for (Attribute& attribute : attributes) {
+        attribute.offset = stride;
+        stride += getGLTypeSize(attribute.dataType);
+    }
+}
+
+/**
+ * @brief Get the locations of all active uniforms and the indices of all uniform blocks.
+ *        Arrays are stored under both "name[0]" and "name". Members of uniform blocks have no location and are skipped.
+ * 
+ */
+void Shader::loadUniforms() {
+    GLint nUniforms;
+    GLint size;
+    GLenum type;
+    const GLsizei bufSize = 256;
+    GLchar name[bufSize];
+    GLsizei length;
+
+    uniformLocations.clear();
+    uniformBlocks.clear();
+
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &nUniforms);
+    for (GLint i = 0; i < nUniforms; i++) {
+        glGetActiveUniform(ID, (GLuint)i, bufSize, &length, &size, &type, name);
+        GLint location = glGetUniformLocation(ID, name);
+        if (location < 0) { continue; }
+
+        std::string uniformName(name, length);
+        uniformLocations[uniformName] = location;
+        if (uniformName.size() > 3 && uniformName.ends_with("[0]")) {
+            uniformLocations[uniformName.substr(0, uniformName.size() - 3)] = location;
+        }
+    }
+
+    GLint nBlocks;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_BLOCKS, &nBlocks);
+    for (GLint i = 0; i < nBlocks; i++) {
+        glGetActiveUniformBlockName(ID, (GLuint)i, bufSize, &length, name);
+        uniformBlocks[std::string(name, length)] = (GLuint)i;
     }
 }
 
 /**
- * @brief Destroy the Shader object
+ * @brief Destroy the Shader object. The program is deleted with the last shader sharing it.
  * 
  */
 Shader::~Shader() {
     slotBindings.clear();
-    glDeleteProgram(ID);
+    if (boundProgram == ID && program.use_count() == 1) { boundProgram = 0; }
 }
 
 /**
- * @brief Uses the shader program for rendering
+ * @brief Uses the shader program for rendering. Skips the driver call if the program is already in use.
  * 
  */
 void Shader::use() { 
+    if (boundProgram == ID) { return; }
     glUseProgram(ID); 
+    boundProgram = ID;
 }
 
 /**
@@ -319,7 +251,14 @@ void Shader::bindTextureToSlot(const char* name, GLuint texID, GLenum target, un
 
     slotBindings[slot] = { texID, target };
 
-    setUniform(name, (int)slot);
+    // Sampler values are program state, so they only need to be written when they change
+    GLint location = getUniformLocation(name);
+    if (location < 0) { return; }
+    auto [sampler, inserted] = program->samplerSlots.try_emplace(location, (int)slot);
+    if (inserted || sampler->second != (int)slot) {
+        sampler->second = (int)slot;
+        glUniform1i(location, (int)slot);
+    }
 }
 
 /**
@@ -374,9 +313,15 @@ void Shader::bind(const char* name, FBO* fbo, unsigned int slot) {
  * @param slot Slot to bind the ubo [0-15]
  */
 void Shader::bind(const char* name, UBO* ubo, unsigned int slot) {
-    use();
-    unsigned int blockIndex = glGetUniformBlockIndex(ID, name);
-    glUniformBlockBinding(ID, blockIndex, slot);
+    auto block = uniformBlocks.find(name);
+    if (block == uniformBlocks.end()) { return; }
+
+    // The block to binding point mapping is program state, only the buffer binding is global
+    auto [binding, inserted] = program->blockBindings.try_emplace(block->second, slot);
+    if (inserted || binding->second != slot) {
+        binding->second = slot;
+        glUniformBlockBinding(ID, block->second, slot);
+    }
     glBindBufferBase(GL_UNIFORM_BUFFER, slot, ubo->getID());
 }
 
@@ -392,7 +337,8 @@ void Shader::bind(const char* name, Cubemap* cubemap, unsigned int slot) {
  * @return int 
  */
 int Shader::getUniformLocation(const char* name){
-    return glGetUniformLocation(ID, name);
+    auto it = uniformLocations.find(name);
+    return it == uniformLocations.end() ? -1 : it->second;
 }
 
 /**
@@ -402,8 +348,10 @@ int Shader::getUniformLocation(const char* name){
  * @param value Value to set the uniform
  */
 void Shader::setUniform(const char* name, float value) { 
+    GLint location = getUniformLocation(name);
+    if (location < 0) { return; }
     use();
-    glUniform1f(getUniformLocation(name), value); 
+    glUniform1f(location, value); 
 }
 
 /**
@@ -423,18 +371,35 @@ void Shader::setUniform(const char* name, double value) {
  * @param value Value to set the uniform
  */
 void Shader::setUniform(const char* name, int value) { 
+    GLint location = getUniformLocation(name);
+    if (location < 0) { return; }
     use();
-    glUniform1i(getUniformLocation(name), value); 
+    glUniform1i(location, value); 
+
+    // Keep the sampler cache honest when a sampler is set directly
+    auto sampler = program->samplerSlots.find(location);
+    if (sampler != program->samplerSlots.end()) { sampler->second = value; }
 }
 
 void Shader::setUniform(const char* name, glm::vec2 value) { 
+    GLint location = getUniformLocation(name);
+    if (location < 0) { return; }
     use();
-    glUniform2fv(getUniformLocation(name), 1, glm::value_ptr(value)); 
+    glUniform2fv(location, 1, glm::value_ptr(value)); 
 }
 
 void Shader::setUniform(const char* name, glm::vec3 value) { 
+    GLint location = getUniformLocation(name);
+    if (location < 0) { return; }
+    use();
+    glUniform3fv(location, 1, glm::value_ptr(value)); 
+}
+
+void Shader::setUniform(const char* name, glm::ivec3 value) { 
+    GLint location = getUniformLocation(name);
+    if (location < 0) { return; }
     use();
-    glUniform3fv(getUniformLocation(name), 1, glm::value_ptr(value)); 
+    glUniform3iv(location, 1, glm::value_ptr(value)); 
 }
 
 /**
@@ -444,8 +409,10 @@ void Shader::setUniform(const char* name, glm::vec3 value) {
  * @param value Value to set the uniform
  */
 void Shader::setUniform(const char* name, glm::mat4 value) { 
+    GLint location = getUniformLocation(name);
+    if (location < 0) { return; }
     use();
-    glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));  
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));  
 }
 
 }
\ No newline at end of file
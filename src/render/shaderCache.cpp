@@ -0,0 +1,354 @@
+#include <basilisk/render/shaderCache.h>
+#include <basilisk/util/hash.h>
+#include <basilisk/util/cacheFile.h>
+#include <regex>
+
+// Not part of the GL 3.3 headers, from GL 4.1 / ARB_get_program_binary
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+
+namespace bsk::internal {
+
+typedef void (APIENTRYP GetProgramBinaryProc)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP ProgramBinaryProc)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void (APIENTRYP ProgramParameteriProc)(GLuint program, GLenum pname, GLint value);
+
+static GetProgramBinaryProc getProgramBinary = nullptr;
+static ProgramBinaryProc programBinary = nullptr;
+static ProgramParameteriProc programParameteri = nullptr;
+
+/**
+ * @brief Expand a shader file and its includes into one source string
+ *
+ * @param filepath Path of the file to expand
+ * @param includedFiles Files already expanded, each file is only included once
+ * @param isRootFile Only the root file keeps its #version line
+ * @return std::string
+ */
+static std::string loadShaderSource(std::string filepath, std::unordered_set<std::string>& includedFiles, bool isRootFile) {
+    // Mark as included
+    std::replace(filepath.begin(), filepath.end(), '\\', '/');
+    includedFiles.insert(filepath);
+
+    // Open the file
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << filepath << std::endl;
+        return "";
+    }
+
+    // Get directory of file
+    std::filesystem::path currentFilePath(filepath);
+    std::filesystem::path currentDir = currentFilePath.parent_path();
+
+    std::string line;
+    std::stringstream fullSource;
+
+    // Regex for #include "path/to/file.glsl"
+    static const std::regex includeRegex(R"(#include\s+["<](.*)[">])");
+    // Regex for #version
+    static const std::regex versionRegex(R"(#version\s+.*)");
+
+    while (std::getline(file, line)) {
+
+        // Filter out #version unless at root
+        if (std::regex_match(line, versionRegex)) {
+            if (isRootFile) {
+                fullSource << line << "\n";
+            }
+            continue;
+        }
+
+        // Add include files if needed
+        std::smatch match;
+        if (std::regex_search(line, match, includeRegex)) {
+            std::string includeName = match[1].str();
+            std::filesystem::path includePath = currentDir / includeName;
+            std::string includePathStr = includePath.string();
+            std::replace(includePathStr.begin(), includePathStr.end(), '\\', '/');
+
+            if (!includedFiles.contains(includePathStr)) {
+                fullSource << "// == Begin "  << includePathStr << " include ==\n";
+                fullSource << "\n" << loadShaderSource(includePathStr, includedFiles, false) << "\n";
+                fullSource << "// == End "  << includePathStr << " include ==\n";
+            }
+        }
+        // Add line as is if not an include
+        else {
+            fullSource << line << "\n";
+        }
+    }
+
+    return fullSource.str();
+}
+
+/**
+ * @brief Compiles a shader from source code and returns the ID.
+ *
+ * @param source C-String containg the shader source code
+ * @param shaderType The type of shader. May be GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+ * @return unsigned int of the shader ID
+ */
+static unsigned int loadShader(const std::string& source, unsigned int shaderType) {
+    int success;
+    char infoLog[512];
+
+    // Load Shader
+    unsigned int shader = glCreateShader(shaderType);
+    const char* sourceCode = source.c_str();
+    glShaderSource(shader, 1, &sourceCode, NULL);
+    glCompileShader(shader);
+
+    // Check for compilation errors
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cout << "ERROR::SHADER::COMPILATION_FAILED\n" << infoLog << std::endl;
+    }
+
+    return shader;
+}
+
+/**
+ * @brief Links a shader program given a vertex and fragment shader. Returns program ID.
+ *
+ * @param vertex ID of the vertex shader
+ * @param fragment ID of the fragment shader
+ * @param retrievable Ask the driver to keep the binary around for glGetProgramBinary
+ * @param success Set to whether linking succeeded
+ * @return unsigned int
+ */
+static unsigned int loadProgram(unsigned int vertex, unsigned int fragment, bool retrievable, int& success) {
+    char infoLog[512];
+
+    // Shader program
+    unsigned int program = glCreateProgram();
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    if (retrievable) { programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE); }
+    glLinkProgram (program);
+
+    // Check for linking errors
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if(!success)
+    {
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+    }
+
+    return program;
+}
+
+/**
+ * @brief Get the expanded source of a shader file. Reused until the file or any file it includes is modified.
+ *
+ * @param path Resolved path of the root shader file
+ * @return const std::string& Empty if the file could not be read
+ */
+const std::string& ShaderCache::getSource(const std::string& path) {
+    auto it = sources.find(path);
+    if (it != sources.end()) {
+        bool current = true;
+        for (const auto& [file, writeTime] : it->second.files) {
+            std::error_code error;
+            if (std::filesystem::last_write_time(file, error) != writeTime || error) {
+                current = false;
+                break;
+            }
+        }
+        if (current) { return it->second.source; }
+    }
+
+    std::unordered_set<std::string> includedFiles;
+    SourceEntry entry;
+    entry.source = loadShaderSource(path, includedFiles, true);
+    for (const std::string& file : includedFiles) {
+        std::error_code error;
+        entry.files.push_back({ file, std::filesystem::last_write_time(file, error) });
+    }
+
+    // Failed reads are not kept so a missing file is retried next time
+    if (entry.source.empty()) {
+        sources.erase(path);
+        static const std::string empty;
+        return empty;
+    }
+
+    SourceEntry& stored = sources[path];
+    stored = std::move(entry);
+    return stored.source;
+}
+
+/**
+ * @brief Get the program for a pair of sources. Shared with any live Shader built from the same sources,
+ *        otherwise loaded from the binary cache, otherwise compiled and stored in the binary cache.
+ *
+ * @param vertexSource Expanded vertex shader source
+ * @param fragmentSource Expanded fragment shader source
+ * @return std::shared_ptr<ShaderProgram>
+ */
+std::shared_ptr<ShaderProgram> ShaderCache::getProgram(const std::string& vertexSource, const std::string& fragmentSource) {
+    uint64_t sourceHash = hashBytes(vertexSource.data(), vertexSource.size());
+    sourceHash = hashBytes(fragmentSource.data(), fragmentSource.size(), sourceHash);
+
+    auto [first, last] = programs.equal_range(sourceHash);
+    for (auto it = first; it != last;) {
+        std::shared_ptr<ShaderProgram> program = it->second.program.lock();
+        if (!program) {
+            it = programs.erase(it);
+            continue;
+        }
+        if (it->second.vertexSource == vertexSource && it->second.fragmentSource == fragmentSource) { return program; }
+        ++it;
+    }
+
+    // The driver is part of the key, an update or a different GPU silently misses instead of failing to load
+    bool binaries = checkBinarySupport();
+    uint64_t key = hashBytes(driver.data(), driver.size(), sourceHash);
+    uint64_t check = hashBytes(fragmentSource.data(), fragmentSource.size(), hashBytes(vertexSource.data(), vertexSource.size(), key));
+
+    GLuint id = binaries ? loadBinary(key, check) : 0;
+    if (!id) {
+        unsigned int vertex   = loadShader(vertexSource,   GL_VERTEX_SHADER);
+        unsigned int fragment = loadShader(fragmentSource, GL_FRAGMENT_SHADER);
+        int success;
+        id = loadProgram(vertex, fragment, binaries, success);
+        glDeleteShader(vertex);
+        glDeleteShader(fragment);
+
+        if (binaries && success) { storeBinary(id, key, check); }
+    }
+
+    std::shared_ptr<ShaderProgram> program = std::make_shared<ShaderProgram>(id);
+    programs.emplace(sourceHash, ProgramEntry{ vertexSource, fragmentSource, program });
+    return program;
+}
+
+/**
+ * @brief Resolve the program binary entry points and check the driver offers at least one binary format.
+ *        Needs a current context, the result is kept for the rest of the process.
+ *
+ * @return true if programs can be saved and loaded as binaries
+ */
+bool ShaderCache::checkBinarySupport() {
+    if (binariesChecked) { return binariesSupported; }
+    binariesChecked = true;
+
+    getProgramBinary = (GetProgramBinaryProc)glfwGetProcAddress("glGetProgramBinary");
+    programBinary = (ProgramBinaryProc)glfwGetProcAddress("glProgramBinary");
+    programParameteri = (ProgramParameteriProc)glfwGetProcAddress("glProgramParameteri");
+    if (!getProgramBinary || !programBinary || !programParameteri) { return false; }
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) { return false; }
+
+    for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+        const GLubyte* value = glGetString(name);
+        if (value) { driver += (const char*)value; }
+        driver += '\n';
+    }
+
+    binariesSupported = true;
+    return true;
+}
+
+/**
+ * @brief Get the file a program binary is cached in
+ *
+ */
+static std::filesystem::path getBinaryPath(uint64_t key) {
+    const std::filesystem::path& directory = ShaderCache::getDirectory();
+    if (directory.empty()) { return {}; }
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bskprog", (unsigned long long)key);
+    return directory / name;
+}
+
+/**
+ * @brief Create a program from its cached binary. The driver may still reject a binary it wrote itself,
+ *        in which case the stale file is removed.
+ *
+ * @return GLuint The linked program, 0 if there is no usable binary
+ */
+GLuint ShaderCache::loadBinary(uint64_t key, uint64_t check) {
+    std::filesystem::path path = getBinaryPath(key);
+    if (path.empty()) { return 0; }
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) { return 0; }
+
+    ShaderCacheHeader header;
+    if (!file.read((char*)&header, sizeof(ShaderCacheHeader))) { return 0; }
+    if (std::memcmp(header.magic, "BSKP", 4) != 0 || header.version != SHADER_CACHE_VERSION) { return 0; }
+    if (header.key != key || header.check != check || header.binaryLength == 0) { return 0; }
+
+    std::vector<char> binary(header.binaryLength);
+    if (!file.read(binary.data(), binary.size())) { return 0; }
+    file.close();
+
+    GLuint program = glCreateProgram();
+    programBinary(program, header.binaryFormat, binary.data(), (GLsizei)binary.size());
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(program);
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        return 0;
+    }
+    return program;
+}
+
+/**
+ * @brief Write a linked program's binary to the cache
+ *
+ */
+void ShaderCache::storeBinary(GLuint program, uint64_t key, uint64_t check) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) { return; }
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    getProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) { return; }
+
+    ShaderCacheHeader header = {};
+    std::memcpy(header.magic, "BSKP", 4);
+    header.version = SHADER_CACHE_VERSION;
+    header.key = key;
+    header.check = check;
+    header.binaryFormat = format;
+    header.binaryLength = (uint32_t)written;
+
+    writeCacheFile(getBinaryPath(key), {
+        { &header, sizeof(ShaderCacheHeader) },
+        { binary.data(), (size_t)written }
+    });
+}
+
+/**
+ * @brief Get the directory program binaries are written to, resolved once per process
+ *
+ * @return const std::filesystem::path& Empty when binaries are not cached
+ */
+const std::filesystem::path& ShaderCache::getDirectory() {
+    static const std::filesystem::path directory = getCacheDirectory("shaders");
+    return directory;
+}
+
+/**
+ * @brief Get the process wide shader cache
+ *
+ * @return ShaderCache&
+ */
+ShaderCache& ShaderCache::getGlobal() {
+    static ShaderCache cache;
+    return cache;
+}
+
+}
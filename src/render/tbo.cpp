@@ -7,8 +7,10 @@ namespace bsk::internal {
  * 
  * @param data Inital data to store
  * @param size Size of the data in bytes
+ * @param reserve Minimum capacity in bytes
+ * @param format Internal format of the texels, GL_RGBA32UI for integer data read with a usamplerBuffer
  */
-TBO::TBO(const void* data, unsigned int size, unsigned int reserve): size(size) { 
+TBO::TBO(const void* data, unsigned int size, unsigned int reserve, GLenum format): size(size), format(format) { 
     capacity = glm::max(size, reserve);
 
     // Create one buffer, and update VBO with the buffer ID
@@ -29,7 +31,7 @@ TBO::TBO(const void* data, unsigned int size, unsigned int reserve): size(size)
     // Bind to the TBO
     glBindTexture(GL_TEXTURE_BUFFER, textureID);
     // Specify the format for texel samples
-    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, ID);
+    glTexBuffer(GL_TEXTURE_BUFFER, format, ID);
     // Unbind texture for safety
     glBindTexture(GL_TEXTURE_BUFFER, 0);
 }
@@ -68,7 +70,7 @@ void TBO::unbind() {
  */
 void TBO::write(const void* data, unsigned int size, unsigned int offset) {
     // Update the capacity if needed
-    if (size + offset > capacity) {
+    while (size + offset > capacity) {
         resize();
     }
     // Update size
@@ -101,9 +103,9 @@ void TBO::resize() {
     ID = newBuffer;
     capacity = newCapacity;
 
-    // Rebind texture to use the new buffer (must match constructor's GL_RGBA32F)
+    // Rebind texture to use the new buffer
     glBindTexture(GL_TEXTURE_BUFFER, textureID);
-    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, ID);
+    glTexBuffer(GL_TEXTURE_BUFFER, format, ID);
     glBindTexture(GL_TEXTURE_BUFFER, 0);
 
     // Unbind for safety
@@ -12,11 +12,25 @@ namespace bsk::internal {
  * @param capacity The inital capacity of the array for preallocation. Will use size of images if not given.
  */
 TextureArray::TextureArray(unsigned int width, unsigned int height, std::vector<Image*> images, unsigned int capacity, unsigned int filter)
-    : width(width), height(height), images(images), samplerFilter(filter) {
+    : width(width), height(height), images(images), samplerFilter(filter), mipmapsDirty(false) {
     this->capacity = glm::max((unsigned int)images.size(), capacity);
+
+    // Linear arrays are minified through a full mip chain, nearest arrays keep their crisp single level
+    levels = filter == GL_NEAREST ? 1 : (unsigned int)std::floor(std::log2((float)std::max(width, height))) + 1;
+
     glGenTextures(1, &id);
     bind();
-    generate();
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, samplerFilter);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : samplerFilter);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);	
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    allocateStorage();
+
+    // Upload the data for each image
+    for (unsigned int i = 0; i < this->images.size(); i++) {
+        uploadImage(this->images.at(i), i);
+    }
     unbind();
 }
 
@@ -29,39 +43,87 @@ TextureArray::~TextureArray() {
 }
 
 /**
- * @brief Generates the array and uploads all the image data from the image vector to this texture array
+ * @brief (Re)specifies every mip level of the bound array with room for capacity layers. Discards the contents.
+ * 
+ */
+void TextureArray::allocateStorage() {
+    for (unsigned int level = 0; level < levels; level++) {
+        unsigned int levelWidth = std::max(1u, width >> level);
+        unsigned int levelHeight = std::max(1u, height >> level);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8, levelWidth, levelHeight, capacity, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    mipmapsDirty = levels > 1;
+}
+
+/**
+ * @brief Copies the base level of the first count layers from one array texture to another on the GPU.
+ *        Each source layer is attached to a read framebuffer and copied into the bound destination.
  * 
  */
-void TextureArray::generate() {
+void TextureArray::copyLayers(unsigned int source, unsigned int destination, unsigned int count) {
+    GLint previousFramebuffer;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousFramebuffer);
 
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, samplerFilter);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, samplerFilter);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);	
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    
-    // Set up the array
-    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, capacity, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    unsigned int framebuffer;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
 
-    // Upload the data for each image
-    for (unsigned int i = 0; i < images.size(); i++) {
-        uploadImage(images.at(i), i); // This now assumes the texture is already bound
+    glBindTexture(GL_TEXTURE_2D_ARRAY, destination);
+    for (unsigned int layer = 0; layer < count; layer++) {
+        glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, source, 0, layer);
+        glCopyTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, 0, 0, width, height);
     }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, previousFramebuffer);
+    glDeleteFramebuffers(1, &framebuffer);
 }
 
 /**
- * @brief Uploads an image to the texture array. Assumes the given position slot is allocated
+ * @brief Grows the array to a new capacity, keeping its layers and its GL name so existing bindings stay valid.
+ *        The layers are parked in a temporary array while the storage is re-specified, all on the GPU.
  * 
+ * @param newCapacity Number of layers to hold
  */
-void TextureArray::uploadImage(Image* image, unsigned int position) {
+void TextureArray::grow(unsigned int newCapacity) {
+    // Only the layers handed out before this growth can hold data
+    unsigned int used = std::min((unsigned int)images.size(), capacity);
+
+    unsigned int parked = 0;
+    if (used > 0) {
+        glGenTextures(1, &parked);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, parked);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, used, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        copyLayers(id, parked, used);
+    }
 
-    unsigned char* data = new unsigned char[width * height * 4];
+    capacity = newCapacity;
+    bind();
+    allocateStorage();
+
+    if (used > 0) {
+        copyLayers(parked, id, used);
+        glDeleteTextures(1, &parked);
+    }
+    unbind();
+}
+
+/**
+ * @brief Resizes an image to the size of this array as RGBA8, using the array's filter. 
+ *        Only reads immutable state, so it is safe to call from worker threads.
+ * 
+ * @param image Image to resize
+ * @param out Destination of getLayerSize() bytes
+ */
+void TextureArray::resize(Image* image, unsigned char* out) const {
     if (samplerFilter == GL_NEAREST) {
         stbir_resize(
             image->getData(),
             image->getWidth(),
             image->getHeight(),
             0,
-            data,
+            out,
             static_cast<int>(width),
             static_cast<int>(height),
             0,
@@ -71,12 +133,23 @@ void TextureArray::uploadImage(Image* image, unsigned int position) {
             STBIR_FILTER_POINT_SAMPLE);
     } else {
         stbir_resize_uint8_linear(
-            image->getData(), image->getWidth(), image->getHeight(), 0, data,
+            image->getData(), image->getWidth(), image->getHeight(), 0, out,
             static_cast<int>(width), static_cast<int>(height), 0, STBIR_RGBA);
     }
+}
+
+/**
+ * @brief Uploads an image to the texture array. Assumes the given position slot is allocated
+ * 
+ */
+void TextureArray::uploadImage(Image* image, unsigned int position) {
+
+    unsigned char* data = new unsigned char[getLayerSize()];
+    resize(image, data);
 
     // Add the resized image data to the texture array
     glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, position, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    mipmapsDirty = levels > 1;
 
     // Free the resized image data
     delete[] data;
@@ -90,21 +163,65 @@ void TextureArray::uploadImage(Image* image, unsigned int position) {
  * @return unsigned int of the location of the image in the array. 
  */
 unsigned int TextureArray::add(Image* image) {
+    unsigned int position = allocate(image);
+
     bind();
-    
-    images.push_back(image);
-    
-    if (images.size() > capacity) {
-        capacity *= 2;
-        generate();
+    uploadImage(image, position);
+    unbind();
+
+    return position;
+}
+
+/**
+ * @brief Reserves a layer for an image without uploading it. Doubles the capacity when full.
+ * 
+ * @param image Pointer to the image the layer is for
+ * @return unsigned int of the location of the image in the array
+ */
+unsigned int TextureArray::allocate(Image* image) {
+    if (images.size() >= capacity) {
+        grow(std::max(1u, capacity * 2));
     }
-    else {
-        uploadImage(image, images.size() - 1);
+
+    images.push_back(image);
+    return images.size() - 1;
+}
+
+/**
+ * @brief Grows the array up front so at least capacity images fit without further growth
+ * 
+ * @param capacity Total number of layers to hold
+ */
+void TextureArray::reserve(unsigned int capacity) {
+    if (capacity > this->capacity) {
+        grow(capacity);
     }
+}
 
+/**
+ * @brief Uploads already resized RGBA8 pixels to an allocated layer
+ * 
+ * @param pixels getLayerSize() bytes of pixel data, or a byte offset into the bound pixel unpack buffer
+ * @param position Layer to write
+ */
+void TextureArray::upload(const void* pixels, unsigned int position) {
+    bind();
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, position, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
     unbind();
+    mipmapsDirty = levels > 1;
+}
 
-    return images.size() - 1;
+/**
+ * @brief Rebuilds the mip chain if layers changed since the last call. 
+ *        Uploads only mark the chain dirty, so a frame adding many images regenerates it once.
+ * 
+ */
+void TextureArray::updateMipmaps() {
+    if (!mipmapsDirty) { return; }
+    bind();
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    unbind();
+    mipmapsDirty = false;
 }
 
 /**
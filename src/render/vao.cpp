@@ -24,6 +24,29 @@ VAO::VAO(Shader* shader, VBO* vertices, EBO* indices): shader(shader), vbo(verti
     }
 }
 
+/**
+ * @brief Construct a new VAO object for vertex data with an explicit format, such as a packed mesh.
+ *        Attribute i of the format feeds the i-th per vertex attribute of the shader, by location order.
+ * 
+ * @param shader The shader to use when rendering the vao
+ * @param vertices The buffer (VBO pointer) of the verticies
+ * @param indices Buffer (EBO pointer) of the indices
+ * @param format Layout of the vertex buffer
+ * @param indexType GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+ */
+VAO::VAO(Shader* shader, VBO* vertices, EBO* indices, const VertexFormat& format, GLenum indexType): shader(shader), vbo(vertices), ebo(indices), indexType(indexType) {
+    glGenVertexArrays(1, &ID);
+
+    bind();
+    vbo->bind();
+    if (ebo) { ebo->bind(); }
+
+    std::vector<Attribute>& attribs = shader->getAttributes();
+    for (unsigned int i = 0; i < attribs.size() && i < format.attributes.size(); i++) {
+        bindAttribute(attribs[i].location, format.attributes[i], format.stride);
+    }
+}
+
 /**
  * @brief Destroy the VAO object and release GPU data
  * 
@@ -112,6 +135,20 @@ void VAO::bindAttribute(GLint location, GLint count, unsigned int dataType, unsi
     glVertexAttribDivisor(location, divisor);
 }
 
+/**
+ * @brief Binds an attribute described by a vertex format on the vao
+ * 
+ * @param location The location of the attribute in the shader source
+ * @param format Component count, type, normalization and offset of the attribute
+ * @param stride Bytes per vertex in the VBO
+ */
+void VAO::bindAttribute(GLint location, const VertexAttributeFormat& format, unsigned int stride, unsigned int divisor) {
+    bind();
+    glVertexAttribPointer(location, format.count, format.type, format.normalized, stride, (const void*)(GLintptr)format.offset);
+    glEnableVertexAttribArray(location);
+    glVertexAttribDivisor(location, divisor);
+}
+
 /**
  * @brief Binds this VAO for rendering
  * 
@@ -133,13 +170,13 @@ void VAO::render(unsigned int instanceCount) {
     
     // Choose render method based on EBO
     if (ebo) {
-        int vertexCount = ebo->getSize() / sizeof(unsigned int);
+        int vertexCount = ebo->getSize() / (indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int));
         
         if (instanceCount) {
-            glDrawElementsInstanced(GL_TRIANGLES, vertexCount, GL_UNSIGNED_INT, 0, instanceCount); 
+            glDrawElementsInstanced(GL_TRIANGLES, vertexCount, indexType, 0, instanceCount); 
         } 
         else {
-            glDrawElements(GL_TRIANGLES, vertexCount, GL_UNSIGNED_INT, 0);
+            glDrawElements(GL_TRIANGLES, vertexCount, indexType, 0);
         }
     }
     else {
@@ -11,13 +11,13 @@ namespace bsk::internal {
  *                 GL_STATIC_DRAW by defult. 
  *                 May also be GL_DYNAMIC_DRAW or GL_STREAM_DRAW.
  */
-VBO::VBO(const void* data, unsigned int size, unsigned int drawType): size(size) {
+VBO::VBO(const void* data, unsigned int size, unsigned int drawType): size(size), drawType(drawType) {
     // Create one buffer, and update VBO with the buffer ID
     glGenBuffers(1, &ID);
     // Bind the vbo to start working on it
     glBindBuffer(GL_ARRAY_BUFFER, ID);
     // Now, we can add our vertex data to the VBO
-    glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, size, data, drawType);
     // Unbind the buffer for safety
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
@@ -71,6 +71,20 @@ void VBO::write(const void* data, unsigned int size, unsigned int offset) {
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+/**
+ * @brief Replaces the VBO storage with a new uninitialized allocation of the given size.
+ *        The driver hands back fresh memory instead of waiting on draws still reading the old storage,
+ *        so this is the cheap way to stream data that is rewritten every frame.
+ * 
+ * @param size The size of the new allocation in bytes
+ */
+void VBO::orphan(unsigned int size) {
+    this->size = size;
+    glBindBuffer(GL_ARRAY_BUFFER, ID);
+    glBufferData(GL_ARRAY_BUFFER, size, nullptr, drawType);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
 /**
  * @brief Writes a vector of data to an existing allocation of the VBO.
  * 
@@ -7,13 +7,13 @@ namespace bsk::internal {
  * 
  */
 LightServer::LightServer() {
-    directionalLightData = std::vector<glm::vec4>(MAX_DIRECTIONAL_LIGHTS * 2);
     pointLightData = std::vector<glm::vec4>(MAX_POINT_LIGHTS * 2);
-    ambientLightData = glm::vec3(0.0, 0.0, 0.0);
+    lightBlock = {};
+    lightBlock.screenSize = glm::vec2(800.0f, 800.0f);
 
-    directionalLightsUBO = new UBO(nullptr, MAX_DIRECTIONAL_LIGHTS * 2 * sizeof(glm::vec4), GL_DYNAMIC_DRAW);
+    lightsUBO = new UBO(&lightBlock, sizeof(LightBlock), GL_DYNAMIC_DRAW);
     pointLightsTBO = new TBO(pointLightData);
-    tileTBO = nullptr;
+    clusterTBO = nullptr;
     lightIndicesTBO = nullptr;
 }
 
@@ -27,8 +27,8 @@ LightServer::~LightServer() {
     ambientLights.clear();
     pythonLightMap.clear();
 
-    delete directionalLightsUBO;
-    delete tileTBO;
+    delete lightsUBO;
+    delete clusterTBO;
     delete lightIndicesTBO;
     delete pointLightsTBO;
 }
@@ -96,211 +96,145 @@ void LightServer::add(std::shared_ptr<AmbientLight> light) {
 }
 
 /**
- * @brief Update the light server
+ * @brief Update the light server. All per-frame light state is gathered into one uniform block and uploaded once.
  * 
  * @param camera The camera to center the point lights around
- * @param shader The shader to write the light data to
  */
-void LightServer::update(Shader* shader, StaticCamera* camera) {
-    updateDirectional(shader);
-    updateAmbient(shader);
-    updatePoint(shader, camera);
+void LightServer::update(StaticCamera* camera) {
+    updateDirectional();
+    updateAmbient();
+    updatePoint(camera);
+
+    lightsUBO->write(&lightBlock, sizeof(LightBlock));
+}
+
+/**
+ * @brief Bind the light block and buffers to a shader. Binding points are global, so this runs before every draw of the scene.
+ * 
+ * @param shader Shader to bind to
+ */
+void LightServer::bind(Shader* shader) {
+    shader->bind("uLights", lightsUBO, LIGHT_BLOCK_BINDING);
+    shader->bind("uPointLights", pointLightsTBO, 15);
+    if (clusterTBO) { shader->bind("uLightClusters", clusterTBO, 7); }
+    if (lightIndicesTBO) { shader->bind("uLightIndices", lightIndicesTBO, 14); }
 }
 
 /**
- * @brief Update and write directional data
+ * @brief Update directional light data
  * 
- * @param shader Shader to write to
  */
-void LightServer::updateDirectional(Shader* shader) {
-    // Get and write all directional light data
+void LightServer::updateDirectional() {
     for (size_t i = 0; i < directionalLights.size(); i++) {
-        directionalLightData[i * 2] = glm::vec4(directionalLights[i]->getColor(), directionalLights[i]->getIntensity());
-        directionalLightData[i * 2 + 1] = glm::vec4(directionalLights[i]->getDirection(), 0.0);
+        lightBlock.directionalLights[i * 2] = glm::vec4(directionalLights[i]->getColor(), directionalLights[i]->getIntensity());
+        lightBlock.directionalLights[i * 2 + 1] = glm::vec4(directionalLights[i]->getDirection(), 0.0);
     }
-    directionalLightsUBO->write(directionalLightData);
-
-    // Bind ubo and upload the number of lights
-    shader->bind("uDirectionalLights", directionalLightsUBO, 0);
-    shader->setUniform("uDirectionalLightCount", (int)directionalLights.size());
+    lightBlock.directionalLightCount = (int)directionalLights.size();
 }
 
 /**
  * @brief Update and write point light data
  * 
- * @param shader Shader to write to
  * @param camera Camera to use for view and to center lights around
  */
-void LightServer::updatePoint(Shader* shader, StaticCamera* camera) {
-    // Sort lights by distance from the camera
-    std::sort(pointLights.begin(), pointLights.end(), [camera](PointLight* a, PointLight* b) {
-        return glm::length(camera->getPosition() - a->getPosition()) < glm::length(camera->getPosition() - b->getPosition());
-    });
+void LightServer::updatePoint(StaticCamera* camera) {
+    selectPointLights(camera);
 
-    // Update tiles
-    updateTiles(camera);
+    // Get and write point lights data, along with their view space bounds for binning
+    glm::mat4 view = camera->getView();
+    lightBounds.resize(selectedLights.size());
+    for (size_t i = 0; i < selectedLights.size(); i++) {
+        PointLight* light = pointLights[selectedLights[i]];
+        pointLightData[i * 2] = glm::vec4(light->getColor(), light->getIntensity());
+        pointLightData[i * 2 + 1] = glm::vec4(light->getPosition(), light->getRange());
+        lightBounds[i] = glm::vec4(glm::vec3(view * glm::vec4(light->getPosition(), 1.0f)), light->getRange());
+    }
+    if (!selectedLights.empty()) {
+        pointLightsTBO->write(pointLightData.data(), selectedLights.size() * 2 * sizeof(glm::vec4));
+    }
 
-    // Get and write point lights data
-    size_t lightCount = std::min(pointLights.size(), static_cast<size_t>(MAX_POINT_LIGHTS));
-    for (size_t i = 0; i < lightCount; i++) {
-        pointLightData[i * 2] = glm::vec4(pointLights[i]->getColor(), pointLights[i]->getIntensity());
-        pointLightData[i * 2 + 1] = glm::vec4(pointLights[i]->getPosition(), pointLights[i]->getRange());
+    // Update clusters
+    updateClusters(camera);
+    lightBlock.pointLightCount = (int)selectedLights.size();
+}
+
+/**
+ * @brief Choose the point lights to upload. If there are more than MAX_POINT_LIGHTS, the nearest to the camera are kept.
+ * 
+ * @param camera Camera to center the lights around
+ */
+void LightServer::selectPointLights(StaticCamera* camera) {
+    selectedLights.resize(pointLights.size());
+    std::iota(selectedLights.begin(), selectedLights.end(), 0);
+    if (pointLights.size() <= MAX_POINT_LIGHTS) { return; }
+
+    // Distances are computed once instead of inside the comparator
+    glm::vec3 cameraPosition = camera->getPosition();
+    lightDistances.resize(pointLights.size());
+    for (size_t i = 0; i < pointLights.size(); i++) {
+        glm::vec3 offset = pointLights[i]->getPosition() - cameraPosition;
+        lightDistances[i] = glm::dot(offset, offset);
     }
-    pointLightsTBO->write(pointLightData);
 
-    // Bind point light tbo
-    shader->bind("uPointLights", pointLightsTBO, 15);
+    // Only the split matters, the order of the kept lights does not
+    std::nth_element(selectedLights.begin(), selectedLights.begin() + MAX_POINT_LIGHTS, selectedLights.end(), [&](unsigned int a, unsigned int b) {
+        return lightDistances[a] < lightDistances[b];
+    });
+    selectedLights.resize(MAX_POINT_LIGHTS);
 }
 
 /**
- * @brief Update and write ambient light data
+ * @brief Update ambient light data
  * 
- * @param shader Shader to write to
  */
-void LightServer::updateAmbient(Shader* shader) {
+void LightServer::updateAmbient() {
     // Get weighted sum of all ambient lights
-    ambientLightData = glm::vec3(0.0, 0.0, 0.0);
+    lightBlock.ambientLight = glm::vec3(0.0, 0.0, 0.0);
     for (AmbientLight* light : ambientLights) {
-        ambientLightData += light->getColor() * light->getIntensity();
+        lightBlock.ambientLight += light->getColor() * light->getIntensity();
     }
-
-    // Write the ambient sum to uniform
-    shader->setUniform("uAmbientLight", ambientLightData);
 }
 
 /**
- * @brief Update the screen tiles with the lights that intersect them
+ * @brief Bin the selected point lights into the camera's clusters and upload the cluster lists
  * 
  * @param camera Camera to use for view
  */
-void LightServer::updateTiles(StaticCamera* camera) {
-    // Clear and reserve space for light indices
-    lightIndices.clear();
-    lightIndices.reserve(tiles.size() * MAX_LIGHTS_PER_TILE);
-    
-    // Cache the view position and range of each light (range for locallity)
-    glm::mat4 view = camera->getView();
-    std::vector<std::pair<glm::vec3, float>> lightData;
-    for (unsigned int i = 0; i < pointLights.size(); ++i) {
-        PointLight* light = pointLights.at(i);
-        glm::vec3 lightPositionViewSpace = glm::vec3(view * glm::vec4(light->getPosition(), 1.0f));
-        lightData.push_back({lightPositionViewSpace, light->getRange()});
-    }
-
-    // Get all lights in each tile
-    for (unsigned int t = 0; t < tiles.size(); ++t) {
-        // Get tile and initialize basic info
-        Tile& tile = tiles.at(t);
-        TileInfo& info = tileInfos.at(t);
-        info.offset = (uint32_t)lightIndices.size();
-        info.count  = 0;
-
-        // Add all lights in the tile
-        for (unsigned int i = 0; i < pointLights.size(); ++i) {
-            // Get light data
-            glm::vec3 lightPositionViewSpace = lightData[i].first;
-            float lightRadius = lightData[i].second;
-            // Check for intersection
-            if (lightIntersectsTile(lightPositionViewSpace, lightRadius, tile)) {
-                lightIndices.push_back(i);
-                info.count++;
-                // Limit lights in tile
-                if (info.count >= MAX_LIGHTS_PER_TILE) { break; }
-            }
-        }
-    }
+void LightServer::updateClusters(StaticCamera* camera) {
+    clusters.setProjection(camera->getProjection(), camera->getNear(), camera->getFar());
+    clusters.bin(lightBounds);
 
     // Write updated tbo data
-    tileTBO->write(tileInfos);
-    lightIndicesTBO->write(lightIndices);
-}
+    clusterTBO->write(clusters.getInfos());
+    lightIndicesTBO->write(clusters.getIndices());
 
-glm::vec3 LightServer::unproject(const glm::mat4& inverseProjection, float x, float y) {
-    glm::vec4 clip(x, y, -1.0f, 1.0f);
-    glm::vec4 view = inverseProjection * clip;
-    return glm::normalize(glm::vec3(view) / view.w);
-}
-
-bool LightServer::lightIntersectsTile(glm::vec3& lightPositionViewSpace, float lightRadius, Tile& tile) {
-    if (lightPositionViewSpace.z - lightRadius > 0.0f)
-        return false;
-
-    for (int i = 0; i < 4; i++) {
-        float distance = glm::dot(tile.planes[i].normal, lightPositionViewSpace);
-        if (distance < -(lightRadius * 1.05)) { return false; }
-    }
-
-    return true;
+    // Slices depend on the near and far plane, which can change between frames
+    lightBlock.clusterScale = clusters.getSliceScale();
+    lightBlock.clusterBias = clusters.getSliceBias();
 }
 
 /**
- * @brief Initialize tiles based on screen and camera
+ * @brief Initialize the cluster buffers for the screen and camera
  * 
- * @param shader 
  * @param camera 
  * @param screenWidth 
  * @param screenHeight 
  */
-void LightServer::setTiles(Shader* shader, StaticCamera* camera, unsigned int screenWidth, unsigned int screenHeight) {
-    // Set number of tiles in each direction
-    tilesX = (unsigned int)ceil((float)screenWidth  / (float)TILE_SIZE);
-    tilesY = (unsigned int)ceil((float)screenHeight / (float)TILE_SIZE);
-    unsigned int tileCount = tilesX * tilesY;
-
-    // Resize tile structures 
-    tiles.resize(tileCount);
-    tileInfos.resize(tileCount);
-    lightIndices.resize(tileCount * MAX_LIGHTS_PER_TILE);
-
-    // Get camera projection and inverse projection
-    glm::mat4 projection = camera->getProjection();
-    glm::mat4 inverseProjection = glm::inverse(projection);
-
-    // Loop through each tile
-    for (unsigned int ty = 0; ty < tilesY; ++ty) {
-        for (unsigned int tx = 0; tx < tilesX; ++tx) {
-            // Get tile
-            unsigned int tileIndex = ty * tilesX + tx;
-            Tile& tile = tiles.at(tileIndex);
-
-            // Calculate the corners of the tile ([0, 1] spae)
-            float x0 = float(tx * TILE_SIZE) / screenWidth;
-            float x1 = float((tx + 1) * TILE_SIZE) / screenWidth;
-            float y0 = float(ty * TILE_SIZE) / screenHeight;
-            float y1 = float((ty + 1) * TILE_SIZE) / screenHeight;
-
-            // Convert to NDC space ([-1, 1] space)
-            float ndcX0 = x0 * 2.0f - 1.0f;
-            float ndcX1 = x1 * 2.0f - 1.0f;
-            float ndcY0 = y0 * 2.0f - 1.0f;
-            float ndcY1 = y1 * 2.0f - 1.0f;
-
-            // Unproject to view space
-            glm::vec3 rayBL = unproject(inverseProjection, ndcX0, ndcY0);
-            glm::vec3 rayBR = unproject(inverseProjection, ndcX1, ndcY0);
-            glm::vec3 rayTR = unproject(inverseProjection, ndcX1, ndcY1);
-            glm::vec3 rayTL = unproject(inverseProjection, ndcX0, ndcY1);
-
-            // Calculate the planes of the tile (normals pointing inward)
-            tile.planes[0].normal = glm::normalize(glm::cross(rayTL, rayBL));
-            tile.planes[1].normal = glm::normalize(glm::cross(rayBR, rayTR));
-            tile.planes[2].normal = glm::normalize(glm::cross(rayBL, rayBR));
-            tile.planes[3].normal = glm::normalize(glm::cross(rayTR, rayTL));
-        }
-    }    
+void LightServer::setClusters(StaticCamera* camera, unsigned int screenWidth, unsigned int screenHeight) {
+    clusters.setProjection(camera->getProjection(), camera->getNear(), camera->getFar());
+    lightBlock.screenSize = glm::vec2((float)screenWidth, (float)screenHeight);
+    lightBlock.clusterGrid = glm::ivec3(clusters.getClustersX(), clusters.getClustersY(), clusters.getSlices());
+    lightBlock.clusterScale = clusters.getSliceScale();
+    lightBlock.clusterBias = clusters.getSliceBias();
 
     // Delete any existing TBOs
-    if (tileTBO) { delete tileTBO; }
+    if (clusterTBO) { delete clusterTBO; }
     if (lightIndicesTBO) { delete lightIndicesTBO; }
 
-    // Reallocate
-    tileTBO = new TBO(tileInfos);
-    lightIndicesTBO = new TBO(lightIndices);
-    
-    // Bind TBOs
-    shader->bind("uLightTiles", tileTBO, 7);
-    shader->bind("uLightIndices", lightIndicesTBO, 14);
+    // Reallocate. Both hold unsigned integers, four per texel.
+    clusterTBO = new TBO(clusters.getInfos(), 0, GL_RGBA32UI);
+    lightIndicesTBO = new TBO(clusters.getIndices(), clusters.getClusterCount() * sizeof(uint32_t), GL_RGBA32UI);
 }
 
 
-}   
\ No newline at end of file
+}
\ No newline at end of file
@@ -22,17 +22,10 @@ unsigned int MaterialServer::get(Material* material) {
 }
 
 /**
- * @brief Add a new material to the server. 
+ * @brief Get the TBO data of a material with its texture locations filled in
  * 
- * @param material The material to add
- * @return unsigned int Location of the material in the tbo. 
  */
-unsigned int MaterialServer::add(Material* material) {
-    // Do not add if the material is ready on the tbo
-    if (materialMapping.count(material)) {
-        return get(material);
-    }
-
+MaterialData MaterialServer::resolve(Material* material) {
     // Get the material data
     MaterialData data = material->getData();
     
@@ -46,14 +39,80 @@ unsigned int MaterialServer::add(Material* material) {
     data.normalArray = normal.first;
     data.normalIndex = normal.second;
 
-    // Write the material data to the next open slot of the tbo
-    tbo->write(&data, sizeof(data), tbo->getSize());
+    return data;
+}
 
-    // Add the material to the mapping
-    unsigned int index = materialMapping.size();
-    materialMapping[material] = index;
+/**
+ * @brief Get a slot holding the given data, sharing an existing one if the contents match
+ * 
+ * @return unsigned int Slot with one more reference
+ */
+unsigned int MaterialServer::acquire(const MaterialData& data) {
+    uint64_t hash = hashBytes(&data, sizeof(MaterialData));
+    auto [first, last] = contentMapping.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        if (std::memcmp(&slotData[it->second], &data, sizeof(MaterialData)) == 0) {
+            slotReferences[it->second]++;
+            return it->second;
+        }
+    }
 
-    return index;
+    // Reuse a released slot before growing the tbo
+    unsigned int slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        slotData[slot] = data;
+    }
+    else {
+        slot = slotData.size();
+        slotData.push_back(data);
+        slotReferences.push_back(0);
+    }
+    slotReferences[slot] = 1;
+    contentMapping.emplace(hash, slot);
+
+    tbo->write(&data, sizeof(MaterialData), slot * sizeof(MaterialData));
+    return slot;
+}
+
+/**
+ * @brief Drop one reference to a slot, freeing it for new contents when none remain
+ * 
+ */
+void MaterialServer::release(unsigned int slot) {
+    if (--slotReferences[slot] > 0) { return; }
+
+    uint64_t hash = hashBytes(&slotData[slot], sizeof(MaterialData));
+    auto [first, last] = contentMapping.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        if (it->second == slot) {
+            contentMapping.erase(it);
+            break;
+        }
+    }
+    freeSlots.push_back(slot);
+}
+
+/**
+ * @brief Add a new material to the server. 
+ * 
+ * @param material The material to add
+ * @return unsigned int Location of the material in the tbo. 
+ */
+unsigned int MaterialServer::add(Material* material) {
+    // Do not add if the material is ready on the tbo
+    if (materialMapping.count(material)) {
+        return get(material);
+    }
+
+    unsigned int slot = acquire(resolve(material));
+    materialMapping[material] = slot;
+    if (isPending(material)) {
+        pendingMaterials.insert(material);
+    }
+
+    return slot;
 }
 
 void MaterialServer::write(Shader* shader, std::string name, unsigned int slot) {
@@ -62,25 +121,60 @@ void MaterialServer::write(Shader* shader, std::string name, unsigned int slot)
 
 void MaterialServer::update(Material* material) {
     // If material was never added add it
-    if (materialMapping.count(material) == 0) {
+    auto it = materialMapping.find(material);
+    if (it == materialMapping.end()) {
         add(material);
         return;
     }
 
-    // Get the material data
-    MaterialData data = material->getData();
-    // Get the location of the albedo and noraml maps in theif texture server
-    std::pair<unsigned int, unsigned int> albedo = textureServer->add(material->getAlbedo());
-    std::pair<unsigned int, unsigned int> normal = textureServer->add(material->getNormal());
-    
-    // Update material data to have correct texture array locations
-    data.albedoArray = albedo.first;
-    data.albedoIndex = albedo.second;
-    data.normalArray = normal.first;
-    data.normalIndex = normal.second;
+    MaterialData data = resolve(material);
+    if (isPending(material)) {
+        pendingMaterials.insert(material);
+    }
+    if (std::memcmp(&slotData[it->second], &data, sizeof(MaterialData)) == 0) { return; }
 
-    // Write the material data to the tbo
-    tbo->write(&data, sizeof(data), get(material) * sizeof(MaterialData));
+    // Acquire before releasing so a slot this material holds alone is not freed and rewritten in between
+    unsigned int slot = acquire(data);
+    release(it->second);
+    it->second = slot;
+}
+
+/**
+ * @brief Forget a material, releasing its slot. Called when a material is destroyed so its address can be reused safely.
+ * 
+ * @param material The material to remove
+ */
+void MaterialServer::remove(Material* material) {
+    auto it = materialMapping.find(material);
+    if (it == materialMapping.end()) { return; }
+
+    release(it->second);
+    materialMapping.erase(it);
+    pendingMaterials.erase(material);
+}
+
+/**
+ * @brief Check if any image of a material is still loading and mapped to the default image
+ * 
+ */
+bool MaterialServer::isPending(Material* material) const {
+    return textureServer->isPending(material->getAlbedo()) || textureServer->isPending(material->getNormal());
+}
+
+/**
+ * @brief Rewrite the materials whose images finished loading since they were written, so they point at the real textures
+ * 
+ */
+void MaterialServer::refresh() {
+    for (auto it = pendingMaterials.begin(); it != pendingMaterials.end();) {
+        Material* material = *it;
+        if (isPending(material)) {
+            ++it;
+            continue;
+        }
+        it = pendingMaterials.erase(it);
+        update(material);
+    }
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include <basilisk/resource/meshServer.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief Destroy the Mesh Server object and release all GPU buffers still held
+ * 
+ */
+MeshServer::~MeshServer() {
+    for (auto& [vao, binding] : vaoBindings) {
+        delete vao;
+    }
+    for (auto& [mesh, buffers] : meshBuffers) {
+        delete buffers.vbo;
+        delete buffers.ebo;
+    }
+}
+
+/**
+ * @brief Get a VAO for drawing the mesh with the given shader. 
+ *        The mesh data is only uploaded the first time it is acquired. Every acquire must be paired with a release. 
+ *        Meshes with a known layout are uploaded packed, with quantized attributes and 16 bit indices where possible.
+ * 
+ * @param mesh The mesh to draw
+ * @param shader The shader the VAO attributes are laid out for
+ * @return VAO* Shared VAO, owned by the server
+ */
+VAO* MeshServer::acquire(Mesh* mesh, Shader* shader) {
+    // Reuse the VAO if this mesh is already bound for this shader
+    auto it = vaoMapping.find({ mesh, shader });
+    if (it != vaoMapping.end()) {
+        vaoBindings.at(it->second).references++;
+        return it->second;
+    }
+
+    // Upload the mesh if no node is using it yet
+    auto [bufferIt, inserted] = meshBuffers.try_emplace(mesh, MeshBuffers{ nullptr, nullptr, 0, {}, GL_UNSIGNED_INT });
+    MeshBuffers& buffers = bufferIt->second;
+    if (inserted) {
+        if (mesh->hasLayout() && !mesh->getIndices().empty()) {
+            PackedMesh packed = packMesh(*mesh, mesh->getQuantize());
+            buffers.vbo = new VBO(packed.vertices);
+            buffers.ebo = new EBO(packed.indices);
+            buffers.format = std::move(packed.format);
+            buffers.indexType = packed.indexType;
+        }
+        else {
+            buffers.vbo = new VBO(mesh->getVertices());
+            buffers.ebo = mesh->getIndices().empty() ? nullptr : new EBO(mesh->getIndices());
+        }
+    }
+    buffers.references++;
+
+    VAO* vao = buffers.format.attributes.empty()
+        ? new VAO(shader, buffers.vbo, buffers.ebo)
+        : new VAO(shader, buffers.vbo, buffers.ebo, buffers.format, buffers.indexType);
+    vaoMapping[{ mesh, shader }] = vao;
+    vaoBindings[vao] = { mesh, shader, 1 };
+    return vao;
+}
+
+/**
+ * @brief Release a VAO previously returned by acquire. Buffers are deleted once nothing references them. 
+ * 
+ * @param vao The VAO to release
+ */
+void MeshServer::release(VAO* vao) {
+    auto it = vaoBindings.find(vao);
+    if (it == vaoBindings.end()) { return; }
+
+    ShaderBinding& binding = it->second;
+    if (--binding.references > 0) { return; }
+
+    Mesh* mesh = binding.mesh;
+    vaoMapping.erase({ mesh, binding.shader });
+    vaoBindings.erase(it);
+    delete vao;
+
+    MeshBuffers& buffers = meshBuffers.at(mesh);
+    if (--buffers.references > 0) { return; }
+
+    delete buffers.vbo;
+    delete buffers.ebo;
+    meshBuffers.erase(mesh);
+}
+
+}
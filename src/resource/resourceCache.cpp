@@ -0,0 +1,150 @@
+#include <basilisk/resource/resourceCache.h>
+#include <basilisk/util/resolvePath.h>
+#include <basilisk/util/hash.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief Resolve a user path to one spelling per file, so different relative paths to it share an entry
+ *
+ */
+std::string ResourceCache::canonicalPath(const std::string& path) {
+    std::error_code error;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(externalPath(path), error);
+    return error ? externalPath(path) : canonical.string();
+}
+
+/**
+ * @brief Count a lookup and sweep released entries every RESOURCE_CACHE_PRUNE_INTERVAL lookups
+ *
+ */
+void ResourceCache::countLookup() {
+    if (++lookupsSincePrune >= RESOURCE_CACHE_PRUNE_INTERVAL) {
+        prune();
+    }
+}
+
+/**
+ * @brief Get the mesh of a model file, importing it only if no live handle to it exists
+ *
+ * @param path Path to the model
+ * @param generateUV Generate texture coordinates if the model has none
+ * @param generateNormals Generate smooth normals if the model has none
+ * @return std::shared_ptr<Mesh>
+ */
+std::shared_ptr<Mesh> ResourceCache::getMesh(const std::string& path, bool generateUV, bool generateNormals) {
+    countLookup();
+    std::string key = canonicalPath(path) + (generateUV ? "|uv" : "") + (generateNormals ? "|normals" : "");
+
+    std::weak_ptr<Mesh>& entry = meshPaths[key];
+    if (std::shared_ptr<Mesh> mesh = entry.lock()) {
+        return mesh;
+    }
+
+    std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>(path, generateUV, generateNormals);
+    entry = mesh;
+    return mesh;
+}
+
+/**
+ * @brief Get a mesh with the given vertex and index data, reusing a live mesh with identical contents
+ *
+ * @param vertices Interleaved vertex floats
+ * @param indices Triangle indices, empty for unindexed meshes
+ * @return std::shared_ptr<Mesh>
+ */
+std::shared_ptr<Mesh> ResourceCache::getMesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices) {
+    countLookup();
+    uint64_t hash = hashBytes(vertices.data(), vertices.size() * sizeof(float));
+    hash = hashBytes(indices.data(), indices.size() * sizeof(unsigned int), hash);
+
+    auto [first, last] = meshContents.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        std::shared_ptr<Mesh> mesh = it->second.lock();
+        if (mesh && mesh->getVertices() == vertices && mesh->getIndices() == indices) {
+            return mesh;
+        }
+    }
+
+    std::shared_ptr<Mesh> mesh = indices.empty() ? std::make_shared<Mesh>(vertices) : std::make_shared<Mesh>(vertices, indices);
+    meshContents.emplace(hash, mesh);
+    return mesh;
+}
+
+/**
+ * @brief Get the image of a file, decoding it only if no live handle to it exists
+ *
+ * @param path Path to the image
+ * @param flipVertically Flip the rows so the first row is the bottom of the image
+ * @param async Decode on the loader pool. A synchronous request for an image still loading waits for it.
+ * @return std::shared_ptr<Image>
+ */
+std::shared_ptr<Image> ResourceCache::getImage(const std::string& path, bool flipVertically, bool async) {
+    countLookup();
+    std::string key = canonicalPath(path) + (flipVertically ? "|flip" : "");
+
+    std::weak_ptr<Image>& entry = imagePaths[key];
+    if (std::shared_ptr<Image> image = entry.lock()) {
+        if (!async) { image->wait(); }
+        return image;
+    }
+
+    std::shared_ptr<Image> image = std::make_shared<Image>(path, flipVertically, async);
+    entry = image;
+    return image;
+}
+
+/**
+ * @brief Get an image from float pixel data, reusing a live image with identical pixels
+ *
+ * @param data Pixel values in [0, 1]
+ * @param width Image width
+ * @param height Image height
+ * @param nChannels Number of channels
+ * @return std::shared_ptr<Image>
+ */
+std::shared_ptr<Image> ResourceCache::getImage(const std::vector<float>& data, int width, int height, int nChannels) {
+    countLookup();
+
+    // Hash the converted bytes, different floats can quantize to the same pixels
+    std::shared_ptr<Image> image = std::make_shared<Image>(data, width, height, nChannels);
+    if (!image->getData()) { return image; }
+    size_t size = (size_t)width * height * nChannels;
+    uint64_t hash = hashBytes(image->getData(), size, ((uint64_t)width << 32) ^ (uint64_t)height);
+
+    auto [first, last] = imageContents.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        std::shared_ptr<Image> existing = it->second.lock();
+        if (existing && existing->getWidth() == width && existing->getHeight() == height && existing->getData()
+            && std::memcmp(existing->getData(), image->getData(), size) == 0) {
+            return existing;
+        }
+    }
+
+    imageContents.emplace(hash, image);
+    return image;
+}
+
+/**
+ * @brief Evict every entry whose resource has been released
+ *
+ * @return unsigned int Number of entries evicted
+ */
+unsigned int ResourceCache::prune() {
+    lookupsSincePrune = 0;
+    auto expired = [](const auto& entry) { return entry.second.expired(); };
+    return std::erase_if(meshPaths, expired) + std::erase_if(meshContents, expired)
+         + std::erase_if(imagePaths, expired) + std::erase_if(imageContents, expired);
+}
+
+/**
+ * @brief Get the cache shared by the bindings and the engine
+ *
+ * @return ResourceCache&
+ */
+ResourceCache& ResourceCache::getGlobal() {
+    static ResourceCache cache;
+    return cache;
+}
+
+}
@@ -20,6 +20,7 @@ Skybox*   ResourceServer::defaultSkybox = nullptr;
 ResourceServer::ResourceServer(std::vector<unsigned int> textureSizeBuckets, unsigned int textureFilter) {
     textureServer = new TextureServer(textureSizeBuckets, textureFilter);
     materialServer = new MaterialServer(textureServer);
+    meshServer = new MeshServer();
     
     // Initialize static resources that require Assimp (deferred to avoid static init order issues)
     if (defaultCube == nullptr) {
@@ -46,6 +47,7 @@ ResourceServer::ResourceServer(std::vector<unsigned int> textureSizeBuckets, uns
 ResourceServer::~ResourceServer() {
     delete textureServer;
     delete materialServer;
+    delete meshServer;
 }
 
 void ResourceServer::write(Shader* shader, std::string textureUniform, std::string materialUniform, unsigned int startingSlot) {
@@ -53,4 +55,14 @@ void ResourceServer::write(Shader* shader, std::string textureUniform, std::stri
     textureServer->write(shader, textureUniform, startingSlot + 1);
 }
 
+/**
+ * @brief Commit async textures that finished loading and repoint the materials using them. Call once per frame on the GL thread.
+ * 
+ */
+void ResourceServer::update() {
+    if (textureServer->update()) {
+        materialServer->refresh();
+    }
+}
+
 }
\ No newline at end of file
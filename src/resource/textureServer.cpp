@@ -1,4 +1,6 @@
 #include <basilisk/resource/textureServer.h>
+#include <basilisk/util/threadPool.h>
+#include <basilisk/util/hash.h>
 
 namespace bsk::internal {
 
@@ -7,17 +9,27 @@ namespace bsk::internal {
  * 
  * @param sizeBuckets Vector of sizes for the texture arrays. All images will be clamped to these values. 
  */
-TextureServer::TextureServer(std::vector<unsigned int> sizeBuckets, unsigned int filter): sizeBuckets(sizeBuckets) {
+TextureServer::TextureServer(std::vector<unsigned int> sizeBuckets, unsigned int filter): sizeBuckets(sizeBuckets), stagingIndex(0), uploadBudget(TEXTURE_UPLOAD_BUDGET) {
     for (unsigned int size : sizeBuckets) {
         TextureArray* array = new TextureArray(size, size, {}, 1, filter);
         textureArrays.push_back(array);
     }
+    for (PBO*& pbo : stagingRing) {
+        pbo = new PBO();
+    }
 }
 
 TextureServer::~TextureServer() {
+    // Loader jobs still resizing write into the pending uploads and read the arrays
+    for (std::unique_ptr<PendingUpload>& upload : pendingUploads) {
+        upload->ready.wait(false, std::memory_order_acquire);
+    }
     for (TextureArray* array : textureArrays) {
         delete array;
     }
+    for (PBO* pbo : stagingRing) {
+        delete pbo;
+    }
 }
 
 /**
@@ -26,7 +38,7 @@ TextureServer::~TextureServer() {
  * @param x Value to clamp
  * @return unsigned int 
  */
-unsigned int TextureServer::getClosestSize(unsigned int x) {
+unsigned int TextureServer::getClosestSize(unsigned int x) const {
     return *std::min_element(sizeBuckets.begin(), sizeBuckets.end(),
         [x](unsigned int a, unsigned int b) { 
             return std::abs((int)a - (int)x) < std::abs((int)b - (int)x);
@@ -34,8 +46,21 @@ unsigned int TextureServer::getClosestSize(unsigned int x) {
     );
 }
 
+/**
+ * @brief Get the index of the array whose bucket size is closest to a width
+ * 
+ * @param width Width of the image
+ * @return int 
+ */
+int TextureServer::getArrayIndex(unsigned int width) const {
+    unsigned int size = getClosestSize(width);
+    auto it = std::find(sizeBuckets.begin(), sizeBuckets.end(), size);
+    return (it != sizeBuckets.end()) ? std::distance(sizeBuckets.begin(), it) : -1;
+}
+
 /**
  * @brief Adds an image to the array and returns it mapping as a pair <index of the array, index in the array>
+ *        Async images are decoded and resized on the loader pool. They map to the default image until update() commits them.
  * 
  * @param image Pointer to the image to add to the server
  * @return std::pair<unsigned int, unsigned int> 
@@ -52,12 +77,23 @@ std::pair<unsigned int, unsigned int> TextureServer::add(Image* image) {
         return get(image);
     }
 
-    // Get the buckest size to add this image to. Will likely resize the image. 
-    unsigned int size = getClosestSize(image->getWidth());
+    if (image->isAsync()) {
+        addAsync(image);
+        return {0, 0};
+    }
 
-    // Get the index of the closest bucket size
-    auto it = std::find(sizeBuckets.begin(), sizeBuckets.end(), size);
-    int arrayIndex = (it != sizeBuckets.end()) ? std::distance(sizeBuckets.begin(), it) : -1;
+    // Images with the same pixels as one already uploaded share its layer
+    uint64_t hash = hashPixels(image);
+    if (image->getData()) {
+        auto it = contentMapping.find(hash);
+        if (it != contentMapping.end()) {
+            imageMapping[image] = it->second;
+            return it->second;
+        }
+    }
+
+    // Get the index of the closest bucket size to add this image to. Will likely resize the image. 
+    int arrayIndex = getArrayIndex(image->getWidth());
 
     // Add the image to the closest array
     TextureArray* array = textureArrays.at(arrayIndex);
@@ -66,10 +102,186 @@ std::pair<unsigned int, unsigned int> TextureServer::add(Image* image) {
     // Update the pointer mapping
     std::pair<unsigned int, unsigned int> location(arrayIndex, imageIndex);
     imageMapping[image] = location;
+    if (image->getData()) {
+        contentMapping[hash] = location;
+    }
 
     return location;
 }
 
+/**
+ * @brief Hash of an image's dimensions and RGBA pixels, used to find layers that already hold the same pixels.
+ *        The pixels are not kept around to compare against, so a hash match is trusted.
+ * 
+ */
+uint64_t TextureServer::hashPixels(Image* image) {
+    if (!image->getData()) { return 0; }
+    size_t size = (size_t)image->getWidth() * image->getHeight() * 4;
+    return hashBytes(image->getData(), size, ((uint64_t)image->getWidth() << 32) ^ (uint64_t)image->getHeight());
+}
+
+/**
+ * @brief Forget an image, called when it is destroyed so its address can be reused safely. 
+ *        Its layer stays, other images with the same pixels may still map to it.
+ * 
+ * @param image The image to remove
+ */
+void TextureServer::remove(Image* image) {
+    imageMapping.erase(image);
+    if (!pendingImages.erase(image)) { return; }
+
+    // The loader job reads the image until it is ready
+    std::erase_if(pendingUploads, [image](const std::unique_ptr<PendingUpload>& upload) {
+        if (upload->image != image) { return false; }
+        upload->ready.wait(false, std::memory_order_acquire);
+        return true;
+    });
+}
+
+/**
+ * @brief Queue an async image to be resized for its array on the loader pool once it is decoded
+ * 
+ * @param image Pointer to the async image
+ */
+void TextureServer::addAsync(Image* image) {
+    if (!pendingImages.insert(image).second) { return; }
+
+    pendingUploads.push_back(std::make_unique<PendingUpload>());
+    PendingUpload* upload = pendingUploads.back().get();
+    upload->image = image;
+
+    // The decode job was submitted when the image was created, so it has already started by the time this job runs
+    ThreadPool::getLoader().submit([this, upload]() {
+        upload->image->wait();
+        upload->arrayIndex = upload->image->getData() ? getArrayIndex(upload->image->getWidth()) : -1;
+        upload->hash = hashPixels(upload->image);
+        if (upload->arrayIndex >= 0) {
+            TextureArray* array = textureArrays.at(upload->arrayIndex);
+            upload->pixels.resize(array->getLayerSize());
+            array->resize(upload->image, upload->pixels.data());
+        }
+        upload->ready.store(true, std::memory_order_release);
+        upload->ready.notify_all();
+    });
+}
+
+/**
+ * @brief Commit async images that finished resizing to their arrays and rebuild the mip chains of changed arrays. 
+ *        Call once per frame on the GL thread. Uploads go through the next buffer of the staging ring and stop once
+ *        the frame's byte budget is spent.
+ * 
+ * @return unsigned int Number of images that stopped pending, their mappings are now final
+ */
+unsigned int TextureServer::update() {
+    unsigned int committed = commitUploads();
+
+    // Once per frame however many layers changed
+    for (TextureArray* array : textureArrays) {
+        array->updateMipmaps();
+    }
+
+    return committed;
+}
+
+/**
+ * @brief Stage and upload the async images that finished resizing, within the frame's budget
+ * 
+ * @return unsigned int Number of images that stopped pending
+ */
+unsigned int TextureServer::commitUploads() {
+    if (pendingUploads.empty()) { return 0; }
+
+    // Take ready uploads in the order they were added until the budget is spent. 
+    // Images whose pixels are already on the GPU, or earlier in this batch, need no layer of their own.
+    std::vector<PendingUpload*> batch;
+    std::vector<PendingUpload*> uploads;
+    std::vector<std::pair<PendingUpload*, PendingUpload*>> twins; // (duplicate, upload it copies)
+    std::unordered_map<uint64_t, PendingUpload*> batchContents;
+    unsigned int bytes = 0;
+    for (std::unique_ptr<PendingUpload>& upload : pendingUploads) {
+        if (!upload->ready.load(std::memory_order_acquire)) { continue; }
+
+        if (upload->arrayIndex >= 0) {
+            auto existing = contentMapping.find(upload->hash);
+            auto twin = batchContents.find(upload->hash);
+            if (existing != contentMapping.end()) {
+                imageMapping[upload->image] = existing->second;
+            }
+            else if (twin != batchContents.end()) {
+                twins.push_back({ upload.get(), twin->second });
+            }
+            else {
+                unsigned int size = upload->pixels.size();
+                if (!uploads.empty() && bytes + size > uploadBudget) { break; }
+                uploads.push_back(upload.get());
+                batchContents[upload->hash] = upload.get();
+                bytes += size;
+            }
+        }
+        batch.push_back(upload.get());
+    }
+    if (batch.empty()) { return 0; }
+
+    if (!uploads.empty()) {
+        PBO* pbo = stagingRing[stagingIndex];
+        stagingIndex = (stagingIndex + 1) % TEXTURE_STAGING_RING_SIZE;
+
+        unsigned char* staging = (unsigned char*)pbo->map(bytes);
+        if (!staging) { return 0; }
+        unsigned int offset = 0;
+        for (PendingUpload* upload : uploads) {
+            std::memcpy(staging + offset, upload->pixels.data(), upload->pixels.size());
+            offset += upload->pixels.size();
+        }
+        pbo->unmap();
+
+        // Reserve layers while no unpack buffer is bound, growing an array re-specifies its storage from a null pointer
+        std::vector<unsigned int> positions(uploads.size());
+        for (unsigned int i = 0; i < uploads.size(); i++) {
+            positions[i] = textureArrays.at(uploads[i]->arrayIndex)->allocate(uploads[i]->image);
+        }
+
+        // With the buffer bound, the pixel pointers are byte offsets into it
+        pbo->bind();
+        offset = 0;
+        for (unsigned int i = 0; i < uploads.size(); i++) {
+            PendingUpload* upload = uploads[i];
+            std::pair<unsigned int, unsigned int> location((unsigned int)upload->arrayIndex, positions[i]);
+            textureArrays.at(upload->arrayIndex)->upload((const void*)(uintptr_t)offset, positions[i]);
+            imageMapping[upload->image] = location;
+            contentMapping[upload->hash] = location;
+            offset += upload->pixels.size();
+        }
+        pbo->unbind();
+    }
+
+    for (auto& [duplicate, upload] : twins) {
+        imageMapping[duplicate->image] = imageMapping.at(upload->image);
+    }
+
+    // Failed images stay on the default image
+    for (PendingUpload* upload : batch) {
+        pendingImages.erase(upload->image);
+    }
+    std::erase_if(pendingUploads, [this](const std::unique_ptr<PendingUpload>& upload) {
+        return upload->ready.load(std::memory_order_relaxed) && !pendingImages.count(upload->image);
+    });
+
+    return batch.size();
+}
+
+/**
+ * @brief Grow the array of a bucket up front so loading many images into it never regrows it
+ * 
+ * @param size Image width that selects the bucket, like in add()
+ * @param count Total number of images the array should hold
+ */
+void TextureServer::reserve(unsigned int size, unsigned int count) {
+    int arrayIndex = getArrayIndex(size);
+    if (arrayIndex < 0) { return; }
+    textureArrays.at(arrayIndex)->reserve(count);
+}
+
 /**
  * @brief Get the mapping of the image as a pair <index of the array, index in the array>
  * 
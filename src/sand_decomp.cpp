@@ -210,9 +210,11 @@ void drawConnectedComponents(bsk::Scene2D* scene, const MarchingGrid& grid, cons
     const int compCount = static_cast<int>(comps.size());
     for (int i = 0; i < compCount; ++i) {
         bsk::Material* mat = new bsk::Material(getCircularColor(i, compCount));
-        for (const auto& [x, y] : comps[i]) {
-            new bsk::Node2D(scene, nullptr, mat,
-                glm::vec2(static_cast<float>(x), static_cast<float>(y)) + offset);
+        for (const MarchRun& run : comps[i]) {
+            for (int x = run.x0; x <= run.x1; ++x) {
+                new bsk::Node2D(scene, nullptr, mat,
+                    glm::vec2(static_cast<float>(x), static_cast<float>(run.y)) + offset);
+            }
         }
     }
 }
@@ -245,7 +247,7 @@ int main() {
 
     bsk::Material* whiteMat = new bsk::Material(glm::vec3(1.0f, 1.0f, 1.0f));
 
-    std::vector<std::vector<int>> weights(SIDE_LENGTH, std::vector<int>(SIDE_LENGTH, -1));
+    MarchBitset weights(SIDE_LENGTH, SIDE_LENGTH);
     PerlinNoise noise;
     std::mt19937 rng(std::random_device{}());
     std::uniform_real_distribution<double> startDist(0.0, 10000.0);
@@ -256,21 +258,23 @@ int main() {
             const double sx = noiseStartX + (static_cast<double>(x) / SIDE_LENGTH) * static_cast<double>(OCTAVES);
             const double sy = noiseStartY + (static_cast<double>(y) / SIDE_LENGTH) * static_cast<double>(OCTAVES);
             const float n = static_cast<float>(noise.noise(sx, sy, 0.0));
-            weights[x][y] = (n > 0.0f) ? 1 : -1;
+            if (n > 0.0f) {
+                weights.set(x, y);
+            }
         }
     }
 
     const glm::vec2 perlinOffset(-DELTA, DELTA);
     for (int x = 0; x < SIDE_LENGTH; ++x) {
         for (int y = 0; y < SIDE_LENGTH; ++y) {
-            if (weights[x][y] > 0) {
+            if (weights.test(x, y)) {
                 new bsk::Node2D(scene, nullptr, whiteMat, glm::vec2(static_cast<float>(x), static_cast<float>(y)) + perlinOffset);
             }
         }
     }
 
     MarchingGrid grid(std::move(weights));
-    grid.bfs();
+    grid.labelComponents();
     std::vector<MarchComponentGeometry> marchGeom = grid.genMarch();
     drawMarchGeometry(scene, marchGeom);
 
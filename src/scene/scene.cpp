@@ -13,8 +13,10 @@ Scene::Scene(Engine* engine, bool addSkybox, bool addLight, bool addCube) : Virt
     internalCamera = camera;
     shader = new Shader(internalPath("shaders/instance.vert").c_str(), internalPath("shaders/instance.frag").c_str());
     engine->getResourceServer()->write(shader, "textureArrays", "materials");
+    renderQueue = new RenderQueue(shader);
+    cameraUBO = new UBO(nullptr, sizeof(CameraBlock), GL_DYNAMIC_DRAW);
     lightServer = new LightServer();
-    lightServer->setTiles(shader, camera, (unsigned int)engine->getWindow()->getWidth(), (unsigned int)engine->getWindow()->getHeight());
+    lightServer->setClusters(camera, (unsigned int)engine->getWindow()->getWidth(), (unsigned int)engine->getWindow()->getHeight());
     addDefaults(addSkybox, addLight, addCube);
 }
 
@@ -23,8 +25,10 @@ Scene::Scene(Engine* engine, Shader* shader, bool addSkybox, bool addLight, bool
     internalCamera = camera;
     this->shader = shader;
     engine->getResourceServer()->write(shader, "textureArrays", "materials");
+    renderQueue = new RenderQueue(shader);
+    cameraUBO = new UBO(nullptr, sizeof(CameraBlock), GL_DYNAMIC_DRAW);
     lightServer = new LightServer();
-    lightServer->setTiles(shader, camera, (unsigned int)engine->getWindow()->getWidth(), (unsigned int)engine->getWindow()->getHeight());
+    lightServer->setClusters(camera, (unsigned int)engine->getWindow()->getWidth(), (unsigned int)engine->getWindow()->getHeight());
     addDefaults(addSkybox, addLight, addCube);
 }
 
@@ -62,8 +66,10 @@ void Scene::addDefaults(bool addSkybox, bool addLight, bool addCube) {
  */
 Scene::~Scene() {
     delete internalCamera; internalCamera = nullptr;
+    delete renderQueue;
     delete shader;
     delete lightServer;
+    delete cameraUBO;
 }
 
 /**
@@ -71,9 +77,18 @@ Scene::~Scene() {
  * 
  */
 void Scene::update() {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
     camera->update();
-    camera->use(shader);
-    lightServer->update(shader, camera);
+
+    // Shaders with a uCamera block read the camera from one buffer written once per frame
+    if (shader->hasUniformBlock("uCamera")) {
+        CameraBlock block = camera->getCameraBlock();
+        cameraUBO->write(&block, sizeof(CameraBlock));
+    }
+    else {
+        camera->use(shader);
+    }
+    lightServer->update(camera);
 }
 
 /**
@@ -81,15 +96,29 @@ void Scene::update() {
  * 
  */
 void Scene::render() {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
     if (skybox) {
         skybox->render(camera);
     }
 
     shader->use();
-    for (auto it = ++root->begin(); it != root->end(); ++it) {
-        Node* node = *it;
-        node->render();
+    shader->bind("uCamera", cameraUBO, CAMERA_BLOCK_BINDING);
+    lightServer->bind(shader);
+
+    // Only nodes whose bounds touch the view frustum are drawn
+    updateBounds();
+    Frustum frustum(camera->getProjection() * camera->getView());
+    auto visible = [&](const glm::vec3& min, const glm::vec3& max) { return frustum.intersects(min, max); };
+
+    // Custom shaders without instance attributes fall back to one draw per node
+    if (!shader->isInstanced()) {
+        boundsTree.query(visible, [](Node* node) { node->render(); });
+        return;
     }
+
+    renderQueue->clear(camera->getView());
+    boundsTree.query(visible, [&](Node* node) { node->enqueue(renderQueue); });
+    renderQueue->render();
 }
 
 /**
@@ -97,6 +126,7 @@ void Scene::render() {
  * 
  */
 void Scene::add(Light* light) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
     if (auto* directional = dynamic_cast<DirectionalLight*>(light)) {
         lightServer->add(directional);
     } else if (auto* point = dynamic_cast<PointLight*>(light)) {
@@ -107,6 +137,7 @@ void Scene::add(Light* light) {
 }
 
 void Scene::add(std::shared_ptr<Light> light) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
     if (!light) {
         return;
     }
@@ -120,10 +151,12 @@ void Scene::add(std::shared_ptr<Light> light) {
 }
 
 void Scene::add(Node* node) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
     root->add(node);
 }
 
 void Scene::add(std::shared_ptr<Node> node) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
     childrenPythonMap.emplace(node.get(), node);
     // Only add to root if the node doesn't already have a parent
     // (nodes created with a parent are already in the tree)
@@ -133,6 +166,7 @@ void Scene::add(std::shared_ptr<Node> node) {
 }
 
 void Scene::remove(Node* node) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
     if (node == nullptr) return;
     Node* parent = node->getParent();
     if (parent != nullptr) {
@@ -143,27 +177,62 @@ void Scene::remove(Node* node) {
 }
 
 void Scene::remove(std::shared_ptr<Node> node) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
     childrenPythonMap.erase(node.get());
     remove(node.get());
 }
 
 // raycasting - origin and direction in world space
 RayCastResult Scene::raycast(glm::vec3 origin, glm::vec3 direction) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
+    updateBounds();
+    return raycastTree(origin, direction);
+}
+
+/**
+ * @brief Cast many rays against the scene. Bounds are refreshed once for the whole batch.
+ *
+ * @param origins World space ray origins
+ * @param directions World space ray directions, one per origin
+ * @return std::vector<RayCastResult> Nearest hit of each ray
+ */
+std::vector<RayCastResult> Scene::raycast(const std::vector<glm::vec3>& origins, const std::vector<glm::vec3>& directions) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
+    updateBounds();
+
+    size_t count = std::min(origins.size(), directions.size());
+    std::vector<RayCastResult> results(count);
+    for (size_t i = 0; i < count; i++) {
+        results[i] = raycastTree(origins[i], directions[i]);
+    }
+    return results;
+}
+
+/**
+ * @brief Nearest hit of a ray against the bounds tree. Only nodes whose bounds the ray enters are tested.
+ *
+ */
+RayCastResult Scene::raycastTree(glm::vec3 origin, glm::vec3 direction) {
     RayCastResult result;
+    if (glm::length(direction) == 0.0f) { return result; }
+    glm::vec3 unitDirection = glm::normalize(direction);
 
-    for (auto it = ++root->begin(); it != root->end(); ++it) {
-        Node* node = *it;
-        RayCastResult hit = node->raycast(origin, direction);
+    boundsTree.rayCast(origin, unitDirection, result.distance, [&](Node* node, float tEnter) {
+        // bounds entered beyond the current best cannot hold a nearer hit
+        if (tEnter >= result.distance) { return result.distance; }
 
+        RayCastResult hit = node->raycast(origin, unitDirection);
         if (hit.node && hit.distance < result.distance && hit.distance > 0.0f) {
             result = hit;
         }
-    }
+        return result.distance;
+    });
 
     return result;
 }
 
 RayCastResult Scene::pick(glm::vec2 mousePosition) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
     // Convert mouse position (screen pixels) to normalized direction vector in world space
     int width = static_cast<int>(engine->getWindow()->getWidth() * engine->getWindow()->getWindowScaleX());
     int height = static_cast<int>(engine->getWindow()->getHeight() * engine->getWindow()->getWindowScaleY());
@@ -1,5 +1,6 @@
 #include <basilisk/scene/sceneRoute.h>
 #include <basilisk/util/resolvePath.h>
+#include <basilisk/physics/tables/bodyTable.h>
 
 namespace bsk::internal {
 
@@ -14,6 +15,8 @@ Scene2D::Scene2D(Engine* engine, int cellWidth, int cellHeight, float cellScale)
     shader = new Shader(internalPath("shaders/instance2D.vert").c_str(), internalPath("shaders/instance2D.frag").c_str());
     solver = new Solver(cellWidth, cellHeight, cellScale);
     engine->getResourceServer()->write(shader, "textureArrays", "materials");
+    renderQueue = new RenderQueue(shader);
+    cameraUBO = new UBO(nullptr, sizeof(CameraBlock), GL_DYNAMIC_DRAW);
     customShader = false;
 }
 
@@ -23,6 +26,8 @@ Scene2D::Scene2D(Engine* engine, Shader* shader, int cellWidth, int cellHeight,
     this->shader = shader;
     solver = new Solver(cellWidth, cellHeight, cellScale);
     engine->getResourceServer()->write(shader, "textureArrays", "materials");
+    renderQueue = new RenderQueue(shader);
+    cameraUBO = new UBO(nullptr, sizeof(CameraBlock), GL_DYNAMIC_DRAW);
     customShader = true;
 }
 
@@ -31,9 +36,12 @@ Scene2D::Scene2D(Engine* engine, Shader* shader, int cellWidth, int cellHeight,
  * 
  */
 Scene2D::~Scene2D() {
+    sync(); // nodes about to be deleted own rigids the step may still be using
     VirtualScene::clear();
 
     delete internalCamera; internalCamera = nullptr;
+    delete renderQueue; renderQueue = nullptr;
+    delete cameraUBO; cameraUBO = nullptr;
     if (!customShader) {
         delete shader; shader = nullptr;
     }
@@ -41,16 +49,113 @@ Scene2D::~Scene2D() {
 }
 
 /**
- * @brief Update the scene (camera updates)
+ * @brief Update the scene (camera updates). When pipelined, this publishes the step started last frame to the
+ *        nodes and starts the next one in the background, so the solver runs while this frame renders.
+ *        With a physics rate set, the frame time is banked and spent in whole fixed steps, and nodes are drawn
+ *        between the last two physics states by the fraction of a step left in the bank.
  * 
  */
 void Scene2D::update() {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
     // physics
-    solver->step(engine->getDeltaTime());
+    float dt = engine->getDeltaTime();
+    int substeps = 1;
+    if (physicsRate > 0.0f) {
+        const float fixedDt = 1.0f / physicsRate;
+        accumulator += dt;
+        substeps = (int)(accumulator / fixedDt);
+        accumulator -= substeps * fixedDt;
+        // Steps past the budget are dropped, a slow frame then slows the simulation instead of snowballing
+        substeps = std::min(substeps, maxSubsteps);
+        dt = fixedDt;
+    }
+
+    if (pipelined) {
+        if (solver->collectStep() || physicsRate > 0.0f) {
+            publishPoses();
+        }
+        if (substeps > 0) {
+            solver->beginStep(dt, substeps);
+        }
+    } else {
+        for (int i = 0; i < substeps; i++) {
+            solver->step(dt);
+        }
+        if (physicsRate > 0.0f) {
+            publishPoses();
+        }
+    }
 
     // camera
     camera->update();
-    camera->use(shader);
+    if (shader->hasUniformBlock("uCamera")) {
+        CameraBlock block = camera->getCameraBlock();
+        cameraUBO->write(&block, sizeof(CameraBlock));
+    }
+    else {
+        camera->use(shader);
+    }
+}
+
+/**
+ * @brief Wait for a background step to finish and push its poses to the nodes. Does nothing when no step is in
+ *        flight. Bodies, forces and solver queries wait for the step on their own, syncing also publishes the
+ *        solved poses right away instead of on the next update.
+ *
+ */
+void Scene2D::sync() {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
+    if (solver->collectStep()) {
+        publishPoses();
+    }
+}
+
+/**
+ * @brief Write body poses to their nodes, interpolated when running at a fixed physics rate
+ *
+ */
+void Scene2D::publishPoses() {
+    if (physicsRate > 0.0f) {
+        solver->getBodyTable()->writeToNodes(accumulator * physicsRate);
+    } else {
+        solver->getBodyTable()->writeToNodes();
+    }
+}
+
+/**
+ * @brief The step writes nodes itself only when it runs inline once per frame, otherwise the scene publishes
+ *
+ */
+void Scene2D::updateNodeSync() {
+    solver->getBodyTable()->setSyncNodes(!pipelined && physicsRate <= 0.0f);
+}
+
+/**
+ * @brief Step physics at a fixed rate, independent of the frame rate. Each update runs as many steps as the
+ *        elapsed time allows, up to the max substeps, and nodes are interpolated between the last two states.
+ *        The solver clamps steps to 1/20 s, so rates below 20 Hz run slower than real time.
+ *
+ * @param physicsRate Steps per second, 0 to step once per frame with the frame time
+ */
+void Scene2D::setPhysicsRate(float physicsRate) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
+    sync();
+    this->physicsRate = std::max(physicsRate, 0.0f);
+    accumulator = 0.0f;
+    updateNodeSync();
+}
+
+/**
+ * @brief Run the solver on its own thread, one frame behind the render. Physics of frame N+1 then overlaps the
+ *        render of frame N at the cost of one frame of latency between a step and its poses appearing on nodes.
+ *
+ * @param pipelined
+ */
+void Scene2D::setPipelined(bool pipelined) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
+    if (!pipelined) sync();
+    this->pipelined = pipelined;
+    updateNodeSync();
 }
 
 /**
@@ -58,21 +163,51 @@ void Scene2D::update() {
  * 
  */
 void Scene2D::render() {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
     engine->disableCullFace();
     shader->use();
-    for (auto it = ++root->begin(); it != root->end(); ++it) {
-        
-        Node2D* node = *it;
-        node->render();
+    shader->bind("uCamera", cameraUBO, CAMERA_BLOCK_BINDING);
+
+    // Only nodes whose bounds touch the camera view rectangle are drawn
+    updateBounds();
+    glm::vec2 viewMin, viewMax;
+    getViewBounds(viewMin, viewMax);
+
+    // Custom shaders without instance attributes fall back to one draw per node
+    if (shader->isInstanced()) {
+        renderQueue->clear(camera->getView());
+        boundsTree.query(viewMin, viewMax, [&](Node2D* node) { node->enqueue(renderQueue); });
+        renderQueue->render();
+    }
+    else {
+        boundsTree.query(viewMin, viewMax, [](Node2D* node) { node->render(); });
     }
     engine->enableCullFace();
 }
 
+/**
+ * @brief Get the area seen by the camera in render space (the space of the node model matrices)
+ * 
+ * @param min Bottom left corner
+ * @param max Top right corner
+ */
+void Scene2D::getViewBounds(glm::vec2& min, glm::vec2& max) {
+    glm::mat4 inverseViewProjection = glm::inverse(camera->getProjection() * camera->getView());
+    glm::vec2 a = glm::vec2(inverseViewProjection * glm::vec4(-1.0f, -1.0f, 0.0f, 1.0f));
+    glm::vec2 b = glm::vec2(inverseViewProjection * glm::vec4( 1.0f,  1.0f, 0.0f, 1.0f));
+    min = glm::min(a, b);
+    max = glm::max(a, b);
+}
+
 void Scene2D::add(Node2D* node) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
+    sync();
     root->add(node);
 }
 
 void Scene2D::add(std::shared_ptr<Node2D> node) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
+    sync();
     childrenPythonMap.emplace(node.get(), node);
     if (node->getParent() == nullptr) {
         root->add(node.get());
@@ -80,6 +215,8 @@ void Scene2D::add(std::shared_ptr<Node2D> node) {
 }
 
 void Scene2D::remove(Node2D* node) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
+    sync();
     if (node == nullptr) return;
     Node2D* parent = node->getParent();
     if (parent != nullptr) {
@@ -90,38 +227,135 @@ void Scene2D::remove(Node2D* node) {
 }
 
 void Scene2D::remove(std::shared_ptr<Node2D> node) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
     childrenPythonMap.erase(node.get());
     remove(node.get());
 }
-    
+
+/**
+ * @brief Spawn many nodes with the same mesh, material and collider at once. Body table and GPU capacity are
+ *        reserved up front and the new bodies join the collision BVH in one bulk build, instead of the table
+ *        doubling and the tree being walked once per node. The nodes are owned by the scene like nodes added
+ *        through add(std::shared_ptr<Node2D>), and can be removed the same way.
+ *
+ * @param count Number of nodes
+ * @param positions count positions
+ * @param rotations count rotations, or nullptr for 0
+ * @param scales count scales, or nullptr for 1
+ * @param velocities count velocities, or nullptr to spawn at rest
+ * @param collider Shared collider, or nullptr for nodes without a rigid body
+ * @param density Density of every body
+ * @param friction Friction of every body
+ * @param mesh Shared mesh, or nullptr for the default quad
+ * @param material Shared material, or nullptr for the default material
+ * @return std::vector<Node2D*> The new nodes in input order
+ */
+std::vector<Node2D*> Scene2D::spawnBatch(uint32_t count, const glm::vec2* positions, const float* rotations, const glm::vec2* scales, const glm::vec3* velocities,
+                                         Collider* collider, float density, float friction, std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
+    sync();
+    BodyTable* bodyTable = solver->getBodyTable();
+    if (collider != nullptr) {
+        bodyTable->reserve(count);
+    }
+    childrenPythonMap.reserve(childrenPythonMap.size() + count);
+
+    std::vector<Node2D*> nodes;
+    nodes.reserve(count);
+    try {
+        // Scoped inside the try so an exception closes the batch before the handler deletes any body
+        BodyTable::BatchGuard batch(bodyTable);
+        for (uint32_t i = 0; i < count; i++) {
+            float rotation = rotations ? rotations[i] : 0.0f;
+            glm::vec2 scale = scales ? scales[i] : glm::vec2(1.0f, 1.0f);
+            glm::vec3 velocity = velocities ? velocities[i] : glm::vec3(0.0f);
+            auto node = std::make_shared<Node2D>(this, mesh, material, positions[i], rotation, scale, velocity, collider, density, friction);
+            childrenPythonMap.emplace(node.get(), node);
+            nodes.push_back(node.get());
+        }
+    }
+    catch (...) {
+        // Nobody holds the nodes spawned so far, drop them so the batch leaves the scene as it was
+        for (Node2D* node : nodes) {
+            root->remove(node);
+            childrenPythonMap.erase(node);
+        }
+        throw;
+    }
+    return nodes;
+}
+
 // raycasting
 RayCastResult2D Scene2D::raycast(glm::vec2 origin, glm::vec2 direction) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
+    sync();
+    updateBounds();
+    return raycastTree(origin, direction);
+}
+
+/**
+ * @brief Cast many rays against the scene. Bounds are refreshed once for the whole batch.
+ *
+ * @param origins World space ray origins
+ * @param directions World space ray directions, one per origin
+ * @return std::vector<RayCastResult2D> Nearest hit of each ray
+ */
+std::vector<RayCastResult2D> Scene2D::raycast(const std::vector<glm::vec2>& origins, const std::vector<glm::vec2>& directions) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
+    sync();
+    updateBounds();
+
+    size_t count = std::min(origins.size(), directions.size());
+    std::vector<RayCastResult2D> results(count);
+    for (size_t i = 0; i < count; i++) {
+        results[i] = raycastTree(origins[i], directions[i]);
+    }
+    return results;
+}
+
+/**
+ * @brief Nearest hit of a ray against the bounds tree. The tree lives in render space, where y is flipped.
+ *
+ */
+RayCastResult2D Scene2D::raycastTree(glm::vec2 origin, glm::vec2 direction) {
     RayCastResult2D best;
+    if (glm::length(direction) == 0.0f) { return best; }
+
+    // Flipping y preserves lengths, so distances along the render space ray match world space
+    glm::vec2 renderOrigin(origin.x, -origin.y);
+    glm::vec2 renderDirection = glm::normalize(glm::vec2(direction.x, -direction.y));
+
+    boundsTree.rayCast(renderOrigin, renderDirection, best.distance, [&](Node2D* node, float tEnter) {
+        if (tEnter >= best.distance) { return best.distance; }
 
-    for (auto it = ++root->begin(); it != root->end(); ++it) {
-        Node2D* node = *it;
         RayCastResult2D hit = node->raycast(origin, direction);
 
         // Match 3D behavior: choose nearest positive-distance hit in world space.
         if (hit.node && hit.distance < best.distance && hit.distance > 0.0f) {
             best = hit;
         }
-    }
+        return best.distance;
+    });
     return best;
 }
 
 // return the node at the position
 Node2D* Scene2D::pick(glm::vec2 position) {
+    std::lock_guard<std::recursive_mutex> lock(graphMutex);
+    sync();
+    updateBounds();
+
     float bestLayer = -FLT_MAX;
     Node2D* bestNode = nullptr;
 
-    for (auto it = ++root->begin(); it != root->end(); ++it) {
-        Node2D* node = *it;
-        if (node->pointIsInside(position) && node->getLayer() > bestLayer) {
+    // Only nodes whose bounds contain the point can contain it
+    glm::vec2 renderPosition(position.x, -position.y);
+    boundsTree.query(renderPosition, renderPosition, [&](Node2D* node) {
+        if (node->getLayer() > bestLayer && node->pointIsInside(position)) {
             bestLayer = node->getLayer();
             bestNode = node;
         }
-    }
+    });
     return bestNode;
 }
 
@@ -0,0 +1,49 @@
+#include <basilisk/util/arena.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief Construct a new Frame Arena
+ *
+ * @param capacity Starting block size in bytes
+ */
+FrameArena::FrameArena(size_t capacity): block(new std::byte[capacity]), capacity(capacity) {}
+
+FrameArena::~FrameArena() {
+    reset();
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    void* pointer = block.get() + offset;
+    size_t space = capacity - offset;
+    if (std::align(alignment, bytes, pointer, space)) {
+        offset = capacity - space + bytes;
+        return pointer;
+    }
+
+    pointer = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    spills.push_back({ pointer, bytes, alignment });
+    spilledBytes += bytes;
+    return pointer;
+}
+
+/**
+ * @brief Free everything allocated since the last reset. Containers using the arena must be gone by now.
+ *
+ */
+void FrameArena::reset() {
+    for (const Spill& spill : spills) {
+        std::pmr::new_delete_resource()->deallocate(spill.pointer, spill.bytes, spill.alignment);
+    }
+    spills.clear();
+
+    // grow once to what the last frame needed instead of spilling again every frame
+    if (spilledBytes > 0) {
+        capacity = std::max(capacity * 2, capacity + spilledBytes);
+        block.reset(new std::byte[capacity]);
+        spilledBytes = 0;
+    }
+    offset = 0;
+}
+
+}
@@ -0,0 +1,169 @@
+#include <basilisk/util/cacheFile.h>
+#include <cerrno>
+#include <cstdlib>
+#include <random>
+#ifdef _WIN32
+    #include <windows.h>
+    #include <fcntl.h>
+    #include <io.h>
+    #include <process.h>
+    #include <sys/stat.h>
+#else
+    #include <fcntl.h>
+    #include <pwd.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace bsk::internal {
+
+/**
+ * @brief Get the platform's per user cache root, which is expected to exist or be creatable by the user
+ *
+ */
+static std::filesystem::path getUserCacheRoot() {
+#ifdef _WIN32
+    const char* localAppData = std::getenv("LOCALAPPDATA");
+    if (localAppData && *localAppData) { return localAppData; }
+    return {};
+#else
+    #ifndef __APPLE__
+    const char* xdg = std::getenv("XDG_CACHE_HOME");
+    if (xdg && xdg[0] == '/') { return xdg; } // the spec says relative values are ignored
+    #endif
+
+    std::filesystem::path home;
+    const char* homeEnv = std::getenv("HOME");
+    if (homeEnv && homeEnv[0] == '/') {
+        home = homeEnv;
+    } else if (const passwd* entry = getpwuid(getuid())) {
+        if (entry->pw_dir) { home = entry->pw_dir; }
+    }
+    if (home.empty()) { return {}; }
+
+    #ifdef __APPLE__
+    return home / "Library" / "Caches";
+    #else
+    return home / ".cache";
+    #endif
+#endif
+}
+
+/**
+ * @brief Create a directory only the current user can use, or check an existing one is
+ *
+ * @return true if the directory exists, is a real directory and belongs to the current user
+ */
+static bool makePrivateDirectory(const std::filesystem::path& path) {
+#ifdef _WIN32
+    // LOCALAPPDATA already sits in the user's profile, whose ACL keeps other users out
+    std::error_code error;
+    std::filesystem::create_directory(path, error);
+    return std::filesystem::is_directory(path, error);
+#else
+    if (mkdir(path.c_str(), 0700) != 0 && errno != EEXIST) { return false; }
+
+    struct stat info;
+    if (lstat(path.c_str(), &info) != 0) { return false; }
+    if (!S_ISDIR(info.st_mode) || info.st_uid != geteuid()) { return false; }
+    if ((info.st_mode & 0077) != 0 && chmod(path.c_str(), 0700) != 0) { return false; }
+    return true;
+#endif
+}
+
+std::filesystem::path getCacheDirectory(const std::string& name) {
+    std::filesystem::path root = getUserCacheRoot();
+    if (root.empty()) { return {}; }
+
+    std::error_code error;
+    std::filesystem::create_directories(root, error);
+    if (error) { return {}; }
+
+    std::filesystem::path basilisk = root / "basilisk";
+    std::filesystem::path directory = basilisk / name;
+    if (!makePrivateDirectory(basilisk) || !makePrivateDirectory(directory)) {
+        std::cerr << "Cache directory unavailable, caching disabled: " << directory.string() << std::endl;
+        return {};
+    }
+    return directory;
+}
+
+/**
+ * @brief Create a new temporary sibling of path that no other writer can be using, only the owner may read it
+ *
+ * @param path File the temporary will be renamed to
+ * @param tempPath Receives the name that was created
+ * @return int File descriptor open for writing, -1 on failure
+ */
+static int createTempFile(const std::filesystem::path& path, std::filesystem::path& tempPath) {
+#ifdef _WIN32
+    std::random_device random;
+    for (int attempt = 0; attempt < 16; attempt++) {
+        tempPath = path;
+        tempPath += "." + std::to_string(_getpid()) + "." + std::to_string(random()) + ".partial";
+        int fd = _wopen(tempPath.c_str(), _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY, _S_IREAD | _S_IWRITE);
+        if (fd >= 0 || errno != EEXIST) { return fd; }
+    }
+    return -1;
+#else
+    std::string name = path.string() + ".XXXXXX";
+    int fd = mkstemp(name.data()); // creates the file 0600 with O_EXCL
+    tempPath = name;
+    return fd;
+#endif
+}
+
+/**
+ * @brief Write all of a buffer to a file descriptor, retrying short writes
+ *
+ */
+static bool writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = (const char*)data;
+    while (size > 0) {
+#ifdef _WIN32
+        int written = _write(fd, bytes, (unsigned int)std::min<size_t>(size, 1u << 30));
+#else
+        ssize_t written = write(fd, bytes, size);
+        if (written < 0 && errno == EINTR) { continue; }
+#endif
+        if (written <= 0) { return false; }
+        bytes += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+bool writeCacheFile(const std::filesystem::path& path, std::initializer_list<CacheFilePart> parts) {
+    if (path.empty()) { return false; }
+
+    // Every writer gets its own temporary, so concurrent writers of the same entry never interleave
+    std::filesystem::path tempPath;
+    int fd = createTempFile(path, tempPath);
+    if (fd < 0) { return false; }
+
+    bool written = true;
+    for (const CacheFilePart& part : parts) {
+        written = written && writeAll(fd, part.data, part.size);
+    }
+#ifdef _WIN32
+    written = (_close(fd) == 0) && written;
+#else
+    written = (close(fd) == 0) && written;
+#endif
+
+    std::error_code error;
+    if (!written) {
+        std::cerr << "Failed to write cache file: " << tempPath.string() << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,51 @@
+#include <basilisk/util/mappedFile.h>
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace bsk::internal {
+
+/**
+ * @brief Map a file. A missing, empty or unmappable file leaves the mapping empty, getData returns nullptr.
+ *
+ * @param path File to map
+ */
+MappedFile::MappedFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+    file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) { return; }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) { return; }
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) { return; }
+    data = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data) { size = (size_t)fileSize.QuadPart; }
+#else
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) { return; }
+    struct stat info;
+    if (fstat(descriptor, &info) == 0 && info.st_size > 0) {
+        void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapped != MAP_FAILED) {
+            data = (const unsigned char*)mapped;
+            size = info.st_size;
+        }
+    }
+    close(descriptor); // the mapping outlives the descriptor
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+    if (data) { UnmapViewOfFile(data); }
+    if (mapping) { CloseHandle(mapping); }
+    if (file != INVALID_HANDLE_VALUE) { CloseHandle(file); }
+#else
+    if (data) { munmap((void*)data, size); }
+#endif
+}
+
+}
@@ -0,0 +1,67 @@
+#include <basilisk/util/pool.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief Construct a new Slab Pool. No memory is taken until the first allocation.
+ *
+ * @param slotSize Bytes per object, rounded up so every slot stays aligned for any type
+ * @param slotsPerSlab Objects per slab
+ */
+SlabPool::SlabPool(size_t slotSize, size_t slotsPerSlab): slotsPerSlab(std::max<size_t>(slotsPerSlab, 1)) {
+    const size_t alignment = alignof(std::max_align_t);
+    slotSize = std::max(slotSize, sizeof(void*));
+    this->slotSize = (slotSize + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Add a slab and thread all of its slots onto the free list. Called with the mutex held.
+ *
+ */
+void SlabPool::grow() {
+    std::byte* slab = new std::byte[slotSize * slotsPerSlab];
+    slabs.emplace_back(slab);
+
+    // link back to front so slots are handed out in address order
+    for (size_t i = slotsPerSlab; i-- > 0;) {
+        void* slot = slab + i * slotSize;
+        *static_cast<void**>(slot) = freeList;
+        freeList = slot;
+    }
+}
+
+/**
+ * @brief Take a slot. Sizes larger than the slot, from types deriving from the pooled one, go to the global heap.
+ *
+ * @param size Bytes requested by operator new
+ * @return void* Uninitialized storage
+ */
+void* SlabPool::allocate(size_t size) {
+    if (size > slotSize) return ::operator new(size);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (freeList == nullptr) grow();
+    void* slot = freeList;
+    freeList = *static_cast<void**>(slot);
+    return slot;
+}
+
+/**
+ * @brief Return a slot taken with allocate
+ *
+ * @param pointer Storage from allocate
+ * @param size The same size that was allocated
+ */
+void SlabPool::deallocate(void* pointer, size_t size) {
+    if (pointer == nullptr) return;
+    if (size > slotSize) {
+        ::operator delete(pointer);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    *static_cast<void**>(pointer) = freeList;
+    freeList = pointer;
+}
+
+}
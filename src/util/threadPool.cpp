@@ -0,0 +1,84 @@
+#include <basilisk/util/threadPool.h>
+
+namespace bsk::internal {
+
+/**
+ * @brief Construct a new Thread Pool and start its workers
+ *
+ * @param threadCount Number of worker threads, at least one
+ */
+ThreadPool::ThreadPool(unsigned int threadCount): stopping(false) {
+    threadCount = std::max(1u, threadCount);
+    workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers.emplace_back([this]() { work(); });
+    }
+}
+
+/**
+ * @brief Destroy the Thread Pool. Jobs already queued are finished before the workers are joined.
+ *
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Queue a job to run on the next free worker
+ *
+ */
+void ThreadPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push(std::move(job));
+    }
+    available.notify_one();
+}
+
+/**
+ * @brief Worker loop, runs jobs until the pool is stopping and the queue is drained
+ *
+ */
+void ThreadPool::work() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (jobs.empty()) { return; }
+            job = std::move(jobs.front());
+            jobs.pop();
+        }
+        job();
+    }
+}
+
+/**
+ * @brief Get the pool shared by asset loading (image decoding, texture resizing). Leaves one core for the main thread.
+ *
+ * @return ThreadPool&
+ */
+ThreadPool& ThreadPool::getLoader() {
+    static ThreadPool loader(NUM_THREADS > 1 ? NUM_THREADS - 1 : 1);
+    return loader;
+}
+
+/**
+ * @brief Get the pool for short jobs split across cores every frame (light binning). Kept apart from the loader
+ *        so a frame never waits behind a texture decode. The calling thread is expected to take a share of the work.
+ *
+ * @return ThreadPool&
+ */
+ThreadPool& ThreadPool::getFrameWorkers() {
+    static ThreadPool workers(NUM_THREADS > 1 ? NUM_THREADS - 1 : 1);
+    return workers;
+}
+
+}